@@ -0,0 +1,148 @@
+#include <cpptrace/cpptrace.hpp>
+#include <cpptrace/from_current.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <stdexcept>
+
+// Every benchmark calls down `depth` frames and, once every `throw_every` iterations, throws from the bottom to a
+// handler at the top. The other iterations return normally, and a `throw_every` of 0 never throws, which shows the
+// cost of the happy path.
+
+template<typename F>
+CPPTRACE_FORCE_NO_INLINE
+int descend(std::int64_t depth, bool do_throw, const F& thrower) {
+    if(depth <= 1) {
+        if(do_throw) {
+            thrower();
+        }
+        return 1;
+    }
+    int result = descend(depth - 1, do_throw, thrower);
+    benchmark::DoNotOptimize(result);
+    return result + 1;
+}
+
+class throw_schedule {
+    std::int64_t every;
+    std::int64_t i = 0;
+
+public:
+    explicit throw_schedule(const benchmark::State& state) : every(state.range(1)) {}
+
+    bool next() {
+        return every != 0 && ++i % every == 0;
+    }
+};
+
+void throw_runtime_error() {
+    throw std::runtime_error("error");
+}
+
+void throw_traced_runtime_error() {
+    throw cpptrace::runtime_error("error");
+}
+
+static void plain_throw(benchmark::State& state) {
+    throw_schedule schedule(state);
+    for(auto _ : state) {
+        try {
+            descend(state.range(0), schedule.next(), throw_runtime_error);
+        } catch(const std::runtime_error& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+
+// cpptrace::runtime_error is a lazy_exception, it collects a raw trace when constructed
+static void traced_exception(benchmark::State& state) {
+    throw_schedule schedule(state);
+    for(auto _ : state) {
+        try {
+            descend(state.range(0), schedule.next(), throw_traced_runtime_error);
+        } catch(const cpptrace::runtime_error& e) {
+            benchmark::DoNotOptimize(&e);
+        }
+    }
+}
+
+// The catch interceptor collects a raw trace during the search phase
+static void cpptrace_try(benchmark::State& state) {
+    throw_schedule schedule(state);
+    for(auto _ : state) {
+        CPPTRACE_TRY {
+            descend(state.range(0), schedule.next(), throw_runtime_error);
+        } CPPTRACE_CATCH(const std::runtime_error& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+
+// The handler that matches is the third of four
+static void try_catch(benchmark::State& state) {
+    throw_schedule schedule(state);
+    for(auto _ : state) {
+        cpptrace::try_catch(
+            [&] {
+                descend(state.range(0), schedule.next(), throw_runtime_error);
+            },
+            [&] (const std::logic_error& e) {
+                benchmark::DoNotOptimize(e.what());
+            },
+            [&] (const std::range_error& e) {
+                benchmark::DoNotOptimize(e.what());
+            },
+            [&] (const std::runtime_error& e) {
+                benchmark::DoNotOptimize(e.what());
+            },
+            [&] () {
+                benchmark::ClobberMemory();
+            }
+        );
+    }
+}
+
+static void plain_rethrow(benchmark::State& state) {
+    throw_schedule schedule(state);
+    for(auto _ : state) {
+        try {
+            try {
+                descend(state.range(0), schedule.next(), throw_runtime_error);
+            } catch(const std::runtime_error&) {
+                throw;
+            }
+        } catch(const std::runtime_error& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+
+// cpptrace::rethrow collects a trace for the rethrow in addition to the original one
+static void cpptrace_rethrow(benchmark::State& state) {
+    throw_schedule schedule(state);
+    for(auto _ : state) {
+        CPPTRACE_TRY {
+            CPPTRACE_TRY {
+                descend(state.range(0), schedule.next(), throw_runtime_error);
+            } CPPTRACE_CATCH(const std::runtime_error&) {
+                cpptrace::rethrow();
+            }
+        } CPPTRACE_CATCH(const std::runtime_error& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+
+static void exception_args(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgsProduct({{1, 16, 64}, {1, 100, 0}})->ArgNames({"depth", "throw_every"});
+}
+
+BENCHMARK(plain_throw)->Apply(exception_args);
+BENCHMARK(traced_exception)->Apply(exception_args);
+BENCHMARK(cpptrace_try)->Apply(exception_args);
+BENCHMARK(try_catch)->Apply(exception_args);
+BENCHMARK(plain_rethrow)->Apply(exception_args);
+BENCHMARK(cpptrace_rethrow)->Apply(exception_args);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,162 @@
+#include <cpptrace/cpptrace.hpp>
+#include <cpptrace/formatting.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Symbols typical of heavily templated code, as they come out of the demangler
+const std::vector<std::string> symbols = {
+    "main",
+    "foo(std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> > const&, int)",
+    "std::vector<std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> >, "
+        "std::allocator<std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> > > >"
+        "::_M_realloc_insert<std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> > const&>"
+        "(__gnu_cxx::__normal_iterator<std::__cxx11::basic_string<char, std::char_traits<char>, "
+        "std::allocator<char> >*, std::vector<std::__cxx11::basic_string<char, std::char_traits<char>, "
+        "std::allocator<char> >, std::allocator<std::__cxx11::basic_string<char, std::char_traits<char>, "
+        "std::allocator<char> > > > >, std::__cxx11::basic_string<char, std::char_traits<char>, "
+        "std::allocator<char> > const&)",
+    "std::_Function_handler<void (int), (anonymous namespace)::handler>::_M_invoke(std::_Any_data const&, int&&)",
+    "std::unique_ptr<ns::widget, std::default_delete<ns::widget> >::~unique_ptr()",
+    "std::map<int, std::vector<int, std::allocator<int> >, std::less<int>, std::allocator<std::pair<int const, "
+        "std::vector<int, std::allocator<int> > > > >::operator[](int const&)",
+    "ns::detail::visitor<ns::expr<ns::plus, ns::expr<ns::times, ns::terminal<double>, ns::terminal<double> >, "
+        "ns::terminal<double> > >::operator()(ns::context&) const",
+    "std::thread::_State_impl<std::thread::_Invoker<std::tuple<void (*)(std::basic_string_view<char, "
+        "std::char_traits<char> >), char const*> > >::_M_run()",
+};
+
+// The same sort of symbols before demangling, from instantiations of standard library templates
+const std::vector<std::string> mangled_symbols = {
+    "main",
+    "_Z3fooRKNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEEi",
+    "_ZNSt6vectorIiSaIiEE9push_backEOi",
+    "_ZNSt17_Function_handlerIFviEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi",
+    "_ZNSt10unique_ptrIN2ns6widgetESt14default_deleteIS1_EE11get_deleterEv",
+    "_ZNSt6thread11_State_implINS_8_InvokerISt5tupleIJPFvSt17basic_string_viewIcSt11char_traitsIcEEEPKcEEEEE6_M_runEv",
+    "_ZNSt6vectorINSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEESaIS5_EE17_M_realloc_insertIJRKS5_EEEvN9__gnu_cx"
+        "x17__normal_iteratorIPS5_S7_EEDpOT_",
+    "_ZSt21__unguarded_partitionIN9__gnu_cxx17__normal_iteratorIPNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEES"
+        "t6vectorIS7_SaIS7_EEEENS0_5__ops15_Iter_comp_iterIZ4mainEUlRKS7_SG_E0_EEET_SJ_SJ_SJ_T0_",
+    "_ZNSt8_Rb_treeIiSt4pairIKiSt6vectorIiSaIiEEESt10_Select1stIS5_ESt4lessIiESaIS5_EE22_M_emplace_hint_uniqueIJRKSt21"
+        "piecewise_construct_tSt5tupleIJOiEESG_IJEEEEESt17_Rb_tree_iteratorIS5_ESt23_Rb_tree_const_iteratorIS5_EDpOT_",
+    "_ZNSt10_HashtableINSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEESt4pairIKS5_St10shared_ptrIN2ns6widgetEEESaI"
+        "SC_ENSt8__detail10_Select1stESt8equal_toIS5_ESt4hashIS5_ENSE_18_Mod_range_hashingENSE_20_Default_ranged_hashEN"
+        "SE_20_Prime_rehash_policyENSE_17_Hashtable_traitsILb1ELb0ELb1EEEE7emplaceIJRA2_KcDnEEES6_INSE_14_Node_iterator"
+        "ISC_Lb0ELb1EEEbEDpOT_",
+};
+
+cpptrace::stacktrace make_trace() {
+    cpptrace::stacktrace trace;
+    for(std::size_t i = 0; i < symbols.size(); i++) {
+        trace.frames.push_back({0x1000 + i, 0x1000 + i, {20}, {30}, "foo.cpp", symbols[i], false});
+    }
+    return trace;
+}
+
+static void format(benchmark::State& state, cpptrace::formatter::symbol_mode mode) {
+    auto trace = make_trace();
+    auto formatter = cpptrace::formatter{}.symbols(mode);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(formatter.format(trace));
+    }
+    state.SetItemsProcessed(state.iterations() * trace.frames.size());
+}
+
+// formatting into a buffer which is reused between iterations, as a logger writing into a ring buffer would
+static void format_to(benchmark::State& state, cpptrace::formatter::symbol_mode mode) {
+    auto trace = make_trace();
+    auto formatter = cpptrace::formatter{}.symbols(mode);
+    std::vector<char> buffer(64 * 1024);
+    for(auto _ : state) {
+        auto res = formatter.format_to(buffer.data(), trace);
+        benchmark::DoNotOptimize(res.size);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * trace.frames.size());
+}
+
+// Every combination of symbol, address and path modes, with snippets on and off. Frames point into this file so that
+// there's something to take snippets from.
+static void format_options(benchmark::State& state) {
+    cpptrace::stacktrace trace;
+    for(std::size_t i = 0; i < symbols.size(); i++) {
+        auto line = static_cast<std::uint32_t>(20 + 10 * i);
+        trace.frames.push_back({0x1000 + i, 0x1000 + i, {line}, {5}, __FILE__, symbols[i], false});
+    }
+    auto formatter = cpptrace::formatter{}
+        .symbols(static_cast<cpptrace::formatter::symbol_mode>(state.range(0)))
+        .addresses(static_cast<cpptrace::formatter::address_mode>(state.range(1)))
+        .paths(static_cast<cpptrace::formatter::path_mode>(state.range(2)))
+        .snippets(state.range(3) != 0);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(formatter.format(trace));
+    }
+    state.SetItemsProcessed(state.iterations() * trace.frames.size());
+}
+
+// Demangled symbols are only cached under cache_mode::prioritize_speed, so prioritize_memory measures the demangler
+// itself and prioritize_speed measures lookups in the demangle cache past the first iteration
+static void demangle(benchmark::State& state, cpptrace::cache_mode mode) {
+    cpptrace::experimental::set_cache_mode(mode);
+    for(auto _ : state) {
+        for(const auto& symbol : mangled_symbols) {
+            benchmark::DoNotOptimize(cpptrace::demangle(symbol));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * mangled_symbols.size());
+    cpptrace::experimental::set_cache_mode(cpptrace::cache_mode::prioritize_speed);
+}
+
+static void prune_symbol(benchmark::State& state) {
+    for(auto _ : state) {
+        for(const auto& symbol : symbols) {
+            benchmark::DoNotOptimize(cpptrace::prune_symbol(symbol));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * symbols.size());
+}
+
+static void get_snippet(benchmark::State& state, bool color) {
+    std::uint32_t line = 1;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(cpptrace::get_snippet(__FILE__, line, 2, color));
+        // walk through the file, wrapping around before the end
+        line = line % 150 + 1;
+    }
+}
+
+static void prettify_symbol(benchmark::State& state) {
+    for(auto _ : state) {
+        for(const auto& symbol : symbols) {
+            benchmark::DoNotOptimize(cpptrace::prettify_symbol(symbol));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * symbols.size());
+}
+
+BENCHMARK_CAPTURE(format, full, cpptrace::formatter::symbol_mode::full);
+BENCHMARK_CAPTURE(format, pretty, cpptrace::formatter::symbol_mode::pretty);
+BENCHMARK_CAPTURE(format, pruned, cpptrace::formatter::symbol_mode::pruned);
+BENCHMARK_CAPTURE(format_to, full, cpptrace::formatter::symbol_mode::full);
+BENCHMARK_CAPTURE(format_to, pretty, cpptrace::formatter::symbol_mode::pretty);
+BENCHMARK_CAPTURE(format_to, pruned, cpptrace::formatter::symbol_mode::pruned);
+BENCHMARK(format_options)
+    ->ArgsProduct({
+        {0, 1, 2}, // symbol_mode
+        {0, 1, 2}, // address_mode
+        {0, 1}, // path_mode
+        {0, 1}, // snippets
+    })
+    ->ArgNames({"symbols", "addresses", "paths", "snippets"});
+BENCHMARK(prettify_symbol);
+BENCHMARK_CAPTURE(demangle, uncached, cpptrace::cache_mode::prioritize_memory);
+BENCHMARK_CAPTURE(demangle, cached, cpptrace::cache_mode::prioritize_speed);
+BENCHMARK(prune_symbol);
+BENCHMARK_CAPTURE(get_snippet, plain, false);
+BENCHMARK_CAPTURE(get_snippet, color, true);
+
+BENCHMARK_MAIN();
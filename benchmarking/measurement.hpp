@@ -0,0 +1,73 @@
+#ifndef BENCHMARKING_MEASUREMENT_HPP
+#define BENCHMARKING_MEASUREMENT_HPP
+
+#include <chrono>
+#include <utility>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Shared by the resolution benchmarks. Resolution caches are process-wide, and the dwarf resolver options only apply to
+// resolvers created after they're set, so every measurement is taken in a freshly forked child. A cold measurement is
+// the first resolution in the child, a warm one is the second. Only the resolution itself is timed.
+
+struct measurement {
+    double seconds;
+    long peak_rss_kb;
+    // growth of the peak rss over the course of the resolution(s)
+    long rss_growth_kb;
+};
+
+inline long peak_rss_kb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    #ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+    #else
+    return usage.ru_maxrss;
+    #endif
+}
+
+// setup() runs untimed before the rss baseline is taken, e.g. to apply options, then resolve() is measured
+template<typename S, typename R>
+[[noreturn]] void measure_in_child(int fd, bool warm, S&& setup, R&& resolve) {
+    setup();
+    auto rss_before = peak_rss_kb();
+    if(warm) {
+        resolve();
+    }
+    auto start = std::chrono::steady_clock::now();
+    resolve();
+    auto end = std::chrono::steady_clock::now();
+    auto rss_after = peak_rss_kb();
+    measurement result{std::chrono::duration<double>(end - start).count(), rss_after, rss_after - rss_before};
+    auto written = write(fd, &result, sizeof(result));
+    _exit(written == sizeof(result) ? 0 : 1);
+}
+
+template<typename S, typename R>
+bool measure(measurement& result, bool warm, S&& setup, R&& resolve) {
+    int fds[2];
+    if(pipe(fds) != 0) {
+        return false;
+    }
+    pid_t pid = fork();
+    if(pid == -1) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if(pid == 0) {
+        close(fds[0]);
+        measure_in_child(fds[1], warm, std::forward<S>(setup), std::forward<R>(resolve));
+    }
+    close(fds[1]);
+    auto count = read(fds[0], &result, sizeof(result));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return count == sizeof(result) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+#endif
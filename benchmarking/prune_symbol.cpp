@@ -0,0 +1,32 @@
+#include <cpptrace/utils.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "../test/unit/lib/prune_symbol_cases.hpp"
+
+// The inputs from the prune_symbol unit tests
+const std::vector<std::string> symbols = [] {
+    std::vector<std::string> inputs;
+    for(const auto& group : prune_symbol_cases::all) {
+        for(auto test_case = group.begin; test_case != group.end; test_case++) {
+            inputs.push_back(test_case->symbol);
+        }
+    }
+    return inputs;
+}();
+
+static void prune_symbol(benchmark::State& state) {
+    for(auto _ : state) {
+        for(const auto& symbol : symbols) {
+            benchmark::DoNotOptimize(cpptrace::prune_symbol(symbol));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * symbols.size());
+}
+
+BENCHMARK(prune_symbol);
+
+BENCHMARK_MAIN();
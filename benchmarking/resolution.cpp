@@ -0,0 +1,160 @@
+#include <cpptrace/cpptrace.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+
+#include "measurement.hpp"
+
+// Every measurement is taken in a freshly forked child, see measurement.hpp
+
+struct resolution_config {
+    cpptrace::cache_mode cache_mode = cpptrace::cache_mode::prioritize_speed;
+    bool disable_aranges = false;
+    cpptrace::nullable<std::size_t> line_table_cache_size = cpptrace::nullable<std::size_t>::null();
+};
+
+enum class trace_kind {
+    raw,
+    object,
+};
+
+void resolve(const cpptrace::raw_trace& raw, const cpptrace::object_trace& object, trace_kind kind) {
+    if(kind == trace_kind::raw) {
+        benchmark::DoNotOptimize(raw.resolve());
+    } else {
+        benchmark::DoNotOptimize(object.resolve());
+    }
+}
+
+bool measure(
+    measurement& result,
+    const resolution_config& config,
+    const cpptrace::raw_trace& trace,
+    trace_kind kind,
+    bool warm
+) {
+    cpptrace::object_trace object;
+    return measure(
+        result,
+        warm,
+        [&] {
+            cpptrace::experimental::set_cache_mode(config.cache_mode);
+            cpptrace::experimental::set_dwarf_resolver_disable_aranges(config.disable_aranges);
+            cpptrace::experimental::set_dwarf_resolver_line_table_cache_size(config.line_table_cache_size);
+            object = trace.resolve_object_trace();
+        },
+        [&] { resolve(trace, object, kind); }
+    );
+}
+
+// A few distinct frames to resolve, collected once in the parent and inherited by each child
+struct trace_collector {
+    cpptrace::raw_trace trace;
+};
+
+[[gnu::noinline]] void collect_trace(trace_collector& collector, int depth) {
+    if(depth == 0) {
+        collector.trace = cpptrace::generate_raw_trace();
+    } else if(depth % 2 == 0) {
+        collect_trace(collector, depth - 1);
+        benchmark::ClobberMemory();
+    } else {
+        collect_trace(collector, depth - 1);
+        benchmark::DoNotOptimize(depth);
+    }
+}
+
+const cpptrace::raw_trace& get_trace() {
+    static trace_collector collector = [] {
+        trace_collector collector;
+        collect_trace(collector, 10);
+        return collector;
+    }();
+    return collector.trace;
+}
+
+void resolution(benchmark::State& state, resolution_config config, trace_kind kind, bool warm) {
+    const auto& trace = get_trace();
+    long peak_rss = 0;
+    long rss_growth = 0;
+    for(auto _ : state) {
+        measurement result{};
+        if(!measure(result, config, trace, kind, warm)) {
+            state.SkipWithError("measurement in child process failed");
+            break;
+        }
+        state.SetIterationTime(result.seconds);
+        peak_rss = std::max(peak_rss, result.peak_rss_kb);
+        rss_growth = std::max(rss_growth, result.rss_growth_kb);
+    }
+    state.counters["frames"] = static_cast<double>(trace.frames.size());
+    state.counters["peak_rss_kb"] = static_cast<double>(peak_rss);
+    state.counters["rss_growth_kb"] = static_cast<double>(rss_growth);
+}
+
+const char* to_string(cpptrace::cache_mode mode) {
+    switch(mode) {
+        case cpptrace::cache_mode::prioritize_memory:
+            return "prioritize_memory";
+        case cpptrace::cache_mode::hybrid:
+            return "hybrid";
+        case cpptrace::cache_mode::prioritize_speed:
+            return "prioritize_speed";
+    }
+    return "unknown";
+}
+
+void register_benchmark(const std::string& name, resolution_config config, trace_kind kind, bool warm) {
+    auto full_name = std::string("resolve/")
+        + (kind == trace_kind::raw ? "raw" : "object")
+        + (warm ? "/warm/" : "/cold/")
+        + name;
+    benchmark::RegisterBenchmark(
+        full_name.c_str(),
+        [config, kind, warm] (benchmark::State& state) { resolution(state, config, kind, warm); }
+    )->UseManualTime()->Unit(benchmark::kMillisecond);
+}
+
+int main(int argc, char** argv) {
+    // collected up front so that the trace doesn't depend on which benchmarks run
+    get_trace();
+    for(auto kind : {trace_kind::raw, trace_kind::object}) {
+        for(auto warm : {false, true}) {
+            for(
+                auto mode : {
+                    cpptrace::cache_mode::prioritize_memory,
+                    cpptrace::cache_mode::hybrid,
+                    cpptrace::cache_mode::prioritize_speed
+                }
+            ) {
+                for(auto disable_aranges : {false, true}) {
+                    resolution_config config;
+                    config.cache_mode = mode;
+                    config.disable_aranges = disable_aranges;
+                    register_benchmark(
+                        std::string(to_string(mode)) + (disable_aranges ? "/no_aranges" : "/aranges"),
+                        config,
+                        kind,
+                        warm
+                    );
+                }
+            }
+        }
+    }
+    for(auto warm : {false, true}) {
+        for(std::size_t size : {1, 16, 256}) {
+            resolution_config config;
+            config.line_table_cache_size = size;
+            register_benchmark("line_table_cache_size:" + std::to_string(size), config, trace_kind::object, warm);
+        }
+    }
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
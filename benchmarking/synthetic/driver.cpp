@@ -0,0 +1,124 @@
+#include <cpptrace/cpptrace.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "../measurement.hpp"
+#include "synthetic.hpp"
+
+// Linked into every synthetic program. Collects traces through a spread of the program's translation units and
+// measures resolving them, the same way benchmark_resolution does: every measurement is taken in a freshly forked child
+// so that the process-wide caches start out empty. A cold measurement is the first resolution in the child, a warm one
+// is the second.
+//
+// SYNTHETIC_CONFIG is units:functions:templates:inline_depth, set by the build along with SYNTHETIC_DEBUG_INFO which
+// describes how the program's debug info was emitted.
+
+struct resolution_config {
+    cpptrace::cache_mode cache_mode = cpptrace::cache_mode::prioritize_speed;
+    bool disable_aranges = false;
+};
+
+std::vector<cpptrace::raw_trace> traces;
+
+int collect_trace(int x) {
+    traces.push_back(cpptrace::generate_raw_trace());
+    return x;
+}
+
+void collect_traces(std::size_t count) {
+    count = std::min(count, synthetic_entry_count);
+    for(std::size_t i = 0; i < count; i++) {
+        auto entry = synthetic_entries[i * synthetic_entry_count / count];
+        benchmark::DoNotOptimize(entry(static_cast<int>(i), collect_trace));
+    }
+}
+
+void resolve_all() {
+    for(const auto& trace : traces) {
+        benchmark::DoNotOptimize(trace.resolve());
+    }
+}
+
+bool measure(measurement& result, const resolution_config& config, bool warm) {
+    return measure(
+        result,
+        warm,
+        [&] {
+            cpptrace::experimental::set_cache_mode(config.cache_mode);
+            cpptrace::experimental::set_dwarf_resolver_disable_aranges(config.disable_aranges);
+        },
+        resolve_all
+    );
+}
+
+// doesn't include .dwo files
+double binary_size_mb(const char* path) {
+    struct stat info{};
+    if(stat(path, &info) != 0) {
+        return 0;
+    }
+    return static_cast<double>(info.st_size) / (1024 * 1024);
+}
+
+void resolution(benchmark::State& state, resolution_config config, bool warm, double binary_size) {
+    std::size_t frames = 0;
+    for(const auto& trace : traces) {
+        frames += trace.frames.size();
+    }
+    long peak_rss = 0;
+    long rss_growth = 0;
+    for(auto _ : state) {
+        measurement result{};
+        if(!measure(result, config, warm)) {
+            state.SkipWithError("measurement in child process failed");
+            break;
+        }
+        state.SetIterationTime(result.seconds);
+        peak_rss = std::max(peak_rss, result.peak_rss_kb);
+        rss_growth = std::max(rss_growth, result.rss_growth_kb);
+    }
+    state.counters["units"] = static_cast<double>(synthetic_entry_count);
+    state.counters["traces"] = static_cast<double>(traces.size());
+    state.counters["frames"] = static_cast<double>(frames);
+    state.counters["binary_mb"] = binary_size;
+    state.counters["peak_rss_kb"] = static_cast<double>(peak_rss);
+    state.counters["rss_growth_kb"] = static_cast<double>(rss_growth);
+}
+
+int main(int argc, char** argv) {
+    // collected up front so that the traces don't depend on which benchmarks run
+    collect_traces(16);
+    auto binary_size = binary_size_mb(argv[0]);
+    for(auto warm : {false, true}) {
+        for(auto mode : {cpptrace::cache_mode::prioritize_memory, cpptrace::cache_mode::prioritize_speed}) {
+            for(auto disable_aranges : {false, true}) {
+                resolution_config config;
+                config.cache_mode = mode;
+                config.disable_aranges = disable_aranges;
+                auto name = std::string("synthetic/" SYNTHETIC_CONFIG "/" SYNTHETIC_DEBUG_INFO)
+                    + (warm ? "/warm" : "/cold")
+                    + (mode == cpptrace::cache_mode::prioritize_memory ? "/prioritize_memory" : "/prioritize_speed")
+                    + (disable_aranges ? "/no_aranges" : "/aranges");
+                benchmark::RegisterBenchmark(
+                    name.c_str(),
+                    [config, warm, binary_size] (benchmark::State& state) {
+                        resolution(state, config, warm, binary_size);
+                    }
+                )->UseManualTime()->Unit(benchmark::kMillisecond);
+            }
+        }
+    }
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Writes the sources of a synthetic program: one file per translation unit plus a table of entry points. Every unit
+// holds a namespace of noinline functions that call each other in a chain of roughly log2(functions) frames, a chain of
+// always_inline helpers in every function, and a class template explicitly instantiated a number of times. Nothing
+// here is meant to be fast to compile, only to produce large and realistically shaped debug info.
+//
+// Usage: synthetic_generator <output directory> <units> <functions per unit> <template instantiations per unit>
+//                            <inline depth>
+
+struct parameters {
+    int units;
+    int functions;
+    int templates;
+    int inline_depth;
+};
+
+// Only touches the file if its contents change so that regenerating doesn't force a rebuild of everything
+bool write_file(const std::string& path, const std::string& contents) {
+    {
+        std::ifstream existing(path, std::ios::binary);
+        if(existing) {
+            std::stringstream buffer;
+            buffer << existing.rdbuf();
+            if(buffer.str() == contents) {
+                return true;
+            }
+        }
+    }
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+    return static_cast<bool>(file);
+}
+
+std::string generate_unit(const parameters& params, int unit) {
+    std::ostringstream out;
+    out << "// generated by synthetic_generator, do not edit\n";
+    out << "#include \"synthetic.hpp\"\n\n";
+    out << "namespace synthetic_unit_" << unit << " {\n\n";
+    if(params.templates > 0) {
+        out << "template<int I>\n";
+        out << "struct instance {\n";
+        out << "    int value;\n";
+        out << "    SYNTHETIC_NOINLINE int step(int x) const {\n";
+        out << "        return (x ^ value) * (I + 1) + " << unit << ";\n";
+        out << "    }\n";
+        out << "    SYNTHETIC_NOINLINE int twice(int x) const {\n";
+        out << "        return step(step(x)) - I;\n";
+        out << "    }\n";
+        out << "};\n\n";
+        for(int i = 0; i < params.templates; i++) {
+            out << "template struct instance<" << i << ">;\n";
+        }
+        out << "\n";
+    }
+    for(int depth = params.inline_depth - 1; depth >= 0; depth--) {
+        out << "SYNTHETIC_INLINE int inline_" << depth << "(int x, synthetic_sink sink) {\n";
+        if(depth == params.inline_depth - 1) {
+            out << "    int result = sink ? sink(x) : x;\n";
+        } else {
+            out << "    int result = inline_" << depth + 1 << "(x ^ " << depth << ", sink);\n";
+        }
+        out << "    return result + " << depth + 1 << ";\n";
+        out << "}\n\n";
+    }
+    for(int function = 0; function < params.functions; function++) {
+        out << "SYNTHETIC_NOINLINE int function_" << function << "(int x, synthetic_sink sink) {\n";
+        // only the bottom of the chain calls the sink, every other function still carries the inline chain
+        const char* sink = function == 0 ? "sink" : "nullptr";
+        if(params.inline_depth > 0) {
+            out << "    int result = inline_0(x, " << sink << ");\n";
+        } else {
+            out << "    int result = " << sink << " ? sink(x) : x;\n";
+        }
+        if(function > 0) {
+            out << "    result += function_" << function / 2 << "(x + " << function << ", sink);\n";
+        }
+        if(params.templates > 0) {
+            out << "    result += instance<" << function % params.templates << ">{" << function << "}.twice(result);\n";
+        }
+        out << "    return result;\n";
+        out << "}\n\n";
+    }
+    out << "}\n\n";
+    out << "int synthetic_entry_" << unit << "(int x, synthetic_sink sink) {\n";
+    out << "    return synthetic_unit_" << unit << "::function_" << params.functions - 1 << "(x, sink) + 1;\n";
+    out << "}\n";
+    return out.str();
+}
+
+std::string generate_entries(const parameters& params) {
+    std::ostringstream out;
+    out << "// generated by synthetic_generator, do not edit\n";
+    out << "#include \"synthetic.hpp\"\n\n";
+    for(int unit = 0; unit < params.units; unit++) {
+        out << "int synthetic_entry_" << unit << "(int x, synthetic_sink sink);\n";
+    }
+    out << "\nconst synthetic_entry synthetic_entries[] = {\n";
+    for(int unit = 0; unit < params.units; unit++) {
+        out << "    synthetic_entry_" << unit << ",\n";
+    }
+    out << "};\n\n";
+    out << "const std::size_t synthetic_entry_count = " << params.units << ";\n";
+    return out.str();
+}
+
+int main(int argc, char** argv) {
+    if(argc != 6) {
+        std::cerr << "Usage: " << argv[0]
+            << " <output directory> <units> <functions per unit> <template instantiations per unit> <inline depth>"
+            << std::endl;
+        return 1;
+    }
+    std::string directory = argv[1];
+    parameters params{std::atoi(argv[2]), std::atoi(argv[3]), std::atoi(argv[4]), std::atoi(argv[5])};
+    if(params.units < 1 || params.functions < 1 || params.templates < 0 || params.inline_depth < 0) {
+        std::cerr << "Error: Need at least one unit and one function per unit" << std::endl;
+        return 1;
+    }
+    for(int unit = 0; unit < params.units; unit++) {
+        auto path = directory + "/unit_" + std::to_string(unit) + ".cpp";
+        if(!write_file(path, generate_unit(params, unit))) {
+            std::cerr << "Error: Failed to write " << path << std::endl;
+            return 1;
+        }
+    }
+    auto path = directory + "/entries.cpp";
+    if(!write_file(path, generate_entries(params))) {
+        std::cerr << "Error: Failed to write " << path << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,17 @@
+#ifndef SYNTHETIC_HPP
+#define SYNTHETIC_HPP
+
+#include <cstddef>
+
+// Shared by the generated translation units and the driver, see generator.cpp
+
+#define SYNTHETIC_NOINLINE __attribute__((noinline))
+#define SYNTHETIC_INLINE inline __attribute__((always_inline))
+
+using synthetic_sink = int(*)(int);
+using synthetic_entry = int(*)(int, synthetic_sink);
+
+extern const synthetic_entry synthetic_entries[];
+extern const std::size_t synthetic_entry_count;
+
+#endif
@@ -71,6 +71,10 @@ if(APPLE)
   check_support(HAS_MACH_VM has_mach_vm.cpp "" "" "")
 endif()
 
+if(CPPTRACE_USDT_PROBES)
+  check_support(HAS_SYS_SDT has_sys_sdt.cpp "" "" "")
+endif()
+
 # ================================================ Autoconfig unwinding ================================================
 # Unwind back-ends
 if(
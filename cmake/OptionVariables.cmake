@@ -157,6 +157,8 @@ if(PROJECT_IS_TOP_LEVEL)
   option(CPPTRACE_BUILD_TESTING_SPLIT_DWARF "" OFF)
   set(CPPTRACE_BUILD_TESTING_DWARF_VERSION "0" CACHE STRING "")
   option(CPPTRACE_BUILD_TEST_RDYNAMIC "" OFF)
+  set(CPPTRACE_BENCHMARKING_SYNTHETIC_CONFIGS "16:64:16:2;128:128:32:4;512:256:64:8" CACHE STRING "")
+  option(CPPTRACE_BENCHMARKING_SYNTHETIC_NO_ARANGES "" OFF)
   mark_as_advanced(
     CPPTRACE_BUILD_TESTING
     CPPTRACE_BUILD_TOOLS
@@ -165,6 +167,8 @@ if(PROJECT_IS_TOP_LEVEL)
     CPPTRACE_BUILD_TESTING_SPLIT_DWARF
     CPPTRACE_BUILD_TESTING_DWARF_VERSION
     CPPTRACE_BUILD_TEST_RDYNAMIC
+    CPPTRACE_BENCHMARKING_SYNTHETIC_CONFIGS
+    CPPTRACE_BENCHMARKING_SYNTHETIC_NO_ARANGES
   )
 endif()
 
@@ -179,6 +183,7 @@ option(CPPTRACE_POSITION_INDEPENDENT_CODE "" ON)
 option(CPPTRACE_SKIP_UNIT "" OFF)
 option(CPPTRACE_STD_FORMAT "" ON)
 option(CPPTRACE_UNPREFIXED_TRY_CATCH "" OFF)
+option(CPPTRACE_USDT_PROBES "" OFF)
 option(CPPTRACE_USE_EXTERNAL_GTEST "" OFF)
 set(CPPTRACE_ZSTD_URL "https://github.com/facebook/zstd/releases/download/v1.5.7/zstd-1.5.7.tar.gz" CACHE STRING "")
 set(CPPTRACE_LIBDWARF_REPO "https://github.com/jeremy-rifkin/libdwarf-lite.git" CACHE STRING "")
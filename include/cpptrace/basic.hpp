@@ -52,12 +52,25 @@
 #endif
 
 CPPTRACE_BEGIN_NAMESPACE
+    // How much information to resolve for a trace, from cheapest to most expensive
+    enum class resolution_level {
+        // Only object information (object path and object address), no symbols are looked up
+        address_only,
+        // Symbol names from the object file's symbol table, debug info is never loaded
+        symbol_only,
+        // Symbol names and source locations from debug info, inlined calls are not reported
+        symbol_and_line,
+        // Everything, including inlined call frames
+        full_with_inlines
+    };
+
     struct CPPTRACE_EXPORT raw_trace {
         std::vector<frame_ptr> frames;
         static raw_trace current(std::size_t skip = 0);
         static raw_trace current(std::size_t skip, std::size_t max_depth);
         object_trace resolve_object_trace() const;
         stacktrace resolve() const;
+        stacktrace resolve(resolution_level level) const;
         void clear();
         bool empty() const noexcept;
 
@@ -82,6 +95,7 @@ CPPTRACE_BEGIN_NAMESPACE
         static object_trace current(std::size_t skip = 0);
         static object_trace current(std::size_t skip, std::size_t max_depth);
         stacktrace resolve() const;
+        stacktrace resolve(resolution_level level) const;
         void clear();
         bool empty() const noexcept;
 
@@ -163,6 +177,8 @@ CPPTRACE_BEGIN_NAMESPACE
         }
 
         object_frame get_object_info() const;
+        // The symbol is left mangled when lazy demangling is enabled
+        std::string demangled_symbol() const;
 
         std::string to_string() const;
         std::string to_string(bool color) const;
@@ -236,6 +252,14 @@ CPPTRACE_BEGIN_NAMESPACE
     CPPTRACE_EXPORT void get_safe_object_frame(frame_ptr address, safe_object_frame* out);
     CPPTRACE_EXPORT bool can_signal_safe_unwind();
     CPPTRACE_EXPORT bool can_get_safe_object_frame();
+    // signal-safe
+    // Minimal trace printing for crash handlers, only write(2) and the stack are used. Frames are printed as their
+    // address along with the object's basename and the offset into the object, when get_safe_object_frame is able to
+    // provide them. The raw trace overload needs a safe_object_frame's worth of stack space. Returns the number of
+    // bytes written.
+    CPPTRACE_EXPORT std::size_t safe_print_raw_trace(int fd, const frame_ptr* buffer, std::size_t size);
+    // signal-safe
+    CPPTRACE_EXPORT std::size_t safe_print_object_frames(int fd, const safe_object_frame* frames, std::size_t size);
 
     // JIT API
     CPPTRACE_EXPORT void register_jit_object(const char*, std::size_t);
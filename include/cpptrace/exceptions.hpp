@@ -21,6 +21,8 @@ CPPTRACE_BEGIN_NAMESPACE
         // This is a helper utility, if the library weren't C++11 an std::variant would be used
         class CPPTRACE_EXPORT lazy_trace_holder {
             bool resolved;
+            // the trace was skipped by the capture policy
+            bool sampled_out = false;
             union {
                 raw_trace trace;
                 stacktrace resolved_trace;
@@ -29,6 +31,8 @@ CPPTRACE_BEGIN_NAMESPACE
             // constructors
             lazy_trace_holder() : resolved(false), trace() {}
             explicit lazy_trace_holder(raw_trace&& _trace) : resolved(false), trace(std::move(_trace)) {}
+            lazy_trace_holder(raw_trace&& _trace, bool _sampled_out)
+                : resolved(false), sampled_out(_sampled_out), trace(std::move(_trace)) {}
             explicit lazy_trace_holder(stacktrace&& _resolved_trace) : resolved(true), resolved_trace(std::move(_resolved_trace)) {}
             // logistics
             lazy_trace_holder(const lazy_trace_holder& other);
@@ -41,12 +45,15 @@ CPPTRACE_BEGIN_NAMESPACE
             stacktrace& get_resolved_trace();
             const stacktrace& get_resolved_trace() const;
             bool is_resolved() const;
+            bool is_sampled_out() const;
         private:
             void clear();
         };
 
         CPPTRACE_EXPORT raw_trace get_raw_trace_and_absorb(std::size_t skip, std::size_t max_depth);
         CPPTRACE_EXPORT raw_trace get_raw_trace_and_absorb(std::size_t skip = 0);
+        // Whether the trace came from a get_raw_trace_and_absorb call on this thread which the capture policy skipped
+        CPPTRACE_EXPORT bool was_sampled_out(const raw_trace& trace) noexcept;
     }
 
     // Interface for a traced exception object
@@ -66,12 +73,14 @@ CPPTRACE_BEGIN_NAMESPACE
     public:
         explicit lazy_exception(
             raw_trace&& trace = detail::get_raw_trace_and_absorb()
-        ) : trace_holder(std::move(trace)) {}
+        ) : trace_holder(std::move(trace), detail::was_sampled_out(trace)) {}
         // std::exception
         const char* what() const noexcept override;
         // cpptrace::exception
         const char* message() const noexcept override;
         const stacktrace& trace() const noexcept override;
+        // The trace is empty because the capture policy skipped it, see experimental::set_capture_policy
+        bool trace_was_sampled_out() const noexcept;
     };
 
     class CPPTRACE_EXPORT exception_with_message : public lazy_exception {
@@ -3,10 +3,47 @@
 
 #include <cpptrace/basic.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <limits>
 #include <string>
 #include <functional>
 
 CPPTRACE_BEGIN_NAMESPACE
+    namespace detail {
+        // Destination for formatter output, the formatter hands over its output in chunks as it's produced
+        class format_sink {
+        public:
+            virtual ~format_sink() = default;
+            virtual void write(const char* data, std::size_t size) = 0;
+        };
+
+        // Output past the limit is dropped
+        template<typename OutputIt>
+        class iterator_format_sink : public format_sink {
+        public:
+            OutputIt out;
+            std::size_t remaining;
+            explicit iterator_format_sink(
+                OutputIt out,
+                std::size_t limit = (std::numeric_limits<std::size_t>::max)()
+            ) : out(out), remaining(limit) {}
+            void write(const char* data, std::size_t size) override {
+                auto count = (std::min)(size, remaining);
+                out = std::copy(data, data + count, out);
+                remaining -= count;
+            }
+        };
+    }
+
+    template<typename OutputIt>
+    struct format_to_result {
+        // iterator past the end of the output
+        OutputIt out;
+        // number of characters in the full output, for format_to_n this can be more than were written
+        std::size_t size;
+    };
+
     class CPPTRACE_EXPORT formatter {
         class impl;
         // can't be a std::unique_ptr due to msvc awfulness with dllimport/dllexport and https://stackoverflow.com/q/4145605/15675011
@@ -58,6 +95,8 @@ CPPTRACE_BEGIN_NAMESPACE
         formatter& transform(std::function<stacktrace_frame(stacktrace_frame)>);
         formatter& break_before_filename(bool do_break = true);
         formatter& hide_exception_machinery(bool do_hide = true);
+        // Level of detail used when formatting raw traces and object traces
+        formatter& resolution(resolution_level);
 
         std::string format(const stacktrace_frame&) const;
         std::string format(const stacktrace_frame&, bool color) const;
@@ -67,6 +106,12 @@ CPPTRACE_BEGIN_NAMESPACE
         std::string format(const stacktrace&) const;
         std::string format(const stacktrace&, bool color) const;
 
+        // Raw traces and object traces are resolved according to the configured resolution level before formatting
+        std::string format(const raw_trace&) const;
+        std::string format(const raw_trace&, bool color) const;
+        std::string format(const object_trace&) const;
+        std::string format(const object_trace&, bool color) const;
+
         void print(const stacktrace_frame&) const;
         void print(const stacktrace_frame&, bool color) const;
         void print(std::ostream&, const stacktrace_frame&) const;
@@ -84,6 +129,182 @@ CPPTRACE_BEGIN_NAMESPACE
         void print(std::ostream&, const stacktrace&, bool color) const;
         void print(std::FILE*, const stacktrace&) const;
         void print(std::FILE*, const stacktrace&, bool color) const;
+
+        void print(const raw_trace&) const;
+        void print(const raw_trace&, bool color) const;
+        void print(std::ostream&, const raw_trace&) const;
+        void print(std::ostream&, const raw_trace&, bool color) const;
+        void print(std::FILE*, const raw_trace&) const;
+        void print(std::FILE*, const raw_trace&, bool color) const;
+
+        void print(const object_trace&) const;
+        void print(const object_trace&, bool color) const;
+        void print(std::ostream&, const object_trace&) const;
+        void print(std::ostream&, const object_trace&, bool color) const;
+        void print(std::FILE*, const object_trace&) const;
+        void print(std::FILE*, const object_trace&, bool color) const;
+
+        // Writes straight to the output iterator instead of building a string first. Output goes through a fixed-size
+        // scratch buffer and is copied to the iterator in chunks. Color is off unless it's requested or the color mode
+        // is always, as with format().
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to(OutputIt out, const stacktrace_frame& frame) const {
+            detail::iterator_format_sink<OutputIt> sink(out);
+            auto size = format_to_sink(sink, frame);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to(OutputIt out, const stacktrace_frame& frame, bool color) const {
+            detail::iterator_format_sink<OutputIt> sink(out);
+            auto size = format_to_sink(sink, frame, color, 0);
+            return {sink.out, size};
+        }
+        // The last argument is the indent to use for the filename, if break_before_filename is set
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to(
+            OutputIt out,
+            const stacktrace_frame& frame,
+            bool color,
+            size_t filename_indent
+        ) const {
+            detail::iterator_format_sink<OutputIt> sink(out);
+            auto size = format_to_sink(sink, frame, color, filename_indent);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to(OutputIt out, const stacktrace& trace) const {
+            detail::iterator_format_sink<OutputIt> sink(out);
+            auto size = format_to_sink(sink, trace);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to(OutputIt out, const stacktrace& trace, bool color) const {
+            detail::iterator_format_sink<OutputIt> sink(out);
+            auto size = format_to_sink(sink, trace, color);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to(OutputIt out, const raw_trace& trace) const {
+            detail::iterator_format_sink<OutputIt> sink(out);
+            auto size = format_to_sink(sink, trace);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to(OutputIt out, const raw_trace& trace, bool color) const {
+            detail::iterator_format_sink<OutputIt> sink(out);
+            auto size = format_to_sink(sink, trace, color);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to(OutputIt out, const object_trace& trace) const {
+            detail::iterator_format_sink<OutputIt> sink(out);
+            auto size = format_to_sink(sink, trace);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to(OutputIt out, const object_trace& trace, bool color) const {
+            detail::iterator_format_sink<OutputIt> sink(out);
+            auto size = format_to_sink(sink, trace, color);
+            return {sink.out, size};
+        }
+
+        // Like format_to but writes at most n characters, the rest of the output is dropped. The returned size is that
+        // of the full output so callers can tell if it was truncated.
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to_n(OutputIt out, std::size_t n, const stacktrace_frame& frame) const {
+            detail::iterator_format_sink<OutputIt> sink(out, n);
+            auto size = format_to_sink(sink, frame);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to_n(
+            OutputIt out,
+            std::size_t n,
+            const stacktrace_frame& frame,
+            bool color
+        ) const {
+            detail::iterator_format_sink<OutputIt> sink(out, n);
+            auto size = format_to_sink(sink, frame, color, 0);
+            return {sink.out, size};
+        }
+        // The last argument is the indent to use for the filename, if break_before_filename is set
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to_n(
+            OutputIt out,
+            std::size_t n,
+            const stacktrace_frame& frame,
+            bool color,
+            size_t filename_indent
+        ) const {
+            detail::iterator_format_sink<OutputIt> sink(out, n);
+            auto size = format_to_sink(sink, frame, color, filename_indent);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to_n(OutputIt out, std::size_t n, const stacktrace& trace) const {
+            detail::iterator_format_sink<OutputIt> sink(out, n);
+            auto size = format_to_sink(sink, trace);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to_n(OutputIt out, std::size_t n, const stacktrace& trace, bool color) const {
+            detail::iterator_format_sink<OutputIt> sink(out, n);
+            auto size = format_to_sink(sink, trace, color);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to_n(OutputIt out, std::size_t n, const raw_trace& trace) const {
+            detail::iterator_format_sink<OutputIt> sink(out, n);
+            auto size = format_to_sink(sink, trace);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to_n(OutputIt out, std::size_t n, const raw_trace& trace, bool color) const {
+            detail::iterator_format_sink<OutputIt> sink(out, n);
+            auto size = format_to_sink(sink, trace, color);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to_n(OutputIt out, std::size_t n, const object_trace& trace) const {
+            detail::iterator_format_sink<OutputIt> sink(out, n);
+            auto size = format_to_sink(sink, trace);
+            return {sink.out, size};
+        }
+        template<typename OutputIt>
+        format_to_result<OutputIt> format_to_n(
+            OutputIt out,
+            std::size_t n,
+            const object_trace& trace,
+            bool color
+        ) const {
+            detail::iterator_format_sink<OutputIt> sink(out, n);
+            auto size = format_to_sink(sink, trace, color);
+            return {sink.out, size};
+        }
+
+        // Writes to a file descriptor with write(2), color is decided based on whether the descriptor is a terminal.
+        // Returns the number of bytes written.
+        std::size_t print(int fd, const stacktrace_frame&) const;
+        std::size_t print(int fd, const stacktrace_frame&, bool color) const;
+        // The last argument is the indent to use for the filename, if break_before_filename is set
+        std::size_t print(int fd, const stacktrace_frame&, bool color, size_t filename_indent) const;
+        std::size_t print(int fd, const stacktrace&) const;
+        std::size_t print(int fd, const stacktrace&, bool color) const;
+        std::size_t print(int fd, const raw_trace&) const;
+        std::size_t print(int fd, const raw_trace&, bool color) const;
+        std::size_t print(int fd, const object_trace&) const;
+        std::size_t print(int fd, const object_trace&, bool color) const;
+
+    private:
+        // Backends for format_to, these return the number of characters written to the sink
+        std::size_t format_to_sink(detail::format_sink&, const stacktrace_frame&) const;
+        std::size_t format_to_sink(detail::format_sink&, const stacktrace_frame&, bool color, size_t indent) const;
+        std::size_t format_to_sink(detail::format_sink&, const stacktrace&) const;
+        std::size_t format_to_sink(detail::format_sink&, const stacktrace&, bool color) const;
+        std::size_t format_to_sink(detail::format_sink&, const raw_trace&) const;
+        std::size_t format_to_sink(detail::format_sink&, const raw_trace&, bool color) const;
+        std::size_t format_to_sink(detail::format_sink&, const object_trace&) const;
+        std::size_t format_to_sink(detail::format_sink&, const object_trace&, bool color) const;
     };
 
     CPPTRACE_EXPORT const formatter& get_default_formatter();
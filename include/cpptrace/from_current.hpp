@@ -20,6 +20,8 @@ CPPTRACE_BEGIN_NAMESPACE
     CPPTRACE_EXPORT const stacktrace& from_current_exception_rethrow();
 
     CPPTRACE_EXPORT bool current_exception_was_rethrown();
+    // The current exception's trace is empty because the capture policy skipped it
+    CPPTRACE_EXPORT bool current_exception_was_sampled_out();
 
     CPPTRACE_NORETURN CPPTRACE_EXPORT CPPTRACE_FORCE_NO_INLINE
     void rethrow();
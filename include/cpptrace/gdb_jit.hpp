@@ -36,16 +36,30 @@ namespace detail {
 
         extern struct jit_descriptor __jit_debug_descriptor;
     }
+
+    CPPTRACE_EXPORT void handle_gdb_jit_event(uint32_t action_flag, const jit_code_entry* relevant_entry);
+    CPPTRACE_EXPORT void sync_jit_objects_from_gdb_entries(const jit_code_entry* first_entry);
 }
 
 namespace experimental {
     inline void register_jit_objects_from_gdb_jit_interface() {
         clear_all_jit_objects();
-        detail::jit_code_entry* entry = detail::__jit_debug_descriptor.first_entry;
-        while(entry) {
-            register_jit_object(entry->symfile_addr, entry->symfile_size);
-            entry = entry->next_entry;
-        }
+        detail::sync_jit_objects_from_gdb_entries(detail::__jit_debug_descriptor.first_entry);
+    }
+
+    // Registers only entries which haven't been seen yet and unregisters entries which are no longer present. Objects
+    // registered through other means are left alone.
+    inline void sync_jit_objects_from_gdb_jit_interface() {
+        detail::sync_jit_objects_from_gdb_entries(detail::__jit_debug_descriptor.first_entry);
+    }
+
+    // Registers or unregisters the single object described by the descriptor's relevant_entry and action_flag. Meant
+    // to be called each time the jit calls __jit_debug_register_code.
+    inline void handle_gdb_jit_interface_event() {
+        detail::handle_gdb_jit_event(
+            detail::__jit_debug_descriptor.action_flag,
+            detail::__jit_debug_descriptor.relevant_entry
+        );
     }
 }
 CPPTRACE_END_NAMESPACE
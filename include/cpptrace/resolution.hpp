@@ -0,0 +1,87 @@
+#ifndef CPPTRACE_RESOLUTION_HPP
+#define CPPTRACE_RESOLUTION_HPP
+
+#include <cpptrace/basic.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace experimental {
+    // Resolves many traces at once. Addresses shared between the traces are only resolved and demangled once, which is
+    // much cheaper than resolving each trace in a loop when the traces have many frames in common.
+    CPPTRACE_EXPORT std::vector<stacktrace> resolve_many(
+        const std::vector<raw_trace>& traces,
+        resolution_level level = resolution_level::full_with_inlines
+    );
+    CPPTRACE_EXPORT std::vector<stacktrace> resolve_many(
+        const std::vector<object_trace>& traces,
+        resolution_level level = resolution_level::full_with_inlines
+    );
+
+    // Asynchronous resolution: traces are queued and resolved on background resolver threads. Traces which are queued
+    // together are resolved as a batch, so addresses shared between them are only resolved once.
+    CPPTRACE_EXPORT std::future<stacktrace> resolve_async(raw_trace trace);
+    CPPTRACE_EXPORT std::future<stacktrace> resolve_async(object_trace trace);
+
+    enum class full_queue_policy {
+        // resolve_async blocks until there's room in the queue
+        block,
+        // resolve_async resolves the trace with resolution_level::address_only on the calling thread
+        address_only
+    };
+
+    struct async_resolver_options {
+        // resolver threads, they're started on first use and live for the rest of the process
+        std::size_t threads = 1;
+        // traces which can be waiting to be resolved before full_queue_policy applies
+        std::size_t max_queued = 1024;
+        // most traces taken off the queue and resolved together
+        std::size_t max_batch = 64;
+        full_queue_policy when_full = full_queue_policy::block;
+    };
+
+    CPPTRACE_EXPORT void configure_async_resolver(const async_resolver_options& options);
+
+    // When set, traced exception objects resolve their traces through resolve_async and wait at most this long for
+    // them. Past that what() and trace() fall back to resolution_level::address_only and the resolution is abandoned.
+    // Traced exceptions never block on a full queue. Null (the default) resolves on the calling thread.
+    CPPTRACE_EXPORT void set_exception_resolution_timeout(nullable<std::size_t> milliseconds);
+
+    // Copies share state, cancelling any copy cancels all of them
+    class CPPTRACE_EXPORT cancellation_token {
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    public:
+        cancellation_token();
+        void cancel() noexcept;
+        bool is_cancelled() const noexcept;
+    };
+
+    // Called for each frame of the resulting trace in order, index is the frame's position in the trace
+    using frame_callback = std::function<void(std::size_t index, const stacktrace_frame& frame)>;
+
+    // Progressive resolution: frames are resolved in small chunks starting from the top of the stack and passed to the
+    // callback, in order, as soon as they're ready. Once the deadline passes or the token is cancelled the remaining
+    // frames are filled in with object information only (object path and object address), as with
+    // resolution_level::address_only. The deadline is checked between chunks, resolving a chunk isn't interrupted.
+    CPPTRACE_EXPORT stacktrace resolve_progressively(
+        const raw_trace& trace,
+        std::chrono::steady_clock::time_point deadline,
+        const frame_callback& callback = nullptr,
+        const cancellation_token& token = cancellation_token()
+    );
+    CPPTRACE_EXPORT stacktrace resolve_progressively(
+        const object_trace& trace,
+        std::chrono::steady_clock::time_point deadline,
+        const frame_callback& callback = nullptr,
+        const cancellation_token& token = cancellation_token()
+    );
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef CPPTRACE_SERIALIZATION_HPP
+#define CPPTRACE_SERIALIZATION_HPP
+
+#include <cpptrace/basic.hpp>
+
+#include <cstddef>
+#include <string>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace experimental {
+    // Encodes traces in a compact binary format. The traces written to an encoder form a stream: addresses are delta
+    // encoded, and module paths, filenames and symbols are only written the first time they appear in the stream,
+    // after which they're referred to by index. Streams are read back with trace_decoder.
+    class CPPTRACE_EXPORT trace_encoder {
+        class impl;
+        // can't be a std::unique_ptr due to msvc awfulness with dllimport/dllexport and https://stackoverflow.com/q/4145605/15675011
+        impl* pimpl;
+
+    public:
+        trace_encoder();
+        ~trace_encoder();
+
+        trace_encoder(trace_encoder&&);
+        trace_encoder(const trace_encoder&) = delete;
+        trace_encoder& operator=(trace_encoder&&);
+        trace_encoder& operator=(const trace_encoder&) = delete;
+
+        // Whether symbols go in the stream's string table (the default) or are written out for each frame. Takes
+        // effect for the following traces.
+        trace_encoder& intern_symbols(bool);
+
+        void encode(const raw_trace&);
+        void encode(const object_trace&);
+        void encode(const stacktrace&);
+
+        // Encoded output which hasn't been taken yet
+        const std::string& data() const;
+        // Moves the pending output out of the encoder. The stream continues, so output taken later still refers to
+        // strings from earlier output and the pieces must be decoded in order by the same decoder.
+        std::string take();
+        // Ends the stream, later output starts a new stream which doesn't refer to anything before it. Long-lived
+        // encoders should be reset every so often (e.g. per batch) as the string table otherwise keeps growing.
+        void reset();
+    };
+
+    struct CPPTRACE_EXPORT decoded_trace {
+        enum class trace_type {
+            raw,
+            object,
+            resolved,
+        };
+        // which one of the traces below was decoded
+        trace_type type = trace_type::raw;
+        raw_trace raw;
+        object_trace object;
+        stacktrace resolved;
+    };
+
+    enum class decode_status {
+        // a trace was decoded
+        ok,
+        // the input so far doesn't contain another complete trace
+        need_more_input,
+        // the input isn't a valid trace stream, the decoder can't be used any further
+        error,
+    };
+
+    // Decodes streams produced by trace_encoder. Input can be fed in arbitrary chunks.
+    class CPPTRACE_EXPORT trace_decoder {
+        class impl;
+        // can't be a std::unique_ptr due to msvc awfulness with dllimport/dllexport and https://stackoverflow.com/q/4145605/15675011
+        impl* pimpl;
+
+    public:
+        trace_decoder();
+        ~trace_decoder();
+
+        trace_decoder(trace_decoder&&);
+        trace_decoder(const trace_decoder&) = delete;
+        trace_decoder& operator=(trace_decoder&&);
+        trace_decoder& operator=(const trace_decoder&) = delete;
+
+        void feed(const char* data, std::size_t size);
+        void feed(const std::string& data);
+        decode_status next(decoded_trace& out);
+    };
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
@@ -3,7 +3,12 @@
 
 #include <cpptrace/basic.hpp>
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <string>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -64,6 +69,8 @@ CPPTRACE_BEGIN_NAMESPACE
 
     namespace experimental {
         CPPTRACE_EXPORT void set_cache_mode(cache_mode mode);
+        // Keep symbols mangled when resolving traces, they're demangled when formatting
+        CPPTRACE_EXPORT void enable_lazy_demangling(bool enable);
     }
 
     // dwarf options
@@ -72,6 +79,94 @@ CPPTRACE_BEGIN_NAMESPACE
         CPPTRACE_EXPORT void set_dwarf_resolver_disable_aranges(bool disable);
     }
 
+    // remote symbolization
+    namespace experimental {
+        // Resolve traces through a cpptrace-symbolizerd daemon listening on the given unix domain socket instead of
+        // in-process. Falls back to in-process resolution if the daemon can't be reached. An empty path turns remote
+        // symbolization off. Not supported on windows.
+        CPPTRACE_EXPORT void use_remote_symbolizer(std::string socket_path);
+    }
+
+    // statistics
+    namespace experimental {
+        struct latency_histogram {
+            std::uint64_t count = 0;
+            std::uint64_t total_ns = 0;
+            // buckets[0] counts durations under 1us, buckets[i] counts durations in [2^(i-1), 2^i) us, and the last
+            // bucket also counts anything longer
+            std::array<std::uint64_t, 32> buckets{};
+        };
+
+        struct cache_statistics {
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+            std::uint64_t evictions = 0;
+            // entries currently held
+            std::uint64_t entries = 0;
+        };
+
+        struct backend_statistics {
+            // "libdwarf", "dbghelp", "addr2line", "libdl", "libbacktrace", "nothing", or "remote"
+            std::string name;
+            std::uint64_t frames = 0;
+            latency_histogram resolution_time;
+        };
+
+        struct statistics {
+            // traces captured by the unwinder, not counting signal-safe traces
+            std::uint64_t captures = 0;
+            std::uint64_t frames_captured = 0;
+            latency_histogram unwinding_time;
+            // only back-ends that have been used
+            std::vector<backend_statistics> backends;
+            // per-object symbol resolvers, i.e. libdwarf resolvers or addr2line processes
+            cache_statistics resolver_cache;
+            // parsed elf and mach-o files
+            cache_statistics object_cache;
+            cache_statistics line_table_cache;
+            cache_statistics subprogram_cache;
+            cache_statistics snippet_cache;
+            // bytes read from object files by cpptrace itself, reads done within libdwarf aren't included
+            std::uint64_t object_bytes_read = 0;
+        };
+
+        // Counters are process-wide and updated with relaxed atomics, a snapshot isn't necessarily consistent across
+        // counters while other threads are tracing
+        CPPTRACE_EXPORT statistics get_statistics();
+        CPPTRACE_EXPORT void reset_statistics();
+    }
+
+    // capture sampling
+    namespace experimental {
+        enum class capture_mode {
+            always,
+            // capture one in every n traces
+            one_in_n,
+            // token bucket refilled at per_second captures per second, holding at most burst captures
+            rate_limited,
+            // at most per_site captures for each throw site per window
+            per_throw_site
+        };
+
+        struct CPPTRACE_EXPORT capture_policy {
+            capture_mode mode = capture_mode::always;
+            std::uint64_t n = 1;
+            double per_second = 0;
+            std::uint64_t burst = 1;
+            std::uint64_t per_site = 1;
+            std::chrono::milliseconds window{1000};
+
+            static capture_policy always();
+            static capture_policy one_in(std::uint64_t n);
+            static capture_policy rate_limited(double per_second, std::uint64_t burst = 1);
+            static capture_policy per_throw_site(std::uint64_t per_site, std::chrono::milliseconds window);
+        };
+
+        // Governs traces captured for traced exception objects and CPPTRACE_TRY/CPPTRACE_CATCH, other traces are
+        // always captured. Skipped captures leave an empty trace which is flagged as sampled out.
+        CPPTRACE_EXPORT void set_capture_policy(const capture_policy& policy);
+    }
+
     // dbghelp
     #ifdef _WIN32
      CPPTRACE_EXPORT void load_symbols_for_file(const std::string& filename);
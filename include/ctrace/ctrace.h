@@ -109,6 +109,36 @@ CTRACE_BEGIN_DEFINITIONS
         size_t count;
     };
 
+    /* Owning buffer of binary data */
+    typedef struct {
+        char* data;
+        size_t size;
+    } ctrace_buffer;
+
+    /* See cpptrace::experimental::trace_encoder and trace_decoder. */
+    typedef struct ctrace_trace_encoder ctrace_trace_encoder;
+    typedef struct ctrace_trace_decoder ctrace_trace_decoder;
+
+    typedef enum {
+        ctrace_decoded_raw_trace = 0,
+        ctrace_decoded_object_trace = 1,
+        ctrace_decoded_stacktrace = 2
+    } ctrace_decoded_trace_type;
+
+    /* Only the trace indicated by `type` is populated */
+    typedef struct {
+        ctrace_decoded_trace_type type;
+        ctrace_raw_trace raw_trace;
+        ctrace_object_trace object_trace;
+        ctrace_stacktrace stacktrace;
+    } ctrace_decoded_trace;
+
+    typedef enum {
+        ctrace_decode_ok = 0,
+        ctrace_decode_need_more_input = 1,
+        ctrace_decode_error = 2
+    } ctrace_decode_status;
+
     /* ctrace::string: */
     CPPTRACE_EXPORT ctrace_owning_string ctrace_generate_owning_string(const char* raw_string);
     CPPTRACE_EXPORT void ctrace_free_owning_string(ctrace_owning_string* string);
@@ -138,6 +168,24 @@ CTRACE_BEGIN_DEFINITIONS
     CPPTRACE_EXPORT ctrace_owning_string ctrace_stacktrace_to_string(const ctrace_stacktrace* trace, ctrace_bool use_color);
     CPPTRACE_EXPORT void ctrace_print_stacktrace(const ctrace_stacktrace* trace, FILE* to, ctrace_bool use_color);
 
+    /* ctrace::serialization: */
+    CPPTRACE_EXPORT ctrace_trace_encoder* ctrace_create_trace_encoder(ctrace_bool intern_symbols);
+    CPPTRACE_EXPORT void ctrace_free_trace_encoder(ctrace_trace_encoder* encoder);
+    CPPTRACE_EXPORT void ctrace_encode_raw_trace(ctrace_trace_encoder* encoder, const ctrace_raw_trace* trace);
+    CPPTRACE_EXPORT void ctrace_encode_object_trace(ctrace_trace_encoder* encoder, const ctrace_object_trace* trace);
+    CPPTRACE_EXPORT void ctrace_encode_stacktrace(ctrace_trace_encoder* encoder, const ctrace_stacktrace* trace);
+    /* Takes the output encoded so far, the buffer must be freed with ctrace_free_buffer */
+    CPPTRACE_EXPORT ctrace_buffer ctrace_take_encoded_data(ctrace_trace_encoder* encoder);
+    CPPTRACE_EXPORT void ctrace_reset_trace_encoder(ctrace_trace_encoder* encoder);
+    CPPTRACE_EXPORT void ctrace_free_buffer(ctrace_buffer* buffer);
+
+    CPPTRACE_EXPORT ctrace_trace_decoder* ctrace_create_trace_decoder(void);
+    CPPTRACE_EXPORT void ctrace_free_trace_decoder(ctrace_trace_decoder* decoder);
+    CPPTRACE_EXPORT void ctrace_feed_trace_decoder(ctrace_trace_decoder* decoder, const char* data, size_t size);
+    /* On ctrace_decode_ok the decoded trace must be freed with ctrace_free_decoded_trace */
+    CPPTRACE_EXPORT ctrace_decode_status ctrace_decode_next_trace(ctrace_trace_decoder* decoder, ctrace_decoded_trace* out);
+    CPPTRACE_EXPORT void ctrace_free_decoded_trace(ctrace_decoded_trace* trace);
+
     /* ctrace::utility: */
     CPPTRACE_EXPORT ctrace_owning_string ctrace_demangle(const char* mangled);
     CPPTRACE_EXPORT int ctrace_stdin_fileno(void);
@@ -0,0 +1,265 @@
+#include "async_resolution.hpp"
+
+#include <cpptrace/resolution.hpp>
+
+#include "batch_resolution.hpp"
+#include "utils/error.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    std::atomic<nullable<std::size_t>> exception_resolution_timeout{nullable<std::size_t>::null()};
+
+    optional<std::chrono::milliseconds> get_exception_resolution_timeout() {
+        auto timeout = exception_resolution_timeout.load();
+        if(!timeout.has_value()) {
+            return nullopt;
+        }
+        return std::chrono::milliseconds(timeout.value());
+    }
+
+    struct async_request {
+        // exactly one of these is used
+        bool is_object_trace;
+        raw_trace raw;
+        object_trace object;
+        std::promise<stacktrace> promise;
+
+        stacktrace resolve(resolution_level level) const {
+            return is_object_trace ? object.resolve(level) : raw.resolve(level);
+        }
+    };
+
+    void ensure_exit_guard();
+
+    void resolve_individually(async_request& request, resolution_level level) {
+        try {
+            auto trace = request.resolve(level);
+            ensure_exit_guard();
+            request.promise.set_value(std::move(trace));
+        } catch(...) {
+            request.promise.set_exception(std::current_exception());
+        }
+    }
+
+    void resolve_batch(std::vector<async_request*>& requests) {
+        if(requests.empty()) {
+            return;
+        }
+        optional<std::vector<stacktrace>> traces;
+        try {
+            if(requests[0]->is_object_trace) {
+                std::vector<const object_trace*> object_traces;
+                for(const auto request : requests) {
+                    object_traces.push_back(&request->object);
+                }
+                traces = resolve_object_batch(object_traces, resolution_level::full_with_inlines);
+            } else {
+                std::vector<const raw_trace*> raw_traces;
+                for(const auto request : requests) {
+                    raw_traces.push_back(&request->raw);
+                }
+                traces = resolve_raw_batch(raw_traces, resolution_level::full_with_inlines);
+            }
+        } catch(...) {
+            // resolving one by one either absorbs the exception or propagates it to each future
+            traces.reset();
+        }
+        if(!traces) {
+            for(auto request : requests) {
+                resolve_individually(*request, resolution_level::full_with_inlines);
+            }
+            return;
+        }
+        ensure_exit_guard();
+        for(std::size_t i = 0; i < requests.size(); i++) {
+            requests[i]->promise.set_value(std::move(traces.unwrap()[i]));
+        }
+    }
+
+    class async_resolver {
+        std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+        std::condition_variable idle;
+        std::deque<async_request> queue;
+        experimental::async_resolver_options options;
+        // threads currently running, they exit when there are more than options.threads
+        std::size_t workers = 0;
+        // workers in the middle of resolving a batch
+        std::size_t active = 0;
+        bool stopping = false;
+
+    public:
+        // The resolver threads are detached, at exit they must not be part way through a resolution while the statics
+        // the back-ends rely on are destroyed. This is constructed once a resolution has finished, after those statics,
+        // so its destructor runs before theirs. It's constructed before any future is fulfilled so a caller can't get
+        // to exit first.
+        struct exit_guard {
+            ~exit_guard() {
+                async_resolver::get().stop();
+            }
+        };
+
+        // never destroyed, the resolver threads are detached and may still be waiting for work at exit
+        static async_resolver& get() {
+            static async_resolver* instance = new async_resolver;
+            return *instance;
+        }
+
+        void configure(const experimental::async_resolver_options& new_options) {
+            std::unique_lock<std::mutex> lock(mutex);
+            options = new_options;
+            if(options.threads == 0) {
+                options.threads = 1;
+            }
+            if(options.max_queued == 0) {
+                options.max_queued = 1;
+            }
+            if(options.max_batch == 0) {
+                options.max_batch = 1;
+            }
+            start_workers();
+            // wake surplus workers so they exit, and anyone waiting on a queue which may now be larger
+            not_empty.notify_all();
+            not_full.notify_all();
+        }
+
+        std::future<stacktrace> submit(async_request request, bool may_block) {
+            auto future = request.promise.get_future();
+            std::unique_lock<std::mutex> lock(mutex);
+            if(stopping) {
+                lock.unlock();
+                resolve_individually(request, resolution_level::full_with_inlines);
+                return future;
+            }
+            if(queue.size() >= options.max_queued) {
+                if(!may_block || options.when_full == experimental::full_queue_policy::address_only) {
+                    lock.unlock();
+                    resolve_individually(request, resolution_level::address_only);
+                    return future;
+                }
+                not_full.wait(lock, [this] { return stopping || queue.size() < options.max_queued; });
+                if(stopping) {
+                    lock.unlock();
+                    resolve_individually(request, resolution_level::full_with_inlines);
+                    return future;
+                }
+            }
+            start_workers();
+            queue.push_back(std::move(request));
+            lock.unlock();
+            not_empty.notify_one();
+            return future;
+        }
+
+    private:
+        // Waits for batches in progress and workers stop taking new ones. Traces still queued only get object
+        // information, nothing would fulfil their futures otherwise and anyone waiting on one at exit would hang.
+        void stop() {
+            std::deque<async_request> remaining;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                stopping = true;
+                remaining.swap(queue);
+                not_full.notify_all();
+                idle.wait(lock, [this] { return active == 0; });
+            }
+            for(auto& request : remaining) {
+                resolve_individually(request, resolution_level::address_only);
+            }
+        }
+
+        // relies on the caller to lock
+        void start_workers() {
+            while(workers < options.threads) {
+                std::thread(&async_resolver::worker, this).detach();
+                workers++;
+            }
+        }
+
+        void worker() {
+            std::vector<async_request> batch;
+            std::vector<async_request*> raw_requests;
+            std::vector<async_request*> object_requests;
+            while(true) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    not_empty.wait(lock, [this] { return !queue.empty() || workers > options.threads; });
+                    if(stopping || workers > options.threads) {
+                        workers--;
+                        return;
+                    }
+                    while(!queue.empty() && batch.size() < options.max_batch) {
+                        batch.push_back(std::move(queue.front()));
+                        queue.pop_front();
+                    }
+                    active++;
+                }
+                not_full.notify_all();
+                for(auto& request : batch) {
+                    (request.is_object_trace ? object_requests : raw_requests).push_back(&request);
+                }
+                resolve_batch(raw_requests);
+                resolve_batch(object_requests);
+                raw_requests.clear();
+                object_requests.clear();
+                batch.clear();
+                std::lock_guard<std::mutex> lock(mutex);
+                if(--active == 0) {
+                    idle.notify_all();
+                }
+            }
+        }
+    };
+
+    void ensure_exit_guard() {
+        static async_resolver::exit_guard guard;
+        (void)guard;
+    }
+
+    async_request make_request(raw_trace&& trace) {
+        return async_request{false, std::move(trace), object_trace{}, std::promise<stacktrace>{}};
+    }
+
+    async_request make_request(object_trace&& trace) {
+        return async_request{true, raw_trace{}, std::move(trace), std::promise<stacktrace>{}};
+    }
+
+    stacktrace resolve_with_timeout(const raw_trace& trace, std::chrono::milliseconds timeout) {
+        auto future = async_resolver::get().submit(make_request(raw_trace(trace)), false);
+        if(future.wait_for(timeout) != std::future_status::ready) {
+            return trace.resolve(resolution_level::address_only);
+        }
+        return future.get();
+    }
+}
+
+namespace experimental {
+    std::future<stacktrace> resolve_async(raw_trace trace) {
+        return detail::async_resolver::get().submit(detail::make_request(std::move(trace)), true);
+    }
+
+    std::future<stacktrace> resolve_async(object_trace trace) {
+        return detail::async_resolver::get().submit(detail::make_request(std::move(trace)), true);
+    }
+
+    void configure_async_resolver(const async_resolver_options& options) {
+        detail::async_resolver::get().configure(options);
+    }
+
+    void set_exception_resolution_timeout(nullable<std::size_t> milliseconds) {
+        detail::exception_resolution_timeout.store(milliseconds);
+    }
+}
+CPPTRACE_END_NAMESPACE
@@ -0,0 +1,20 @@
+#ifndef ASYNC_RESOLUTION_HPP
+#define ASYNC_RESOLUTION_HPP
+
+#include <cpptrace/basic.hpp>
+
+#include "utils/optional.hpp"
+
+#include <chrono>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // see experimental::set_exception_resolution_timeout
+    optional<std::chrono::milliseconds> get_exception_resolution_timeout();
+    // Resolves through the async resolver without ever blocking on a full queue, falls back to address_only
+    // resolution if the trace can't be resolved within the timeout
+    stacktrace resolve_with_timeout(const raw_trace& trace, std::chrono::milliseconds timeout);
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
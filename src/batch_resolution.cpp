@@ -0,0 +1,152 @@
+#include "batch_resolution.hpp"
+
+#include <cpptrace/resolution.hpp>
+
+#include "demangle/demangle.hpp"
+#include "symbols/symbols.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    optional<std::vector<std::size_t>> group_by_address(
+        const std::vector<stacktrace_frame>& frames,
+        std::size_t address_count
+    ) {
+        std::vector<std::size_t> starts;
+        starts.reserve(address_count + 1);
+        starts.push_back(0);
+        for(std::size_t i = 0; i < frames.size(); i++) {
+            if(!frames[i].is_inline) {
+                starts.push_back(i + 1);
+            }
+        }
+        if(starts.size() != address_count + 1 || starts.back() != frames.size()) {
+            return nullopt;
+        }
+        return starts;
+    }
+
+    optional<std::vector<stacktrace>> resolve_raw_batch(
+        const std::vector<const raw_trace*>& traces,
+        resolution_level level
+    ) {
+        std::vector<frame_ptr> addresses;
+        std::unordered_map<frame_ptr, std::size_t> address_indices;
+        for(const auto trace : traces) {
+            for(const auto address : trace->frames) {
+                if(address_indices.emplace(address, addresses.size()).second) {
+                    addresses.push_back(address);
+                }
+            }
+        }
+        auto resolved = resolve_frames(addresses, level);
+        auto starts = group_by_address(resolved, addresses.size());
+        if(!starts) {
+            return nullopt;
+        }
+        demangle_frames(resolved);
+        std::vector<stacktrace> results;
+        results.reserve(traces.size());
+        for(const auto trace : traces) {
+            stacktrace result;
+            for(const auto address : trace->frames) {
+                auto index = address_indices.at(address);
+                result.frames.insert(
+                    result.frames.end(),
+                    resolved.begin() + starts.unwrap()[index],
+                    resolved.begin() + starts.unwrap()[index + 1]
+                );
+            }
+            results.push_back(std::move(result));
+        }
+        return results;
+    }
+
+    // Frames in JIT code or unknown mappings all have an empty object path and an object address of 0, they can only be
+    // told apart (and are resolved) by their raw address
+    frame_ptr frame_key(const object_frame& frame) {
+        return frame.object_path.empty() ? frame.raw_address : frame.object_address;
+    }
+
+    optional<std::vector<stacktrace>> resolve_object_batch(
+        const std::vector<const object_trace*>& traces,
+        resolution_level level
+    ) {
+        std::vector<object_frame> frames;
+        std::unordered_map<std::string, std::unordered_map<frame_ptr, std::size_t>> frame_indices;
+        for(const auto trace : traces) {
+            for(const auto& frame : trace->frames) {
+                if(frame_indices[frame.object_path].emplace(frame_key(frame), frames.size()).second) {
+                    frames.push_back(frame);
+                }
+            }
+        }
+        auto resolved = resolve_frames(frames, level);
+        auto starts = group_by_address(resolved, frames.size());
+        if(!starts) {
+            return nullopt;
+        }
+        demangle_frames(resolved);
+        std::vector<stacktrace> results;
+        results.reserve(traces.size());
+        for(const auto trace : traces) {
+            stacktrace result;
+            for(const auto& frame : trace->frames) {
+                auto index = frame_indices.at(frame.object_path).at(frame_key(frame));
+                auto begin = result.frames.size();
+                result.frames.insert(
+                    result.frames.end(),
+                    resolved.begin() + starts.unwrap()[index],
+                    resolved.begin() + starts.unwrap()[index + 1]
+                );
+                // the shared frame may have come from a trace with a different raw address for the same object frame
+                for(auto i = begin; i < result.frames.size(); i++) {
+                    result.frames[i].raw_address = frame.raw_address;
+                }
+            }
+            results.push_back(std::move(result));
+        }
+        return results;
+    }
+
+    template<typename T, typename F>
+    std::vector<stacktrace> resolve_many(const std::vector<T>& traces, resolution_level level, F resolve_batch) {
+        std::vector<const T*> pointers;
+        pointers.reserve(traces.size());
+        for(const auto& trace : traces) {
+            pointers.push_back(&trace);
+        }
+        optional<std::vector<stacktrace>> results;
+        try {
+            results = resolve_batch(pointers, level);
+        } catch(...) { // NOSONAR
+            // resolving one by one either absorbs the exception or propagates it
+            results.reset();
+        }
+        if(results) {
+            return std::move(results).unwrap();
+        }
+        std::vector<stacktrace> fallback;
+        fallback.reserve(traces.size());
+        for(const auto& trace : traces) {
+            fallback.push_back(trace.resolve(level));
+        }
+        return fallback;
+    }
+}
+
+namespace experimental {
+    std::vector<stacktrace> resolve_many(const std::vector<raw_trace>& traces, resolution_level level) {
+        return detail::resolve_many(traces, level, detail::resolve_raw_batch);
+    }
+
+    std::vector<stacktrace> resolve_many(const std::vector<object_trace>& traces, resolution_level level) {
+        return detail::resolve_many(traces, level, detail::resolve_object_batch);
+    }
+}
+CPPTRACE_END_NAMESPACE
@@ -0,0 +1,35 @@
+#ifndef BATCH_RESOLUTION_HPP
+#define BATCH_RESOLUTION_HPP
+
+#include <cpptrace/basic.hpp>
+
+#include "utils/optional.hpp"
+
+#include <cstddef>
+#include <vector>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // Each address resolves to its inlined frames, if any, followed by one non-inlined frame. Returns where each
+    // address's frames start plus an end marker, or nullopt if the frames don't line up with the addresses.
+    optional<std::vector<std::size_t>> group_by_address(
+        const std::vector<stacktrace_frame>& frames,
+        std::size_t address_count
+    );
+
+    // Resolves many traces together, every unique address is resolved and demangled once. Returns nullopt if the
+    // back-end's output can't be split back up per address, in which case the traces need to be resolved one by one.
+    optional<std::vector<stacktrace>> resolve_raw_batch(
+        const std::vector<const raw_trace*>& traces,
+        resolution_level level
+    );
+    // As above, object frames are the same if they have the same object path and object address, or the same raw
+    // address if they have no object path
+    optional<std::vector<stacktrace>> resolve_object_batch(
+        const std::vector<const object_trace*>& traces,
+        resolution_level level
+    );
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
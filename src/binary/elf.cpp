@@ -6,6 +6,7 @@
 #include "utils/optional.hpp"
 #include "utils/io/file.hpp"
 #include "utils/string_view.hpp"
+#include "statistics.hpp"
 
 #if IS_LINUX
 
@@ -176,6 +177,42 @@ namespace detail {
         return vec;
     }
 
+    Result<std::vector<elf::section_header>, internal_error> elf::get_section_headers() {
+        auto header_info_ = get_header_info();
+        if(header_info_.is_error()) {
+            return header_info_.unwrap_error();
+        }
+        auto& header_info = header_info_.unwrap_value();
+        auto strtab_ = get_strtab(header_info.e_shstrndx);
+        if(strtab_.is_error()) {
+            return strtab_.unwrap_error();
+        }
+        auto& strtab = strtab_.unwrap_value();
+        auto sections_res = get_sections();
+        if(!sections_res) {
+            return sections_res.unwrap_error();
+        }
+        std::vector<section_header> headers;
+        for(const auto& section : sections_res.unwrap_value()) {
+            if(section.sh_name >= strtab.size()) {
+                return internal_error("elf seems corrupted, section name out of range {}", file->path());
+            }
+            headers.push_back({
+                strtab.data() + section.sh_name,
+                section.sh_type,
+                section.sh_flags,
+                section.sh_addr,
+                section.sh_offset,
+                section.sh_size,
+                section.sh_link,
+                section.sh_info,
+                section.sh_addralign,
+                section.sh_entsize
+            });
+        }
+        return headers;
+    }
+
     Result<optional<std::vector<elf::symbol_entry>>, internal_error> elf::get_symtab_entries() {
         return resolve_symtab_entries(get_symtab());
     }
@@ -294,11 +331,14 @@ namespace detail {
             section_info info;
             info.sh_name = byteswap_if_needed(section_header.sh_name);
             info.sh_type = byteswap_if_needed(section_header.sh_type);
+            info.sh_flags = byteswap_if_needed(section_header.sh_flags);
             info.sh_addr = byteswap_if_needed(section_header.sh_addr);
             info.sh_offset = byteswap_if_needed(section_header.sh_offset);
             info.sh_size = byteswap_if_needed(section_header.sh_size);
             info.sh_entsize = byteswap_if_needed(section_header.sh_entsize);
             info.sh_link = byteswap_if_needed(section_header.sh_link);
+            info.sh_info = byteswap_if_needed(section_header.sh_info);
+            info.sh_addralign = byteswap_if_needed(section_header.sh_addralign);
             sections.push_back(info);
         }
         did_load_sections = true;
@@ -466,6 +506,7 @@ namespace detail {
             return internal_error{"empty object_path"};
         }
         if(get_cache_mode() == cache_mode::prioritize_memory) {
+            stats::record_cache_miss(stats::cache::object);
             return elf::open(object_path)
                 .transform([](elf&& obj) { return maybe_owned<elf>{detail::make_unique<elf>(std::move(obj))}; });
         } else {
@@ -475,9 +516,12 @@ namespace detail {
             static std::unordered_map<std::string, Result<elf, internal_error>> cache;
             auto it = cache.find(object_path);
             if(it == cache.end()) {
+                stats::record_cache_insertion(stats::cache::object);
                 auto res = cache.emplace(object_path, elf::open(object_path));
                 VERIFY(res.second);
                 it = res.first;
+            } else {
+                stats::record_cache_hit(stats::cache::object);
             }
             return it->second.transform([](elf& obj) { return maybe_owned<elf>(&obj); });
         }
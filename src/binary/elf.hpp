@@ -36,11 +36,14 @@ namespace detail {
         struct section_info {
             uint32_t sh_name;
             uint32_t sh_type;
+            uint64_t sh_flags;
             uint64_t sh_addr;
             uint64_t sh_offset;
             uint64_t sh_size;
             uint64_t sh_entsize;
             uint32_t sh_link;
+            uint32_t sh_info;
+            uint64_t sh_addralign;
         };
         bool tried_to_load_sections = false;
         bool did_load_sections = false;
@@ -102,6 +105,27 @@ namespace detail {
         // for in-memory JIT elves
         Result<std::vector<pc_range>, internal_error> get_pc_ranges();
 
+        // also for in-memory JIT elves, used to hand the object to libdwarf
+        struct section_header {
+            std::string name;
+            uint32_t type;
+            uint64_t flags;
+            uint64_t addr;
+            uint64_t offset;
+            uint64_t size;
+            uint32_t link;
+            uint32_t info;
+            uint64_t addralign;
+            uint64_t entsize;
+        };
+        Result<std::vector<section_header>, internal_error> get_section_headers();
+        bool object_is_little_endian() const {
+            return is_little_endian;
+        }
+        bool object_is_64_bit() const {
+            return is_64;
+        }
+
         struct symbol_entry {
             std::string st_name;
             uint16_t st_shndx;
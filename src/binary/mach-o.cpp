@@ -4,6 +4,7 @@
 #include "utils/utils.hpp"
 #include "utils/io/file.hpp"
 #include "utils/io/memory_file_view.hpp"
+#include "statistics.hpp"
 
 #if IS_APPLE
 
@@ -704,6 +705,7 @@ namespace detail {
             return internal_error{"empty object_path"};
         }
         if(get_cache_mode() == cache_mode::prioritize_memory) {
+            stats::record_cache_miss(stats::cache::object);
             return mach_o::open(object_path)
                 .transform([](mach_o&& obj) {
                     return maybe_owned<mach_o>{detail::make_unique<mach_o>(std::move(obj))};
@@ -715,9 +717,12 @@ namespace detail {
             static std::unordered_map<std::string, Result<mach_o, internal_error>> cache;
             auto it = cache.find(object_path);
             if(it == cache.end()) {
+                stats::record_cache_insertion(stats::cache::object);
                 auto res = cache.insert({ object_path, mach_o::open(object_path) });
                 VERIFY(res.second);
                 it = res.first;
+            } else {
+                stats::record_cache_hit(stats::cache::object);
             }
             return it->second.transform([](mach_o& obj) { return maybe_owned<mach_o>(&obj); });
         }
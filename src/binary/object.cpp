@@ -1,6 +1,7 @@
 #include "binary/object.hpp"
 
 #include "platform/platform.hpp"
+#include "platform/probes.hpp"
 #include "utils/utils.hpp"
 #include "binary/module_base.hpp"
 #include "logging.hpp"
@@ -166,7 +167,9 @@ namespace detail {
         std::vector<object_frame> frames;
         frames.reserve(addresses.size());
         for(const frame_ptr address : addresses) {
+            probe_timer timer;
             frames.push_back(get_frame_object_info(address));
+            CPPTRACE_PROBE3(object__info, address, frames.back().object_path.c_str(), timer.elapsed_ns());
         }
         return frames;
     }
@@ -0,0 +1,261 @@
+#include "capture_policy.hpp"
+
+#include <cpptrace/utils.hpp>
+
+#include "platform/platform.hpp"
+#include "statistics.hpp"
+#include "unwind/unwind.hpp"
+#include "utils/optional.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if IS_LINUX || IS_APPLE
+ #include <dlfcn.h>
+#endif
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // The policy's parameters are individually atomic, a capture racing with set_capture_policy may briefly see a mix
+    // of old and new parameters which is harmless. Everything is relaxed, nothing else is ordered by these.
+    std::atomic<experimental::capture_mode> current_capture_mode(experimental::capture_mode::always); // NOSONAR
+    std::atomic<std::uint64_t> capture_every_n(1); // NOSONAR
+    std::atomic<std::int64_t> capture_interval_ns(0); // NOSONAR
+    std::atomic<std::int64_t> capture_tolerance_ns(0); // NOSONAR
+    std::atomic<std::uint64_t> captures_per_site(1); // NOSONAR
+    std::atomic<std::int64_t> site_window_ns(1); // NOSONAR
+
+    std::atomic<std::uint64_t> capture_counter(0); // NOSONAR
+    // Rate limiting uses the generic cell rate algorithm, which is a token bucket expressed as a single timestamp: each
+    // capture pushes the theoretical arrival time forward by one interval and a capture is allowed as long as that
+    // time isn't more than burst - 1 intervals ahead of now.
+    std::atomic<std::int64_t> theoretical_arrival_time(0); // NOSONAR
+
+    // Throw sites are tracked in a fixed-size table rather than a map so that the hot path never allocates or locks.
+    // Sites which collide replace each other, which can only let extra captures through.
+    struct site_slot {
+        std::atomic<frame_ptr> site{0};
+        // window number in the high 32 bits, captures in that window in the low 32 bits
+        std::atomic<std::uint64_t> state{0};
+    };
+    constexpr std::size_t site_slot_count = 1024;
+    site_slot site_slots[site_slot_count]; // NOSONAR
+
+    std::int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+    bool take_rate_limited_capture() {
+        const auto interval = capture_interval_ns.load(std::memory_order_relaxed);
+        if(interval <= 0) {
+            return false;
+        }
+        const auto tolerance = capture_tolerance_ns.load(std::memory_order_relaxed);
+        const auto now = now_ns();
+        auto tat = theoretical_arrival_time.load(std::memory_order_relaxed);
+        std::int64_t next;
+        do {
+            const auto start = std::max(tat, now);
+            if(start - now > tolerance) {
+                return false;
+            }
+            next = start + interval;
+        } while(!theoretical_arrival_time.compare_exchange_weak(tat, next, std::memory_order_relaxed));
+        return true;
+    }
+
+    bool take_site_capture(frame_ptr site) {
+        const auto limit = captures_per_site.load(std::memory_order_relaxed);
+        if(limit == 0) {
+            return false;
+        }
+        // + 1 so that a cleared slot never matches the current window
+        const std::uint64_t window = static_cast<std::uint32_t>(
+            now_ns() / site_window_ns.load(std::memory_order_relaxed)
+        ) + 1ULL;
+        auto& slot = site_slots[((site >> 4) ^ (site >> 14)) % site_slot_count];
+        if(slot.site.load(std::memory_order_relaxed) != site) {
+            slot.site.store(site, std::memory_order_relaxed);
+            slot.state.store(window << 32 | 1, std::memory_order_relaxed);
+            return true;
+        }
+        auto state = slot.state.load(std::memory_order_relaxed);
+        std::uint64_t next;
+        do {
+            if(state >> 32 == (window & 0xffffffff)) {
+                if((state & 0xffffffff) >= limit) {
+                    return false;
+                }
+                next = state + 1;
+            } else {
+                next = window << 32 | 1;
+            }
+        } while(!slot.state.compare_exchange_weak(state, next, std::memory_order_relaxed));
+        return true;
+    }
+
+    // CPPTRACE_TRY collects traces from inside the unwinder during the search phase, the frames there are the same for
+    // every throw. The throw site is the first frame past __cxa_throw (or __cxa_rethrow), the exception machinery
+    // between it and the interceptor is usually less than a dozen frames.
+    constexpr std::size_t max_unwinder_depth = 32;
+
+    #if IS_LINUX || IS_APPLE
+    // Return addresses inside __cxa_throw and __cxa_rethrow which have been seen before, so that dladdr is only needed
+    // the first time through each of them
+    std::atomic<frame_ptr> known_throw_returns[4]; // NOSONAR
+
+    bool is_in_throw_function(frame_ptr address) {
+        static const void* const throw_functions[] = {
+            dlsym(RTLD_DEFAULT, "__cxa_throw"),
+            dlsym(RTLD_DEFAULT, "__cxa_rethrow")
+        };
+        Dl_info info;
+        if(!dladdr(reinterpret_cast<void*>(address), &info) || info.dli_saddr == nullptr) {
+            return false;
+        }
+        for(const auto function : throw_functions) {
+            if(function != nullptr && function == info.dli_saddr) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    optional<std::size_t> find_throw_function(const std::vector<frame_ptr>& frames) {
+        for(std::size_t i = 0; i < frames.size(); i++) {
+            for(const auto& known : known_throw_returns) {
+                if(known.load(std::memory_order_relaxed) == frames[i]) {
+                    return i;
+                }
+            }
+        }
+        for(std::size_t i = 0; i < frames.size(); i++) {
+            if(is_in_throw_function(frames[i])) {
+                for(auto& known : known_throw_returns) {
+                    frame_ptr expected = 0;
+                    if(
+                        known.compare_exchange_strong(expected, frames[i], std::memory_order_relaxed)
+                        || expected == frames[i]
+                    ) {
+                        break;
+                    }
+                }
+                return i;
+            }
+        }
+        return nullopt;
+    }
+    #else
+    optional<std::size_t> find_throw_function(const std::vector<frame_ptr>&) {
+        return nullopt;
+    }
+    #endif
+
+    frame_ptr find_throw_site(std::size_t skip, bool in_unwinder) {
+        // site lookups don't count as captures in the statistics
+        stats::unrecorded_captures unrecorded;
+        if(!in_unwinder) {
+            auto frames = capture_frames(skip + 1, 1);
+            return frames.empty() ? 0 : frames[0];
+        }
+        auto frames = capture_frames(skip + 1, max_unwinder_depth);
+        auto index = find_throw_function(frames);
+        if(index && index.unwrap() + 1 < frames.size()) {
+            return frames[index.unwrap() + 1];
+        }
+        // the runtime's symbols aren't visible, e.g. with a statically linked runtime, so all throws through the
+        // interceptor share a site
+        return frames.empty() ? 0 : frames[0];
+    }
+
+    CPPTRACE_FORCE_NO_INLINE
+    bool should_capture(std::size_t skip, bool in_unwinder) {
+        switch(current_capture_mode.load(std::memory_order_relaxed)) {
+            case experimental::capture_mode::always:
+                return true;
+            case experimental::capture_mode::one_in_n:
+                {
+                    const auto n = capture_every_n.load(std::memory_order_relaxed);
+                    return n != 0 && capture_counter.fetch_add(1, std::memory_order_relaxed) % n == 0;
+                }
+            case experimental::capture_mode::rate_limited:
+                return take_rate_limited_capture();
+            case experimental::capture_mode::per_throw_site:
+                return take_site_capture(find_throw_site(skip + 1, in_unwinder));
+        }
+        return true;
+    }
+}
+
+namespace experimental {
+    capture_policy capture_policy::always() {
+        return capture_policy{};
+    }
+
+    capture_policy capture_policy::one_in(std::uint64_t n_) {
+        capture_policy policy;
+        policy.mode = capture_mode::one_in_n;
+        policy.n = n_;
+        return policy;
+    }
+
+    capture_policy capture_policy::rate_limited(double per_second_, std::uint64_t burst_) {
+        capture_policy policy;
+        policy.mode = capture_mode::rate_limited;
+        policy.per_second = per_second_;
+        policy.burst = burst_;
+        return policy;
+    }
+
+    capture_policy capture_policy::per_throw_site(std::uint64_t per_site_, std::chrono::milliseconds window_) {
+        capture_policy policy;
+        policy.mode = capture_mode::per_throw_site;
+        policy.per_site = per_site_;
+        policy.window = window_;
+        return policy;
+    }
+
+    void set_capture_policy(const capture_policy& policy) {
+        // disable sampling while the parameters and state are replaced
+        detail::current_capture_mode.store(capture_mode::always, std::memory_order_relaxed);
+        detail::capture_every_n.store(policy.n, std::memory_order_relaxed);
+        // the interval and tolerance are bounded so that now + tolerance + interval can't overflow
+        constexpr std::int64_t max_duration = std::numeric_limits<std::int64_t>::max() / 4;
+        std::int64_t interval = 0;
+        if(policy.per_second > 0) {
+            const double ns = 1e9 / policy.per_second;
+            if(ns >= static_cast<double>(max_duration)) {
+                interval = max_duration;
+            } else {
+                interval = std::max(static_cast<std::int64_t>(ns), std::int64_t(1));
+            }
+        }
+        std::int64_t tolerance = 0;
+        if(interval > 0 && policy.burst > 1) {
+            const auto max_extra = static_cast<std::uint64_t>(max_duration / interval);
+            tolerance = interval * static_cast<std::int64_t>(std::min(policy.burst - 1, max_extra));
+        }
+        detail::capture_interval_ns.store(interval, std::memory_order_relaxed);
+        detail::capture_tolerance_ns.store(tolerance, std::memory_order_relaxed);
+        // the per-window count is kept in 32 bits
+        const auto per_site = std::min(policy.per_site, std::uint64_t(0xffffffff));
+        detail::captures_per_site.store(per_site, std::memory_order_relaxed);
+        const auto window = std::chrono::duration_cast<std::chrono::nanoseconds>(policy.window).count();
+        detail::site_window_ns.store(window > 0 ? window : 1, std::memory_order_relaxed);
+        detail::capture_counter.store(0, std::memory_order_relaxed);
+        detail::theoretical_arrival_time.store(0, std::memory_order_relaxed);
+        for(auto& slot : detail::site_slots) {
+            slot.site.store(0, std::memory_order_relaxed);
+            slot.state.store(0, std::memory_order_relaxed);
+        }
+        detail::current_capture_mode.store(policy.mode, std::memory_order_relaxed);
+    }
+}
+CPPTRACE_END_NAMESPACE
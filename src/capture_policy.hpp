@@ -0,0 +1,18 @@
+#ifndef CAPTURE_POLICY_HPP
+#define CAPTURE_POLICY_HPP
+
+#include <cpptrace/basic.hpp>
+
+#include <cstddef>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // Whether a trace for a traced exception or CPPTRACE_TRY should be captured under the current capture policy. skip
+    // is as for generate_raw_trace, only per_throw_site policies unwind to find the throw site. That's a single frame
+    // unless in_unwinder is set, for CPPTRACE_TRY, in which case the site is found past the exception machinery.
+    CPPTRACE_FORCE_NO_INLINE
+    bool should_capture(std::size_t skip, bool in_unwinder = false);
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
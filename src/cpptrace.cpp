@@ -18,6 +18,7 @@
 #include "unwind/unwind.hpp"
 #include "demangle/demangle.hpp"
 #include "utils/common.hpp"
+#include "utils/fd_writer.hpp"
 #include "utils/microfmt.hpp"
 #include "utils/utils.hpp"
 #include "binary/object.hpp"
@@ -26,6 +27,56 @@
 #include "options.hpp"
 
 CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    void demangle_frames(std::vector<stacktrace_frame>& frames) {
+        // with lazy demangling this is left to the formatter, which only demangles frames it actually prints
+        if(should_demangle_lazily()) {
+            return;
+        }
+        for(auto& frame : frames) {
+            frame.symbol = demangle(frame.symbol, true);
+        }
+    }
+
+    // The safe printing functions below are async-signal-safe, they can only use the stack and write(2)
+
+    const char* safe_basename(const char* path) {
+        const char* basename = path;
+        for(const char* c = path; *c != 0; c++) {
+            if(*c == '/' || (IS_WINDOWS && *c == '\\')) {
+                basename = c + 1;
+            }
+        }
+        return basename;
+    }
+
+    void write_safe_header(fd_writer& writer, std::size_t size) {
+        writer.print("Stack trace (most recent call first):\n");
+        if(size == 0) {
+            writer.print("<empty trace>\n");
+        }
+    }
+
+    // #0 0x00005555555551f2 in program+0x11f2
+    void write_safe_object_frame(fd_writer& writer, const safe_object_frame& frame, std::size_t i, std::size_t size) {
+        writer.print(
+            "#{<{}} 0x{>{}:0h}",
+            n_digits(static_cast<unsigned>(size - 1)),
+            i,
+            2 * sizeof(frame_ptr),
+            frame.raw_address
+        );
+        if(frame.object_path[0] != 0) {
+            writer.print(
+                " in {}+0x{:h}",
+                safe_basename(frame.object_path),
+                frame.address_relative_to_object_start
+            );
+        }
+        writer.put('\n');
+    }
+}
+
     CPPTRACE_FORCE_NO_INLINE
     raw_trace raw_trace::current(std::size_t skip) {
         try { // try/catch can never be hit but it's needed to prevent TCO
@@ -56,11 +107,13 @@ CPPTRACE_BEGIN_NAMESPACE
     }
 
     stacktrace raw_trace::resolve() const {
+        return resolve(resolution_level::full_with_inlines);
+    }
+
+    stacktrace raw_trace::resolve(resolution_level level) const {
         try {
-            std::vector<stacktrace_frame> trace = detail::resolve_frames(frames);
-            for(auto& frame : trace) {
-                frame.symbol = detail::demangle(frame.symbol, true);
-            }
+            std::vector<stacktrace_frame> trace = detail::resolve_frames(frames, level);
+            detail::demangle_frames(trace);
             return {std::move(trace)};
         } catch(...) { // NOSONAR
             detail::log_and_maybe_propagate_exception(std::current_exception());
@@ -97,11 +150,13 @@ CPPTRACE_BEGIN_NAMESPACE
     }
 
     stacktrace object_trace::resolve() const {
+        return resolve(resolution_level::full_with_inlines);
+    }
+
+    stacktrace object_trace::resolve(resolution_level level) const {
         try {
-            std::vector<stacktrace_frame> trace = detail::resolve_frames(frames);
-            for(auto& frame : trace) {
-                frame.symbol = detail::demangle(frame.symbol, true);
-            }
+            std::vector<stacktrace_frame> trace = detail::resolve_frames(frames, level);
+            detail::demangle_frames(trace);
             return {std::move(trace)};
         } catch(...) { // NOSONAR
             detail::log_and_maybe_propagate_exception(std::current_exception());
@@ -121,6 +176,10 @@ CPPTRACE_BEGIN_NAMESPACE
         return detail::get_frame_object_info(raw_address);
     }
 
+    std::string stacktrace_frame::demangled_symbol() const {
+        return detail::demangle(symbol, true);
+    }
+
     std::string stacktrace_frame::to_string() const {
         return to_string(false);
     }
@@ -281,9 +340,7 @@ CPPTRACE_BEGIN_NAMESPACE
         try {
             std::vector<frame_ptr> frames = detail::capture_frames(skip + 1, max_depth);
             std::vector<stacktrace_frame> trace = detail::resolve_frames(frames);
-            for(auto& frame : trace) {
-                frame.symbol = detail::demangle(frame.symbol, true);
-            }
+            detail::demangle_frames(trace);
             return {std::move(trace)};
         } catch(...) { // NOSONAR
             detail::log_and_maybe_propagate_exception(std::current_exception());
@@ -307,6 +364,28 @@ CPPTRACE_BEGIN_NAMESPACE
         return detail::has_get_safe_object_frame();
     }
 
+    std::size_t safe_print_raw_trace(int fd, const frame_ptr* buffer, std::size_t size) {
+        detail::fd_writer writer(fd);
+        detail::write_safe_header(writer, size);
+        for(std::size_t i = 0; i < size; i++) {
+            safe_object_frame frame;
+            detail::get_safe_object_frame(buffer[i], &frame);
+            detail::write_safe_object_frame(writer, frame, i, size);
+        }
+        writer.flush();
+        return writer.bytes_written();
+    }
+
+    std::size_t safe_print_object_frames(int fd, const safe_object_frame* frames, std::size_t size) {
+        detail::fd_writer writer(fd);
+        detail::write_safe_header(writer, size);
+        for(std::size_t i = 0; i < size; i++) {
+            detail::write_safe_object_frame(writer, frames[i], i, size);
+        }
+        writer.flush();
+        return writer.bytes_written();
+    }
+
     void register_jit_object(const char* ptr, std::size_t size) {
         detail::register_jit_object(ptr, size);
     }
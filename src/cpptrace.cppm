@@ -5,11 +5,14 @@ module;
 #include <cpptrace/formatting.hpp>
 #include <cpptrace/forward.hpp>
 #include <cpptrace/from_current.hpp>
+#include <cpptrace/resolution.hpp>
+#include <cpptrace/serialization.hpp>
 
 export module cpptrace;
 
 CPPTRACE_BEGIN_NAMESPACE
     // cpptrace/basic
+    export using cpptrace::resolution_level;
     export using cpptrace::raw_trace;
     export using cpptrace::object_frame;
     export using cpptrace::object_trace;
@@ -23,6 +26,8 @@ CPPTRACE_BEGIN_NAMESPACE
     export using cpptrace::safe_object_frame;
     export using cpptrace::can_get_safe_object_frame;
     export using cpptrace::can_signal_safe_unwind;
+    export using cpptrace::safe_print_raw_trace;
+    export using cpptrace::safe_print_object_frames;
     export using cpptrace::can_get_safe_object_frame;
     export using cpptrace::register_jit_object;
     export using cpptrace::unregister_jit_object;
@@ -49,6 +54,7 @@ CPPTRACE_BEGIN_NAMESPACE
     export using cpptrace::basename;
     export using cpptrace::prettify_symbol;
     export using cpptrace::formatter;
+    export using cpptrace::format_to_result;
     export using cpptrace::get_default_formatter;
 
     // cpptrace/forward
@@ -60,6 +66,7 @@ CPPTRACE_BEGIN_NAMESPACE
     export using cpptrace::raw_trace_from_current_exception_rethrow;
     export using cpptrace::from_current_exception_rethrow;
     export using cpptrace::current_exception_was_rethrown;
+    export using cpptrace::current_exception_was_sampled_out;
     export using cpptrace::rethrow;
     export using cpptrace::clear_current_exception_traces;
     export using cpptrace::try_catch;
@@ -78,6 +85,27 @@ CPPTRACE_BEGIN_NAMESPACE
     // cpptrace/io
     export using cpptrace::operator<<; // FIXME: make hidden friend
 
+    // cpptrace/resolution
+    namespace experimental {
+        export using cpptrace::experimental::resolve_many;
+        export using cpptrace::experimental::resolve_async;
+        export using cpptrace::experimental::full_queue_policy;
+        export using cpptrace::experimental::async_resolver_options;
+        export using cpptrace::experimental::configure_async_resolver;
+        export using cpptrace::experimental::set_exception_resolution_timeout;
+        export using cpptrace::experimental::cancellation_token;
+        export using cpptrace::experimental::frame_callback;
+        export using cpptrace::experimental::resolve_progressively;
+    }
+
+    // cpptrace/serialization
+    namespace experimental {
+        export using cpptrace::experimental::trace_encoder;
+        export using cpptrace::experimental::trace_decoder;
+        export using cpptrace::experimental::decoded_trace;
+        export using cpptrace::experimental::decode_status;
+    }
+
     // cpptrace/utils
     export using cpptrace::demangle;
     export using cpptrace::prune_symbol;
@@ -99,8 +127,19 @@ CPPTRACE_BEGIN_NAMESPACE
 
     namespace experimental {
         export using cpptrace::experimental::set_cache_mode;
+        export using cpptrace::experimental::enable_lazy_demangling;
         export using cpptrace::experimental::set_dwarf_resolver_line_table_cache_size;
         export using cpptrace::experimental::set_dwarf_resolver_disable_aranges;
+        export using cpptrace::experimental::use_remote_symbolizer;
+        export using cpptrace::experimental::latency_histogram;
+        export using cpptrace::experimental::cache_statistics;
+        export using cpptrace::experimental::backend_statistics;
+        export using cpptrace::experimental::statistics;
+        export using cpptrace::experimental::get_statistics;
+        export using cpptrace::experimental::reset_statistics;
+        export using cpptrace::experimental::capture_mode;
+        export using cpptrace::experimental::capture_policy;
+        export using cpptrace::experimental::set_capture_policy;
     }
 
     #ifdef _WIN32
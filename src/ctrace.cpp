@@ -1,10 +1,10 @@
 #include <ctrace/ctrace.h>
 #include <cpptrace/cpptrace.hpp>
+#include <cpptrace/serialization.hpp>
 #include <algorithm>
 
 #include "symbols/symbols.hpp"
 #include "unwind/unwind.hpp"
-#include "demangle/demangle.hpp"
 #include "platform/exception_type.hpp"
 #include "utils/common.hpp"
 #include "utils/utils.hpp"
@@ -103,7 +103,7 @@ CTRACE_FORMAT_EPILOGUE
         new_frame.line      = frame.line.value_or(invalid_pos);
         new_frame.column    = frame.column.value_or(invalid_pos);
         new_frame.filename  = generate_owning_string(frame.filename).data;
-        new_frame.symbol    = generate_owning_string(cpptrace::detail::demangle(frame.symbol, true)).data;
+        new_frame.symbol    = generate_owning_string(frame.symbol).data;
         new_frame.is_inline = ctrace_bool(frame.is_inline);
         return new_frame;
     }
@@ -144,8 +144,44 @@ CTRACE_FORMAT_EPILOGUE
         }
         return cpptrace::stacktrace{std::move(new_frames)};
     }
+
+    static ctrace_raw_trace c_convert(const std::vector<cpptrace::frame_ptr>& trace) {
+        std::size_t count = trace.size();
+        auto* frames = new ctrace_frame_ptr[count];
+        std::copy(trace.data(), trace.data() + count, frames);
+        return { frames, count };
+    }
+
+    static cpptrace::raw_trace cpp_convert(const ctrace_raw_trace* ptrace) {
+        if(!ptrace || !ptrace->frames) {
+            return { };
+        }
+        return cpptrace::raw_trace{{ptrace->frames, ptrace->frames + ptrace->count}};
+    }
+
+    static cpptrace::object_trace cpp_convert(const ctrace_object_trace* ptrace) {
+        if(!ptrace || !ptrace->frames) {
+            return { };
+        }
+        std::vector<cpptrace::object_frame> new_frames;
+        new_frames.reserve(ptrace->count);
+        for(std::size_t i = 0; i < ptrace->count; ++i) {
+            const auto& frame = ptrace->frames[i];
+            new_frames.push_back({frame.raw_address, frame.obj_address, frame.obj_path ? frame.obj_path : ""});
+        }
+        return cpptrace::object_trace{std::move(new_frames)};
+    }
 }
 
+struct ctrace_trace_encoder {
+    cpptrace::experimental::trace_encoder encoder;
+};
+
+struct ctrace_trace_decoder {
+    cpptrace::experimental::trace_decoder decoder;
+    cpptrace::experimental::decoded_trace trace;
+};
+
 extern "C" {
     // ctrace::string
     ctrace_owning_string ctrace_generate_owning_string(const char* raw_string) {
@@ -391,6 +427,148 @@ extern "C" {
         }
     }
 
+    // ctrace::serialization:
+    ctrace_trace_encoder* ctrace_create_trace_encoder(ctrace_bool intern_symbols) {
+        try {
+            auto* encoder = new ctrace_trace_encoder;
+            encoder->encoder.intern_symbols(intern_symbols);
+            return encoder;
+        } catch(...) {
+            return nullptr;
+        }
+    }
+
+    void ctrace_free_trace_encoder(ctrace_trace_encoder* encoder) {
+        delete encoder;
+    }
+
+    void ctrace_encode_raw_trace(ctrace_trace_encoder* encoder, const ctrace_raw_trace* trace) {
+        if(!encoder) {
+            return;
+        }
+        try {
+            encoder->encoder.encode(ctrace::cpp_convert(trace));
+        } catch(...) {
+            // Don't check rethrow condition, it's risky.
+        }
+    }
+
+    void ctrace_encode_object_trace(ctrace_trace_encoder* encoder, const ctrace_object_trace* trace) {
+        if(!encoder) {
+            return;
+        }
+        try {
+            encoder->encoder.encode(ctrace::cpp_convert(trace));
+        } catch(...) {
+            // Don't check rethrow condition, it's risky.
+        }
+    }
+
+    void ctrace_encode_stacktrace(ctrace_trace_encoder* encoder, const ctrace_stacktrace* trace) {
+        if(!encoder) {
+            return;
+        }
+        try {
+            encoder->encoder.encode(ctrace::cpp_convert(trace));
+        } catch(...) {
+            // Don't check rethrow condition, it's risky.
+        }
+    }
+
+    ctrace_buffer ctrace_take_encoded_data(ctrace_trace_encoder* encoder) {
+        if(!encoder) {
+            return { nullptr, 0 };
+        }
+        try {
+            std::string data = encoder->encoder.take();
+            char* buffer = new char[data.size()];
+            std::copy(data.begin(), data.end(), buffer);
+            return { buffer, data.size() };
+        } catch(...) {
+            return { nullptr, 0 };
+        }
+    }
+
+    void ctrace_reset_trace_encoder(ctrace_trace_encoder* encoder) {
+        if(!encoder) {
+            return;
+        }
+        encoder->encoder.reset();
+    }
+
+    void ctrace_free_buffer(ctrace_buffer* buffer) {
+        if(!buffer) {
+            return;
+        }
+        delete[] buffer->data;
+        buffer->data = nullptr;
+        buffer->size = 0;
+    }
+
+    ctrace_trace_decoder* ctrace_create_trace_decoder(void) {
+        try {
+            return new ctrace_trace_decoder;
+        } catch(...) {
+            return nullptr;
+        }
+    }
+
+    void ctrace_free_trace_decoder(ctrace_trace_decoder* decoder) {
+        delete decoder;
+    }
+
+    void ctrace_feed_trace_decoder(ctrace_trace_decoder* decoder, const char* data, size_t size) {
+        if(!decoder || !data) {
+            return;
+        }
+        try {
+            decoder->decoder.feed(data, size);
+        } catch(...) {
+            // Don't check rethrow condition, it's risky.
+        }
+    }
+
+    ctrace_decode_status ctrace_decode_next_trace(ctrace_trace_decoder* decoder, ctrace_decoded_trace* out) {
+        if(!decoder || !out) {
+            return ctrace_decode_error;
+        }
+        try {
+            auto status = decoder->decoder.next(decoder->trace);
+            if(status == cpptrace::experimental::decode_status::need_more_input) {
+                return ctrace_decode_need_more_input;
+            } else if(status == cpptrace::experimental::decode_status::error) {
+                return ctrace_decode_error;
+            }
+            *out = {};
+            switch(decoder->trace.type) {
+                case cpptrace::experimental::decoded_trace::trace_type::raw:
+                    out->type = ctrace_decoded_raw_trace;
+                    out->raw_trace = ctrace::c_convert(decoder->trace.raw.frames);
+                    break;
+                case cpptrace::experimental::decoded_trace::trace_type::object:
+                    out->type = ctrace_decoded_object_trace;
+                    out->object_trace = ctrace::c_convert(decoder->trace.object.frames);
+                    break;
+                case cpptrace::experimental::decoded_trace::trace_type::resolved:
+                    out->type = ctrace_decoded_stacktrace;
+                    out->stacktrace = ctrace::c_convert(decoder->trace.resolved.frames);
+                    break;
+            }
+            return ctrace_decode_ok;
+        } catch(...) {
+            return ctrace_decode_error;
+        }
+    }
+
+    void ctrace_free_decoded_trace(ctrace_decoded_trace* trace) {
+        if(!trace) {
+            return;
+        }
+        ctrace_free_raw_trace(&trace->raw_trace);
+        ctrace_free_object_trace(&trace->object_trace);
+        ctrace_free_stacktrace(&trace->stacktrace);
+    }
+
     // utility::demangle:
     ctrace_owning_string ctrace_demangle(const char* mangled) {
         if(!mangled) {
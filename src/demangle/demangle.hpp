@@ -4,10 +4,13 @@
 #include <cpptrace/forward.hpp>
 
 #include <string>
+#include <vector>
 
 CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
     std::string demangle(const std::string& name, bool check_prefix);
+    // demangles resolved frames unless lazy demangling is enabled
+    void demangle_frames(std::vector<stacktrace_frame>& frames);
 }
 CPPTRACE_END_NAMESPACE
 
@@ -3,57 +3,135 @@
 
 #include "demangle/demangle.hpp"
 
+#include "options.hpp"
+#include "utils/lru_cache.hpp"
+#include "utils/optional.hpp"
 #include "utils/utils.hpp"
 
 #include <cxxabi.h>
 
+#include <array>
 #include <cstdlib>
 #include <functional>
+#include <mutex>
 #include <string>
 
 CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
-    std::string demangle(const std::string& name, bool check_prefix) {
-        // https://itanium-cxx-abi.github.io/cxx-abi/abi.html#demangler
-        // Check both _Z and __Z, apple prefixes all symbols with an underscore
-        if(check_prefix && !(starts_with(name, "_Z") || starts_with(name, "__Z"))) {
-            return name;
+    // Output buffer for __cxa_demangle which is reused across calls on a thread, __cxa_demangle reallocs it as
+    // needed
+    class demangle_buffer {
+        char* buffer = nullptr;
+        std::size_t length = 0;
+    public:
+        demangle_buffer() = default;
+        ~demangle_buffer() {
+            std::free(buffer);
+        }
+        demangle_buffer(const demangle_buffer&) = delete;
+        demangle_buffer& operator=(const demangle_buffer&) = delete;
+
+        // returns nullptr if the name couldn't be demangled, the result is valid until the next call
+        const char* demangle(const char* name) {
+            // it appears safe to pass nullptr for status however the docs don't explicitly say it's safe so I
+            // don't want to rely on it
+            int status;
+            char* result = abi::__cxa_demangle(name, buffer, &length, &status);
+            if(result) {
+                // the buffer may have been reallocated
+                buffer = result;
+            }
+            return status == 0 ? result : nullptr;
+        }
+    };
+
+    // Mangled -> demangled names, the same symbols come up over and over again and heavily templated symbols are
+    // expensive to demangle. Sharded to keep contention down when many threads are resolving traces.
+    class demangle_cache {
+        static constexpr std::size_t shard_count = 16;
+        static constexpr std::size_t shard_size = 256;
+        struct shard {
+            std::mutex mutex;
+            lru_cache<std::string, std::string> cache{shard_size};
+        };
+        std::array<shard, shard_count> shards;
+
+        shard& get_shard(const std::string& name) {
+            return shards[std::hash<std::string>{}(name) % shard_count];
+        }
+
+    public:
+        optional<std::string> get(const std::string& name) {
+            auto& shard = get_shard(name);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto res = shard.cache.maybe_get(name);
+            if(res) {
+                return res.unwrap();
+            }
+            return nullopt;
         }
+
+        void set(const std::string& name, const std::string& demangled) {
+            auto& shard = get_shard(name);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.cache.set(name, demangled);
+        }
+    };
+
+    constexpr std::size_t demangle_cache::shard_count;
+    constexpr std::size_t demangle_cache::shard_size;
+
+    demangle_cache& get_demangle_cache() {
+        static demangle_cache cache;
+        return cache;
+    }
+
+    std::string demangle_uncached(const std::string& name) {
         // Apple clang demangles __Z just fine but gcc doesn't, so just offset the leading underscore
         std::size_t offset = 0;
         if(starts_with(name, "__Z")) {
             offset = 1;
         }
-        // Mangled names don't have spaces, we might add a space and some extra info somewhere but we still want it to
-        // be demanglable. Look for a space, if there is one swap it with a null terminator briefly.
+        thread_local demangle_buffer buffer;
+        // Mangled names don't have spaces, we might add a space and some extra info somewhere but we still want it
+        // to be demanglable. Look for a space, if there is one demangle only the part before it.
         auto end = name.find(' ');
-        std::string name_copy;
-        std::reference_wrapper<const std::string> to_demangle = name;
-        std::string rest;
-        if(end != std::string::npos) {
-            name_copy = name.substr(0, end);
-            rest = name.substr(end);
-            to_demangle = name_copy;
-        }
-        // presumably thread-safe
-        // it appears safe to pass nullptr for status however the docs don't explicitly say it's safe so I don't
-        // want to rely on it
-        int status;
-        auto demangled = raii_wrap(
-            abi::__cxa_demangle(to_demangle.get().c_str() + offset, nullptr, nullptr, &status),
-            [] (char* str) { std::free(str); }
-        );
-        // demangled will always be nullptr on non-zero status, and if __cxa_demangle ever fails for any reason
-        // we'll just quietly return the mangled name
-        if(demangled.get()) {
-            std::string str = demangled.get();
-            if(!rest.empty()) {
-                str += rest;
-            }
-            return str;
+        const char* demangled;
+        if(end == std::string::npos) {
+            demangled = buffer.demangle(name.c_str() + offset);
         } else {
+            thread_local std::string prefix;
+            prefix.assign(name, offset, end - offset);
+            demangled = buffer.demangle(prefix.c_str());
+        }
+        // if __cxa_demangle ever fails for any reason we'll just quietly return the mangled name
+        if(!demangled) {
             return name;
         }
+        std::string str = demangled;
+        if(end != std::string::npos) {
+            str.append(name, end, std::string::npos);
+        }
+        return str;
+    }
+
+    std::string demangle(const std::string& name, bool check_prefix) {
+        // https://itanium-cxx-abi.github.io/cxx-abi/abi.html#demangler
+        // Check both _Z and __Z, apple prefixes all symbols with an underscore
+        if(check_prefix && !(starts_with(name, "_Z") || starts_with(name, "__Z"))) {
+            return name;
+        }
+        if(get_cache_mode() != cache_mode::prioritize_speed) {
+            return demangle_uncached(name);
+        }
+        auto& cache = get_demangle_cache();
+        auto cached = cache.get(name);
+        if(cached) {
+            return std::move(cached).unwrap();
+        }
+        auto demangled = demangle_uncached(name);
+        cache.set(name, demangled);
+        return demangled;
     }
 }
 CPPTRACE_END_NAMESPACE
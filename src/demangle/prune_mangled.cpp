@@ -0,0 +1,695 @@
+#include "demangle/prune_mangled.hpp"
+
+#include "utils/optional.hpp"
+#include "utils/string_view.hpp"
+#include "utils/utils.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// https://itanium-cxx-abi.github.io/cxx-abi/abi.html#mangling
+// https://github.com/gcc-mirror/gcc/blob/master/libiberty/cp-demangle.c
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    namespace itanium {
+        bool is_digit(char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        bool is_upper(char c) {
+            return c >= 'A' && c <= 'Z';
+        }
+
+        bool is_lower(char c) {
+            return c >= 'a' && c <= 'z';
+        }
+
+        bool is_cv_qualifier(char c) {
+            return c == 'r' || c == 'V' || c == 'K';
+        }
+
+        bool is_builtin_type(char c) {
+            switch(c) {
+                case 'v': case 'w': case 'b': case 'c': case 'a': case 'h': case 's': case 't': case 'i': case 'j':
+                case 'l': case 'm': case 'x': case 'y': case 'n': case 'o': case 'f': case 'd': case 'e': case 'g':
+                case 'z':
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        struct operator_name {
+            char code[3];
+            const char* name;
+        };
+
+        // Only operators which can name a function, these are printed the same way by libiberty and libc++abi
+        constexpr operator_name operator_names[] = {
+            {"nw", " new"}, {"na", " new[]"}, {"dl", " delete"}, {"da", " delete[]"}, {"aw", " co_await"},
+            {"ps", "+"}, {"ng", "-"}, {"ad", "&"}, {"de", "*"}, {"co", "~"}, {"pl", "+"}, {"mi", "-"}, {"ml", "*"},
+            {"dv", "/"}, {"rm", "%"}, {"an", "&"}, {"or", "|"}, {"eo", "^"}, {"aS", "="}, {"pL", "+="}, {"mI", "-="},
+            {"mL", "*="}, {"dV", "/="}, {"rM", "%="}, {"aN", "&="}, {"oR", "|="}, {"eO", "^="}, {"ls", "<<"},
+            {"rs", ">>"}, {"lS", "<<="}, {"rS", ">>="}, {"eq", "=="}, {"ne", "!="}, {"lt", "<"}, {"gt", ">"},
+            {"le", "<="}, {"ge", ">="}, {"ss", "<=>"}, {"nt", "!"}, {"aa", "&&"}, {"oo", "||"}, {"pp", "++"},
+            {"mm", "--"}, {"cm", ","}, {"pm", "->*"}, {"pt", "->"}, {"cl", "()"}, {"ix", "[]"}, {"qu", "?"},
+        };
+
+        // Walks a mangled name and writes out what prune_symbol would produce for the demangled name: the qualified
+        // name of the entity with template arguments, parameters, and return types left out. The parts which aren't
+        // printed are skipped over without being materialized, but they still have to be parsed to find where they
+        // end and to keep the substitution table in sync with the demangler's. Any construct not handled here fails
+        // the walk.
+        class pruner {
+            struct substitution {
+                // the text of a substitution candidate is only known if it was emitted as part of the output
+                bool known;
+                std::size_t begin;
+                std::size_t end;
+            };
+
+            string_view source;
+            std::size_t pos = 0;
+            std::string output;
+            std::vector<substitution> substitutions;
+            // the last source name seen, used for constructor and destructor names
+            string_view last_name;
+
+            char peek(std::size_t offset = 0) const {
+                return pos + offset < source.size() ? source.data()[pos + offset] : '\0';
+            }
+
+            bool consume(char c) {
+                if(peek() == c) {
+                    pos++;
+                    return true;
+                }
+                return false;
+            }
+
+            void write(bool do_emit, string_view text) {
+                if(do_emit) {
+                    output += text;
+                }
+            }
+
+            void add_substitution(bool known, std::size_t begin) {
+                substitutions.push_back({known, begin, output.size()});
+            }
+
+            void add_type_substitution() {
+                substitutions.push_back({false, 0, 0});
+            }
+
+            NODISCARD bool parse_number(std::size_t& value) {
+                if(!is_digit(peek())) {
+                    return false;
+                }
+                value = 0;
+                while(is_digit(peek())) {
+                    value = value * 10 + static_cast<std::size_t>(source.data()[pos++] - '0');
+                    if(value > source.size() * 10) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            // <nonnegative number> _ | _, returned as it will be printed
+            NODISCARD bool parse_compact_number(std::size_t& value) {
+                if(peek() == '_') {
+                    value = 1;
+                } else {
+                    if(!parse_number(value)) {
+                        return false;
+                    }
+                    value += 2;
+                }
+                return consume('_');
+            }
+
+            NODISCARD bool parse_source_name(string_view& name) {
+                std::size_t length;
+                if(!parse_number(length) || length == 0 || length > source.size() - pos) {
+                    return false;
+                }
+                name = source.substr(pos, length);
+                pos += length;
+                return true;
+            }
+
+            NODISCARD bool parse_discriminator() {
+                if(!consume('_')) {
+                    return true;
+                }
+                const bool two_underscores = consume('_');
+                std::size_t discriminator;
+                if(!parse_number(discriminator)) {
+                    return false;
+                }
+                if(two_underscores && discriminator >= 10) {
+                    return consume('_');
+                }
+                return true;
+            }
+
+            NODISCARD bool parse_operator_name(bool emit) {
+                for(const auto& op : operator_names) {
+                    if(peek() == op.code[0] && peek(1) == op.code[1]) {
+                        pos += 2;
+                        write(emit, "operator");
+                        write(emit, op.name);
+                        return true;
+                    }
+                }
+                // conversion operators, literal operators, vendor operators
+                return false;
+            }
+
+            NODISCARD bool parse_unqualified_name(bool emit) {
+                const char c = peek();
+                if(is_digit(c)) {
+                    string_view name;
+                    if(!parse_source_name(name)) {
+                        return false;
+                    }
+                    // _GLOBAL__N_1 and friends
+                    if(
+                        name.size() >= 10
+                        && name.starts_with("_GLOBAL_")
+                        && (name.data()[8] == '.' || name.data()[8] == '_' || name.data()[8] == '$')
+                        && name.data()[9] == 'N'
+                    ) {
+                        write(emit, "(anonymous namespace)");
+                    } else {
+                        write(emit, name);
+                    }
+                    last_name = name;
+                } else if(is_lower(c)) {
+                    if(!parse_operator_name(emit)) {
+                        return false;
+                    }
+                } else if(c == 'C') {
+                    const char kind = peek(1);
+                    if(!(kind >= '1' && kind <= '5') || last_name.empty()) {
+                        return false;
+                    }
+                    pos += 2;
+                    write(emit, last_name);
+                } else if(c == 'D') {
+                    const char kind = peek(1);
+                    const bool is_destructor = kind == '0' || kind == '1' || kind == '2' || kind == '4' || kind == '5';
+                    if(!is_destructor || last_name.empty()) {
+                        return false;
+                    }
+                    pos += 2;
+                    write(emit, "~");
+                    write(emit, last_name);
+                } else if(c == 'U') {
+                    #ifdef __GLIBCXX__
+                    // Lambdas and unnamed types are printed differently by each demangler, only libiberty's format is
+                    // handled
+                    std::size_t number;
+                    if(peek(1) == 't') {
+                        pos += 2;
+                        if(!parse_compact_number(number)) {
+                            return false;
+                        }
+                        write(emit, "<unnamed type#");
+                    } else if(peek(1) == 'l') {
+                        pos += 2;
+                        do {
+                            if(!parse_type()) {
+                                return false;
+                            }
+                        } while(peek() != 'E');
+                        pos++;
+                        if(!parse_compact_number(number)) {
+                            return false;
+                        }
+                        write(emit, "<lambda#");
+                    } else {
+                        return false;
+                    }
+                    if(emit) {
+                        output += std::to_string(number);
+                        output += '>';
+                    }
+                    #else
+                    return false;
+                    #endif
+                } else if(c == 'L') {
+                    // internal linkage
+                    pos++;
+                    string_view name;
+                    if(!parse_source_name(name)) {
+                        return false;
+                    }
+                    write(emit, name);
+                    last_name = name;
+                    if(!parse_discriminator()) {
+                        return false;
+                    }
+                } else {
+                    return false;
+                }
+                // abi tags, these are pruned
+                while(consume('B')) {
+                    string_view tag;
+                    if(!parse_source_name(tag)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            NODISCARD bool parse_substitution(bool emit, bool in_prefix) {
+                pos++; // S
+                const char c = peek();
+                if(c == '_' || is_digit(c) || is_upper(c)) {
+                    std::size_t index = 0;
+                    if(c != '_') {
+                        while(is_digit(peek()) || is_upper(peek())) {
+                            const char digit = source.data()[pos++];
+                            const int value = is_digit(digit) ? digit - '0' : digit - 'A' + 10;
+                            index = index * 36 + static_cast<std::size_t>(value);
+                            if(index >= substitutions.size()) {
+                                return false;
+                            }
+                        }
+                        index++;
+                    }
+                    if(!consume('_') || index >= substitutions.size()) {
+                        return false;
+                    }
+                    if(emit) {
+                        const auto sub = substitutions[index];
+                        if(!sub.known) {
+                            return false;
+                        }
+                        output.append(output, sub.begin, sub.end - sub.begin);
+                    }
+                    return true;
+                }
+                pos++;
+                // the expanded form of these is used when they're the prefix of a constructor or destructor
+                const bool expanded = in_prefix && (peek() == 'C' || peek() == 'D');
+                switch(c) {
+                    case 'a':
+                        write(emit, "std::allocator");
+                        last_name = "allocator";
+                        return true;
+                    case 'b':
+                        write(emit, "std::basic_string");
+                        last_name = "basic_string";
+                        return true;
+                    case 's':
+                        write(emit, expanded ? "std::basic_string" : "std::string");
+                        last_name = "basic_string";
+                        return true;
+                    case 'i':
+                        write(emit, expanded ? "std::basic_istream" : "std::istream");
+                        last_name = "basic_istream";
+                        return true;
+                    case 'o':
+                        write(emit, expanded ? "std::basic_ostream" : "std::ostream");
+                        last_name = "basic_ostream";
+                        return true;
+                    case 'd':
+                        write(emit, expanded ? "std::basic_iostream" : "std::iostream");
+                        last_name = "basic_iostream";
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            NODISCARD bool parse_template_param() {
+                pos++; // T
+                if(peek() != '_') {
+                    std::size_t index;
+                    if(!parse_number(index)) {
+                        return false;
+                    }
+                }
+                return consume('_');
+            }
+
+            NODISCARD bool parse_template_args() {
+                pos++; // I
+                // template arguments shouldn't affect constructor and destructor names
+                const auto saved_last_name = last_name;
+                do {
+                    if(!parse_template_arg()) {
+                        return false;
+                    }
+                } while(peek() != 'E');
+                pos++;
+                last_name = saved_last_name;
+                return true;
+            }
+
+            NODISCARD bool parse_template_arg() {
+                switch(peek()) {
+                    case 'L':
+                        return parse_expr_primary();
+                    case 'J':
+                        pos++;
+                        while(peek() != 'E') {
+                            if(!parse_template_arg()) {
+                                return false;
+                            }
+                        }
+                        pos++;
+                        return true;
+                    case 'X':
+                        // expressions
+                        return false;
+                    default:
+                        return parse_type();
+                }
+            }
+
+            NODISCARD bool parse_expr_primary() {
+                pos++; // L
+                if(peek() == 'Z' || (peek() == '_' && peek(1) == 'Z')) {
+                    pos += peek() == 'Z' ? 1 : 2;
+                    return parse_encoding(false) && consume('E');
+                }
+                if(!parse_type()) {
+                    return false;
+                }
+                // the literal's value, if there is one
+                while(peek() != 'E') {
+                    if(peek() == '\0') {
+                        return false;
+                    }
+                    pos++;
+                }
+                pos++;
+                return true;
+            }
+
+            NODISCARD bool parse_function_type() {
+                pos++; // F
+                consume('Y');
+                do {
+                    if(!parse_type()) {
+                        return false;
+                    }
+                } while(peek() != 'E' && !((peek() == 'R' || peek() == 'O') && peek(1) == 'E'));
+                if(peek() != 'E') {
+                    pos++; // ref-qualifier
+                }
+                pos++;
+                return true;
+            }
+
+            // Types are never part of the output
+            NODISCARD bool parse_type() {
+                const char c = peek();
+                if(is_cv_qualifier(c)) {
+                    while(is_cv_qualifier(peek())) {
+                        pos++;
+                    }
+                    // cv-qualifiers on a function type apply to `this`, the unqualified function type isn't a candidate
+                    if(peek() == 'F') {
+                        if(!parse_function_type()) {
+                            return false;
+                        }
+                    } else if(!parse_type()) {
+                        return false;
+                    }
+                    add_type_substitution();
+                    return true;
+                }
+                if(is_builtin_type(c)) {
+                    pos++;
+                    return true;
+                }
+                switch(c) {
+                    case 'u':
+                        {
+                            pos++;
+                            string_view name;
+                            if(!parse_source_name(name) || peek() == 'I') {
+                                return false;
+                            }
+                        }
+                        break;
+                    case 'D':
+                        switch(peek(1)) {
+                            case 'a': case 'c': case 'd': case 'e': case 'f': case 'h': case 'i': case 'n': case 's':
+                            case 'u':
+                                pos += 2;
+                                return true;
+                            case 'p':
+                                pos += 2;
+                                if(!parse_type()) {
+                                    return false;
+                                }
+                                break;
+                            default:
+                                return false;
+                        }
+                        break;
+                    case 'F':
+                        if(!parse_function_type()) {
+                            return false;
+                        }
+                        break;
+                    case 'A':
+                        pos++;
+                        if(!consume('_')) {
+                            std::size_t dimension;
+                            if(!parse_number(dimension) || !consume('_')) {
+                                return false;
+                            }
+                        }
+                        if(!parse_type()) {
+                            return false;
+                        }
+                        break;
+                    case 'M':
+                        pos++;
+                        if(!parse_type() || !parse_type()) {
+                            return false;
+                        }
+                        break;
+                    case 'T':
+                        if(!parse_template_param()) {
+                            return false;
+                        }
+                        if(peek() == 'I') {
+                            add_type_substitution();
+                            if(!parse_template_args()) {
+                                return false;
+                            }
+                        }
+                        break;
+                    case 'O': case 'P': case 'R': case 'C': case 'G':
+                        pos++;
+                        if(!parse_type()) {
+                            return false;
+                        }
+                        break;
+                    case 'S':
+                        {
+                            const char next = peek(1);
+                            if(next == 't') {
+                                if(!parse_name(false)) {
+                                    return false;
+                                }
+                            } else {
+                                if(!parse_substitution(false, false)) {
+                                    return false;
+                                }
+                                // a substitution is only a new candidate if it's followed by template arguments
+                                if(peek() != 'I') {
+                                    return true;
+                                }
+                                if(!parse_template_args()) {
+                                    return false;
+                                }
+                            }
+                        }
+                        break;
+                    case 'N': case 'Z':
+                    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9':
+                        if(!parse_name(false)) {
+                            return false;
+                        }
+                        break;
+                    default:
+                        return false;
+                }
+                add_type_substitution();
+                return true;
+            }
+
+            NODISCARD bool parse_nested_name(bool emit) {
+                pos++; // N
+                while(is_cv_qualifier(peek())) {
+                    pos++;
+                }
+                if(peek() == 'R' || peek() == 'O') {
+                    pos++;
+                }
+                const std::size_t name_start = output.size();
+                bool has_component = false;
+                while(peek() != 'E') {
+                    if(peek() == 'I') {
+                        if(!has_component || !parse_template_args()) {
+                            return false;
+                        }
+                    } else if(peek() == 'S') {
+                        // substitutions can only be the first component and aren't new candidates
+                        if(has_component) {
+                            return false;
+                        }
+                        if(peek(1) == 't') {
+                            pos += 2;
+                            write(emit, "std");
+                        } else if(!parse_substitution(emit, true)) {
+                            return false;
+                        }
+                        has_component = true;
+                        continue;
+                    } else if(peek() == 'T') {
+                        if(has_component || emit || !parse_template_param()) {
+                            return false;
+                        }
+                    } else {
+                        if(has_component) {
+                            write(emit, "::");
+                        }
+                        if(!parse_unqualified_name(emit)) {
+                            return false;
+                        }
+                    }
+                    has_component = true;
+                    if(peek() != 'E') {
+                        add_substitution(emit, name_start);
+                    }
+                }
+                pos++;
+                return has_component;
+            }
+
+            NODISCARD bool parse_local_name(bool emit) {
+                pos++; // Z
+                if(!parse_encoding(emit) || !consume('E')) {
+                    return false;
+                }
+                // string literals and default arguments
+                if(peek() == 's' || peek() == 'd') {
+                    return false;
+                }
+                write(emit, "::");
+                // lambdas and unnamed types have their own discriminators
+                const bool is_unnamed = peek() == 'U';
+                if(!parse_name(emit)) {
+                    return false;
+                }
+                return is_unnamed || parse_discriminator();
+            }
+
+            NODISCARD bool parse_name(bool emit) {
+                const std::size_t name_start = output.size();
+                switch(peek()) {
+                    case 'N':
+                        return parse_nested_name(emit);
+                    case 'Z':
+                        return parse_local_name(emit);
+                    case 'S':
+                        if(peek(1) == 't') {
+                            pos += 2;
+                            write(emit, "std::");
+                            if(!parse_unqualified_name(emit)) {
+                                return false;
+                            }
+                            if(peek() == 'I') {
+                                add_substitution(emit, name_start);
+                                return parse_template_args();
+                            }
+                            return true;
+                        }
+                        if(!parse_substitution(emit, false)) {
+                            return false;
+                        }
+                        return peek() != 'I' || parse_template_args();
+                    default:
+                        if(!parse_unqualified_name(emit)) {
+                            return false;
+                        }
+                        if(peek() == 'I') {
+                            // an unscoped template name is a candidate
+                            add_substitution(emit, name_start);
+                            return parse_template_args();
+                        }
+                        return true;
+                }
+            }
+
+            NODISCARD bool parse_encoding(bool emit) {
+                // special names: vtables, typeinfo, thunks, guard variables, etc.
+                if(peek() == 'T' || peek() == 'G') {
+                    return false;
+                }
+                if(!parse_name(emit)) {
+                    return false;
+                }
+                // the return type, if present, and parameter types
+                while(peek() != 'E' && peek() != '.' && peek() != '\0') {
+                    if(!parse_type()) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            // e.g. .cold or .constprop.0, these show up as [clone .cold] and are pruned
+            NODISCARD bool parse_clone_suffixes() {
+                const auto is_suffix_char = [] (char c) { return is_lower(c) || is_digit(c) || c == '_'; };
+                while(peek() == '.' && is_suffix_char(peek(1))) {
+                    pos += 2;
+                    while(is_suffix_char(peek())) {
+                        pos++;
+                    }
+                    while(peek() == '.' && is_digit(peek(1))) {
+                        pos += 2;
+                        while(is_digit(peek())) {
+                            pos++;
+                        }
+                    }
+                }
+                return pos == source.size();
+            }
+
+        public:
+            explicit pruner(string_view source) : source(source) {}
+
+            NODISCARD optional<std::string> prune() && {
+                if(!parse_encoding(true) || !parse_clone_suffixes() || output.empty()) {
+                    return nullopt;
+                }
+                return std::move(output);
+            }
+        };
+    }
+
+    optional<std::string> prune_mangled_symbol(string_view symbol) {
+        // apple prefixes all symbols with an underscore
+        if(symbol.starts_with("__Z")) {
+            symbol.advance(3);
+        } else if(symbol.starts_with("_Z")) {
+            symbol.advance(2);
+        } else {
+            return nullopt;
+        }
+        return itanium::pruner(symbol).prune();
+    }
+}
+CPPTRACE_END_NAMESPACE
@@ -0,0 +1,19 @@
+#ifndef PRUNE_MANGLED_HPP
+#define PRUNE_MANGLED_HPP
+
+#include <cpptrace/forward.hpp>
+#include "utils/optional.hpp"
+#include "utils/string_view.hpp"
+
+#include <string>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // Produces the same result as prune_symbol(demangle(symbol)) for an Itanium-mangled symbol, without demangling
+    // the full symbol. Returns nullopt for symbols which aren't mangled or use constructs the fast path doesn't handle,
+    // callers should fall back to demangling and pruning in that case.
+    optional<std::string> prune_mangled_symbol(string_view symbol);
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
@@ -10,6 +10,8 @@
 #include <string>
 
 #include "platform/exception_type.hpp"
+#include "async_resolution.hpp"
+#include "capture_policy.hpp"
 #include "utils/common.hpp"
 #include "options.hpp"
 #include "logging.hpp"
@@ -17,14 +19,16 @@
 
 CPPTRACE_BEGIN_NAMESPACE
     namespace detail {
-        lazy_trace_holder::lazy_trace_holder(const lazy_trace_holder& other) : resolved(other.resolved) {
+        lazy_trace_holder::lazy_trace_holder(const lazy_trace_holder& other)
+            : resolved(other.resolved), sampled_out(other.sampled_out) {
             if(other.resolved) {
                 new (&resolved_trace) stacktrace(other.resolved_trace);
             } else {
                 new (&trace) raw_trace(other.trace);
             }
         }
-        lazy_trace_holder::lazy_trace_holder(lazy_trace_holder&& other) noexcept : resolved(other.resolved) {
+        lazy_trace_holder::lazy_trace_holder(lazy_trace_holder&& other) noexcept
+            : resolved(other.resolved), sampled_out(other.sampled_out) {
             if(other.resolved) {
                 new (&resolved_trace) stacktrace(std::move(other.resolved_trace));
             } else {
@@ -34,6 +38,7 @@ CPPTRACE_BEGIN_NAMESPACE
         lazy_trace_holder& lazy_trace_holder::operator=(const lazy_trace_holder& other) {
             clear();
             resolved = other.resolved;
+            sampled_out = other.sampled_out;
             if(other.resolved) {
                 new (&resolved_trace) stacktrace(other.resolved_trace);
             } else {
@@ -44,6 +49,7 @@ CPPTRACE_BEGIN_NAMESPACE
         lazy_trace_holder& lazy_trace_holder::operator=(lazy_trace_holder&& other) noexcept {
             clear();
             resolved = other.resolved;
+            sampled_out = other.sampled_out;
             if(other.resolved) {
                 new (&resolved_trace) stacktrace(std::move(other.resolved_trace));
             } else {
@@ -66,10 +72,17 @@ CPPTRACE_BEGIN_NAMESPACE
         stacktrace& lazy_trace_holder::get_resolved_trace() {
             if(!resolved) {
                 raw_trace old_trace = std::move(trace);
+                bool old_sampled_out = sampled_out;
                 *this = lazy_trace_holder(stacktrace{});
+                sampled_out = old_sampled_out;
                 try {
                     if(!old_trace.empty()) {
-                        resolved_trace = old_trace.resolve();
+                        auto timeout = get_exception_resolution_timeout();
+                        if(timeout) {
+                            resolved_trace = resolve_with_timeout(old_trace, timeout.unwrap());
+                        } else {
+                            resolved_trace = old_trace.resolve();
+                        }
                     }
                 } catch(const std::exception& e) {
                     if(!should_absorb_trace_exceptions()) {
@@ -93,6 +106,9 @@ CPPTRACE_BEGIN_NAMESPACE
         bool lazy_trace_holder::is_resolved() const {
             return resolved;
         }
+        bool lazy_trace_holder::is_sampled_out() const {
+            return sampled_out;
+        }
         void lazy_trace_holder::clear() {
             if(resolved) {
                 resolved_trace.~stacktrace();
@@ -101,9 +117,16 @@ CPPTRACE_BEGIN_NAMESPACE
             }
         }
 
+        // Set by get_raw_trace_and_absorb for the exception object that's about to be constructed from its result
+        thread_local bool last_capture_sampled_out = false;
+
         CPPTRACE_FORCE_NO_INLINE
         raw_trace get_raw_trace_and_absorb(std::size_t skip, std::size_t max_depth) {
             try {
+                last_capture_sampled_out = !should_capture(skip + 1);
+                if(last_capture_sampled_out) {
+                    return raw_trace{};
+                }
                 return generate_raw_trace(skip + 1, max_depth);
             } catch(const std::exception& e) {
                 if(!should_absorb_trace_exceptions()) {
@@ -125,11 +148,22 @@ CPPTRACE_BEGIN_NAMESPACE
                 return raw_trace{};
             }
         }
+
+        bool was_sampled_out(const raw_trace& trace) noexcept {
+            bool sampled_out = last_capture_sampled_out;
+            // consumed so that it can't be attributed to a later exception constructed from a user-provided trace
+            last_capture_sampled_out = false;
+            return sampled_out && trace.empty();
+        }
     }
 
     const char* lazy_exception::what() const noexcept {
         if(what_string.empty()) {
-            what_string = message() + std::string(":\n") + trace_holder.get_resolved_trace().to_string();
+            if(trace_holder.is_sampled_out()) {
+                what_string = message() + std::string(":\n<trace sampled out>");
+            } else {
+                what_string = message() + std::string(":\n") + trace_holder.get_resolved_trace().to_string();
+            }
         }
         return what_string.c_str();
     }
@@ -142,6 +176,10 @@ CPPTRACE_BEGIN_NAMESPACE
         return trace_holder.get_resolved_trace();
     }
 
+    bool lazy_exception::trace_was_sampled_out() const noexcept {
+        return trace_holder.is_sampled_out();
+    }
+
     const char* exception_with_message::message() const noexcept {
         return user_message.c_str();
     }
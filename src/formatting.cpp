@@ -1,62 +1,153 @@
 #include <cpptrace/formatting.hpp>
 #include <cpptrace/utils.hpp>
 
+#include "demangle/prune_mangled.hpp"
+#include "prettify_symbol.hpp"
+#include "prune_symbol.hpp"
+#include "utils/microfmt.hpp"
 #include "utils/optional.hpp"
 #include "utils/utils.hpp"
-#include "utils/replace_all.hpp"
 #include "snippets/snippet.hpp"
 
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <iterator>
 #include <string>
 #include <functional>
 #include <iostream>
-#include <sstream>
-#include <regex>
 
 CPPTRACE_BEGIN_NAMESPACE
     std::string basename(const std::string& path) {
         return detail::basename(path, true);
     }
 
-    std::string prettify_symbol(std::string symbol) {
-        // > > -> >> replacement
-        // could put in analysis:: but the replacement is basic and this is more convenient for
-        // using in the stringifier too
-        detail::replace_all_dynamic(symbol, "> >", ">>");
-        // "," -> ", " and " ," -> ", "
-        static const std::regex comma_re(R"(\s*,\s*)");
-        detail::replace_all(symbol, comma_re, ", ");
-        // class C -> C for msvc
-        static const std::regex class_re(R"(\b(class|struct)\s+)");
-        detail::replace_all(symbol, class_re, "");
-        // `anonymous namespace' -> (anonymous namespace) for msvc
-        // this brings it in-line with other compilers and prevents any tokenization/highlighting issues
-        static const std::regex msvc_anonymous_namespace("`anonymous namespace'");
-        detail::replace_all(symbol, msvc_anonymous_namespace, "(anonymous namespace)");
-        // rules to replace std::basic_string -> std::string and std::basic_string_view -> std::string
-        // rule to replace ", std::allocator<whatever>"
-        static const std::pair<std::regex, std::string> basic_string = {
-            std::regex(R"(std(::[a-zA-Z0-9_]+)?::basic_string<char)"), "std::string"
-        };
-        detail::replace_all_template(symbol, basic_string);
-        static const std::pair<std::regex, std::string> basic_string_view = {
-            std::regex(R"(std(::[a-zA-Z0-9_]+)?::basic_string_view<char)"), "std::string_view"
-        };
-        detail::replace_all_template(symbol, basic_string_view);
-        static const std::pair<std::regex, std::string> allocator = {
-            std::regex(R"(,\s*std(::[a-zA-Z0-9_]+)?::allocator<)"), ""
-        };
-        detail::replace_all_template(symbol, allocator);
-        static const std::pair<std::regex, std::string> default_delete = {
-            std::regex(R"(,\s*std(::[a-zA-Z0-9_]+)?::default_delete<)"), ""
+namespace detail {
+    // Formatter output is collected in a fixed-size buffer and handed to the sink in chunks, so that nothing needs to
+    // build intermediate strings
+    class format_buffer {
+        format_sink& sink;
+        char buffer[512];
+        std::size_t used = 0;
+        std::size_t total = 0;
+        // reusable space for symbols which are rewritten before being written
+        std::string scratch_string;
+
+    public:
+        // output iterator for microfmt
+        class iterator {
+            format_buffer* buffer;
+        public:
+            using iterator_category = std::output_iterator_tag;
+            using value_type = void;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = void;
+
+            explicit iterator(format_buffer& buffer) : buffer(&buffer) {}
+            iterator& operator=(char c) {
+                buffer->put(c);
+                return *this;
+            }
+            iterator& operator*() {
+                return *this;
+            }
+            iterator& operator++() {
+                return *this;
+            }
+            iterator& operator++(int) {
+                return *this;
+            }
         };
-        detail::replace_all_template(symbol, default_delete);
-        // replace std::__cxx11 -> std:: for gcc dual abi
-        // https://gcc.gnu.org/onlinedocs/libstdc++/manual/using_dual_abi.html
-        detail::replace_all_dynamic(symbol, "std::__cxx11::", "std::");
-        return symbol;
-    }
+
+        explicit format_buffer(format_sink& sink) : sink(sink) {}
+        format_buffer(const format_buffer&) = delete;
+        format_buffer& operator=(const format_buffer&) = delete;
+
+        void put(char c) {
+            if(used == sizeof(buffer)) {
+                flush();
+            }
+            buffer[used++] = c;
+            total++;
+        }
+
+        void write(string_view str) {
+            if(str.size() > sizeof(buffer) - used) {
+                flush();
+                if(str.size() >= sizeof(buffer)) {
+                    sink.write(str.data(), str.size());
+                    total += str.size();
+                    return;
+                }
+            }
+            std::memcpy(buffer + used, str.data(), str.size());
+            used += str.size();
+            total += str.size();
+        }
+
+        template<typename... Args>
+        void print(const char* fmt, Args&&... args) {
+            microfmt::format_to(iterator(*this), fmt, std::forward<Args>(args)...);
+        }
+
+        void flush() {
+            if(used != 0) {
+                sink.write(buffer, used);
+                used = 0;
+            }
+        }
+
+        // number of characters produced so far
+        std::size_t size() const {
+            return total;
+        }
+
+        std::string& scratch() {
+            return scratch_string;
+        }
+    };
+
+    class string_format_sink : public format_sink {
+        std::string& str;
+    public:
+        explicit string_format_sink(std::string& str) : str(str) {}
+        void write(const char* data, std::size_t size) override {
+            str.append(data, size);
+        }
+    };
+
+    class ostream_format_sink : public format_sink {
+        std::ostream& stream;
+    public:
+        explicit ostream_format_sink(std::ostream& stream) : stream(stream) {}
+        void write(const char* data, std::size_t size) override {
+            stream.write(data, static_cast<std::streamsize>(size));
+        }
+    };
+
+    class file_format_sink : public format_sink {
+        std::FILE* file;
+    public:
+        explicit file_format_sink(std::FILE* file) : file(file) {}
+        void write(const char* data, std::size_t size) override {
+            std::fwrite(data, 1, size, file);
+        }
+    };
+
+    class fd_format_sink : public format_sink {
+        int fd;
+        std::size_t written = 0;
+    public:
+        explicit fd_format_sink(int fd) : fd(fd) {}
+        void write(const char* data, std::size_t size) override {
+            written += write_fd(fd, data, size);
+        }
+        std::size_t bytes_written() const {
+            return written;
+        }
+    };
+}
 
     class formatter::impl {
         struct {
@@ -71,6 +162,7 @@ CPPTRACE_BEGIN_NAMESPACE
             symbol_mode symbols = symbol_mode::full;
             bool show_filtered_frames = true;
             bool hide_exception_machinery = true;
+            resolution_level resolution = resolution_level::full_with_inlines;
             std::function<bool(const stacktrace_frame&)> filter;
             std::function<stacktrace_frame(stacktrace_frame)> transform;
         } options;
@@ -115,21 +207,43 @@ CPPTRACE_BEGIN_NAMESPACE
         void hide_exception_machinery(bool do_hide) {
             options.hide_exception_machinery = do_hide;
         }
+        void resolution(resolution_level level) {
+            options.resolution = level;
+        }
 
         std::string format(
             const stacktrace_frame& frame,
             detail::optional<bool> color_override = detail::nullopt,
             size_t filename_indent = 0
         ) const {
-            std::ostringstream oss;
-            print_internal(oss, frame, color_override.value_or(options.color == color_mode::always), filename_indent);
-            return std::move(oss).str();
+            std::string str;
+            detail::string_format_sink sink(str);
+            write_to_sink(sink, frame, explicit_color(color_override), filename_indent, false);
+            return str;
         }
 
         std::string format(const stacktrace& trace, detail::optional<bool> color_override = detail::nullopt) const {
-            std::ostringstream oss;
-            print_internal(oss, trace, color_override.value_or(options.color == color_mode::always));
-            return std::move(oss).str();
+            std::string str;
+            detail::string_format_sink sink(str);
+            write_to_sink(sink, trace, explicit_color(color_override), false);
+            return str;
+        }
+
+        std::size_t format_to(
+            detail::format_sink& sink,
+            const stacktrace_frame& frame,
+            detail::optional<bool> color_override = detail::nullopt,
+            size_t filename_indent = 0
+        ) const {
+            return write_to_sink(sink, frame, explicit_color(color_override), filename_indent, false);
+        }
+
+        std::size_t format_to(
+            detail::format_sink& sink,
+            const stacktrace& trace,
+            detail::optional<bool> color_override = detail::nullopt
+        ) const {
+            return write_to_sink(sink, trace, explicit_color(color_override), false);
         }
 
         void print(const stacktrace_frame& frame, detail::optional<bool> color_override = detail::nullopt) const {
@@ -141,8 +255,10 @@ CPPTRACE_BEGIN_NAMESPACE
             detail::optional<bool> color_override = detail::nullopt,
             size_t filename_indent = 0
         ) const {
-            print_internal(stream, frame, color_override, filename_indent);
-            stream << "\n";
+            bool color = should_do_color(stream_is_tty(stream), color_override);
+            maybe_ensure_virtual_terminal_processing(stream_is_tty(stream), color);
+            detail::ostream_format_sink sink(stream);
+            write_to_sink(sink, frame, color, filename_indent, true);
         }
         void print(
             std::FILE* file,
@@ -150,9 +266,21 @@ CPPTRACE_BEGIN_NAMESPACE
             detail::optional<bool> color_override = detail::nullopt,
             size_t filename_indent = 0
         ) const {
-            auto str = format(frame, color_override, filename_indent);
-            str += "\n";
-            std::fwrite(str.data(), 1, str.size(), file);
+            detail::file_format_sink sink(file);
+            write_to_sink(sink, frame, explicit_color(color_override), filename_indent, true);
+        }
+        std::size_t print(
+            int fd,
+            const stacktrace_frame& frame,
+            detail::optional<bool> color_override = detail::nullopt,
+            size_t filename_indent = 0
+        ) const {
+            bool is_tty = detail::isatty(fd);
+            bool color = should_do_color(is_tty, color_override);
+            maybe_ensure_virtual_terminal_processing(is_tty, color);
+            detail::fd_format_sink sink(fd);
+            write_to_sink(sink, frame, color, filename_indent, true);
+            return sink.bytes_written();
         }
 
         void print(const stacktrace& trace, detail::optional<bool> color_override = detail::nullopt) const {
@@ -163,17 +291,71 @@ CPPTRACE_BEGIN_NAMESPACE
             const stacktrace& trace,
             detail::optional<bool> color_override = detail::nullopt
         ) const {
-            print_internal(stream, trace, color_override);
-            stream << "\n";
+            bool color = should_do_color(stream_is_tty(stream), color_override);
+            maybe_ensure_virtual_terminal_processing(stream_is_tty(stream), color);
+            detail::ostream_format_sink sink(stream);
+            write_to_sink(sink, trace, color, true);
         }
         void print(
             std::FILE* file,
             const stacktrace& trace,
             detail::optional<bool> color_override = detail::nullopt
         ) const {
-            auto str = format(trace, color_override);
-            str += "\n";
-            std::fwrite(str.data(), 1, str.size(), file);
+            detail::file_format_sink sink(file);
+            write_to_sink(sink, trace, explicit_color(color_override), true);
+        }
+        std::size_t print(
+            int fd,
+            const stacktrace& trace,
+            detail::optional<bool> color_override = detail::nullopt
+        ) const {
+            bool is_tty = detail::isatty(fd);
+            bool color = should_do_color(is_tty, color_override);
+            maybe_ensure_virtual_terminal_processing(is_tty, color);
+            detail::fd_format_sink sink(fd);
+            write_to_sink(sink, trace, color, true);
+            return sink.bytes_written();
+        }
+
+        template<typename T>
+        std::string format_unresolved(const T& trace, detail::optional<bool> color_override = detail::nullopt) const {
+            return format(trace.resolve(options.resolution), color_override);
+        }
+        template<typename T>
+        std::size_t format_to_unresolved(
+            detail::format_sink& sink,
+            const T& trace,
+            detail::optional<bool> color_override = detail::nullopt
+        ) const {
+            return format_to(sink, trace.resolve(options.resolution), color_override);
+        }
+        template<typename T>
+        void print_unresolved(const T& trace, detail::optional<bool> color_override = detail::nullopt) const {
+            print(trace.resolve(options.resolution), color_override);
+        }
+        template<typename T>
+        void print_unresolved(
+            std::ostream& stream,
+            const T& trace,
+            detail::optional<bool> color_override = detail::nullopt
+        ) const {
+            print(stream, trace.resolve(options.resolution), color_override);
+        }
+        template<typename T>
+        void print_unresolved(
+            std::FILE* file,
+            const T& trace,
+            detail::optional<bool> color_override = detail::nullopt
+        ) const {
+            print(file, trace.resolve(options.resolution), color_override);
+        }
+        template<typename T>
+        std::size_t print_unresolved(
+            int fd,
+            const T& trace,
+            detail::optional<bool> color_override = detail::nullopt
+        ) const {
+            return print(fd, trace.resolve(options.resolution), color_override);
         }
 
     private:
@@ -200,18 +382,23 @@ CPPTRACE_BEGIN_NAMESPACE
                 || (&stream == &std::cerr && isatty(stderr_fileno));
         }
 
-        void maybe_ensure_virtual_terminal_processing(std::ostream& stream, bool color) const {
-            if(color && stream_is_tty(stream)) {
+        void maybe_ensure_virtual_terminal_processing(bool is_tty, bool color) const {
+            if(color && is_tty) {
                 detail::enable_virtual_terminal_processing_if_needed();
             }
         }
 
-        bool should_do_color(std::ostream& stream, detail::optional<bool> color_override) const {
+        // color setting when not writing to a terminal
+        bool explicit_color(detail::optional<bool> color_override) const {
+            return color_override.value_or(options.color == color_mode::always);
+        }
+
+        bool should_do_color(bool is_tty, detail::optional<bool> color_override) const {
             bool do_color = options.color == color_mode::always || color_override.value_or(false);
             if(
                 (options.color == color_mode::automatic || options.color == color_mode::always) &&
                 (!color_override || color_override.unwrap() != false) &&
-                stream_is_tty(stream)
+                is_tty
             ) {
                 do_color = true;
             }
@@ -237,31 +424,45 @@ CPPTRACE_BEGIN_NAMESPACE
             return it == trace.end() ? 0 : it - trace.begin() + 1;
         }
 
-        void print_internal(std::ostream& stream, const stacktrace_frame& input_frame, detail::optional<bool> color_override, size_t col_indent) const {
-            bool color = should_do_color(stream, color_override);
-            maybe_ensure_virtual_terminal_processing(stream, color);
+        std::size_t write_to_sink(
+            detail::format_sink& sink,
+            const stacktrace_frame& input_frame,
+            bool color,
+            size_t col_indent,
+            bool newline
+        ) const {
+            detail::format_buffer out(sink);
             detail::optional<stacktrace_frame> transformed_frame;
             if(options.transform) {
                 transformed_frame = options.transform(input_frame);
             }
             const stacktrace_frame& frame = options.transform ? transformed_frame.unwrap() : input_frame;
-            write_frame(stream, frame, color, col_indent);
+            write_frame(out, frame, color, col_indent);
+            if(newline) {
+                out.put('\n');
+            }
+            out.flush();
+            return out.size();
         }
 
-        void print_internal(std::ostream& stream, const stacktrace& trace, detail::optional<bool> color_override) const {
-            bool color = should_do_color(stream, color_override);
-            maybe_ensure_virtual_terminal_processing(stream, color);
-            write_trace(stream, trace, color);
+        std::size_t write_to_sink(detail::format_sink& sink, const stacktrace& trace, bool color, bool newline) const {
+            detail::format_buffer out(sink);
+            write_trace(out, trace, color);
+            if(newline) {
+                out.put('\n');
+            }
+            out.flush();
+            return out.size();
         }
 
-
-        void write_trace(std::ostream& stream, const stacktrace& trace, bool color) const {
+        void write_trace(detail::format_buffer& out, const stacktrace& trace, bool color) const {
             if(!options.header.empty()) {
-                stream << options.header << '\n';
+                out.write(options.header);
+                out.put('\n');
             }
             const auto& frames = trace.frames;
             if(frames.empty()) {
-                stream << "<empty trace>";
+                out.write("<empty trace>");
                 return;
             }
             const auto frame_number_width = detail::n_digits(static_cast<int>(frames.size()) - 1);
@@ -278,11 +479,11 @@ CPPTRACE_BEGIN_NAMESPACE
                     continue;
                 }
 
-                size_t filename_indent = write_frame_number(stream, frame_number_width, counter);
+                size_t filename_indent = write_frame_number(out, frame_number_width, counter);
                 if(filter_out_frame) {
-                    microfmt::print(stream, "(filtered)");
+                    out.write("(filtered)");
                 } else {
-                    write_frame(stream, frame, color, filename_indent);
+                    write_frame(out, frame, color, filename_indent);
                     if(frame.line.has_value() && !frame.filename.empty() && options.snippets) {
                         auto snippet = detail::get_snippet(
                             frame.filename,
@@ -292,92 +493,121 @@ CPPTRACE_BEGIN_NAMESPACE
                             color
                         );
                         if(!snippet.empty()) {
-                            stream << '\n';
-                            stream << snippet;
+                            out.put('\n');
+                            out.write(snippet);
                         }
                     }
                 }
                 if(i + 1 != frames.size()) {
-                    stream << '\n';
+                    out.put('\n');
                 }
                 counter++;
             }
         }
 
         /// Write the frame number, and return the number of characters written
-        size_t write_frame_number(std::ostream& stream, unsigned int frame_number_width, size_t counter) const
+        size_t write_frame_number(detail::format_buffer& out, unsigned int frame_number_width, size_t counter) const
         {
-            microfmt::print(stream, "#{<{}} ", frame_number_width, counter);
+            out.print("#{<{}} ", frame_number_width, counter);
             return 2 + frame_number_width;
         }
 
-        void write_frame(std::ostream& stream, const stacktrace_frame& frame, color_setting color, size_t col) const {
-            col += write_address(stream, frame, color);
+        void write_frame(
+            detail::format_buffer& out,
+            const stacktrace_frame& frame,
+            color_setting color,
+            size_t col
+        ) const {
+            col += write_address(out, frame, color);
             if(frame.is_inline || options.addresses != address_mode::none) {
-                stream << ' ';
+                out.put(' ');
                 col += 1;
             }
             if(!frame.symbol.empty()) {
-                write_symbol(stream, frame, color);
+                write_symbol(out, frame, color);
             }
             if(!frame.symbol.empty() && !frame.filename.empty()) {
                 if(options.break_before_filename) {
-                    microfmt::print(stream, "\n{<{}}", col, "");
+                    out.print("\n{<{}}", col, "");
                 } else {
-                    stream << ' ';
+                    out.put(' ');
                 }
             }
             if(!frame.filename.empty()) {
-                write_source_location(stream, frame, color);
+                write_source_location(out, frame, color);
             }
         }
 
         /// Write the address of the frame, return the number of characters written
-        size_t write_address(std::ostream& stream, const stacktrace_frame& frame, color_setting color) const {
+        size_t write_address(detail::format_buffer& out, const stacktrace_frame& frame, color_setting color) const {
             if(frame.is_inline) {
-                microfmt::print(stream, "{<{}}", 2 * sizeof(frame_ptr) + 2, "(inlined)");
+                out.print("{<{}}", 2 * sizeof(frame_ptr) + 2, "(inlined)");
                 return 2 * sizeof(frame_ptr) + 2;
             } else if(options.addresses != address_mode::none) {
                 auto address = options.addresses == address_mode::raw ? frame.raw_address : frame.object_address;
-                microfmt::print(stream, "{}0x{>{}:0h}{}", color.blue(), 2 * sizeof(frame_ptr), address, color.reset());
+                out.print("{}0x{>{}:0h}{}", color.blue(), 2 * sizeof(frame_ptr), address, color.reset());
                 return 2 * sizeof(frame_ptr) + 2;
             }
             return 0;
         }
 
-        void write_symbol(std::ostream& stream, const stacktrace_frame& frame, color_setting color) const {
-            detail::optional<std::string> maybe_stored_string;
+        void write_symbol(detail::format_buffer& out, const stacktrace_frame& frame, color_setting color) const {
+            // Symbols are left mangled if the trace was resolved while lazy demangling was enabled, which may not be the
+            // current setting. demangled_symbol() leaves names which aren't mangled alone so it's used for every frame.
+            detail::optional<std::string> demangled;
+            const auto get_full_symbol = [&] () -> const std::string& {
+                if(!demangled) {
+                    demangled = frame.demangled_symbol();
+                }
+                return demangled.unwrap();
+            };
+            // pruned and prettified symbols are built in the buffer's scratch string, which is reused across frames
+            std::string& scratch = out.scratch();
+            scratch.clear();
             detail::string_view symbol;
-            switch(options.symbols) {
-                case symbol_mode::full:
-                    symbol = frame.symbol;
-                    break;
-                case symbol_mode::pruned:
-                    maybe_stored_string = prune_symbol(frame.symbol);
-                    symbol = maybe_stored_string.unwrap();
-                    break;
-                case symbol_mode::pretty:
-                    maybe_stored_string = prettify_symbol(frame.symbol);
-                    symbol = maybe_stored_string.unwrap();
-                    break;
-                default:
-                    PANIC("Unhandled symbol mode");
+            try {
+                switch(options.symbols) {
+                    case symbol_mode::full:
+                        symbol = get_full_symbol();
+                        break;
+                    case symbol_mode::pruned:
+                        // pruning can usually be done straight from a mangled name, skipping the demangler
+                        {
+                            auto pruned = detail::prune_mangled_symbol(frame.symbol);
+                            if(pruned) {
+                                scratch += pruned.unwrap();
+                            }
+                        }
+                        if(scratch.empty()) {
+                            detail::prune_symbol_into(get_full_symbol(), scratch);
+                        }
+                        symbol = scratch;
+                        break;
+                    case symbol_mode::pretty:
+                        detail::prettify_symbol_into(get_full_symbol(), scratch);
+                        symbol = scratch;
+                        break;
+                    default:
+                        PANIC("Unhandled symbol mode");
+                }
+            } catch(...) {
+                detail::log_and_maybe_propagate_exception(std::current_exception());
+                symbol = get_full_symbol();
             }
-            microfmt::print(stream, "in {}{}{}", color.yellow(), symbol, color.reset());
+            out.print("in {}{}{}", color.yellow(), symbol, color.reset());
         }
 
-        void write_source_location(std::ostream& stream, const stacktrace_frame& frame, color_setting color) const {
-            microfmt::print(
-                stream,
+        void write_source_location(detail::format_buffer& out, const stacktrace_frame& frame, color_setting color) const {
+            out.print(
                 "at {}{}{}",
                 color.green(),
                 options.paths == path_mode::full ? frame.filename : detail::basename(frame.filename, true),
                 color.reset()
             );
             if(frame.line.has_value()) {
-                microfmt::print(stream, ":{}{}{}", color.blue(), frame.line.value(), color.reset());
+                out.print(":{}{}{}", color.blue(), frame.line.value(), color.reset());
                 if(frame.column.has_value() && options.columns) {
-                    microfmt::print(stream, ":{}{}{}", color.blue(), frame.column.value(), color.reset());
+                    out.print(":{}{}{}", color.blue(), frame.column.value(), color.reset());
                 }
             }
         }
@@ -457,6 +687,10 @@ CPPTRACE_BEGIN_NAMESPACE
         pimpl->hide_exception_machinery(do_hide);
         return *this;
     }
+    formatter& formatter::resolution(resolution_level level) {
+        pimpl->resolution(level);
+        return *this;
+    }
 
     std::string formatter::format(const stacktrace_frame& frame) const {
         return pimpl->format(frame);
@@ -494,6 +728,58 @@ CPPTRACE_BEGIN_NAMESPACE
         pimpl->print(file, trace, color);
     }
 
+    std::string formatter::format(const raw_trace& trace) const {
+        return pimpl->format_unresolved(trace);
+    }
+    std::string formatter::format(const raw_trace& trace, bool color) const {
+        return pimpl->format_unresolved(trace, color);
+    }
+
+    void formatter::print(const raw_trace& trace) const {
+        pimpl->print_unresolved(trace);
+    }
+    void formatter::print(const raw_trace& trace, bool color) const {
+        pimpl->print_unresolved(trace, color);
+    }
+    void formatter::print(std::ostream& stream, const raw_trace& trace) const {
+        pimpl->print_unresolved(stream, trace);
+    }
+    void formatter::print(std::ostream& stream, const raw_trace& trace, bool color) const {
+        pimpl->print_unresolved(stream, trace, color);
+    }
+    void formatter::print(std::FILE* file, const raw_trace& trace) const {
+        pimpl->print_unresolved(file, trace);
+    }
+    void formatter::print(std::FILE* file, const raw_trace& trace, bool color) const {
+        pimpl->print_unresolved(file, trace, color);
+    }
+
+    std::string formatter::format(const object_trace& trace) const {
+        return pimpl->format_unresolved(trace);
+    }
+    std::string formatter::format(const object_trace& trace, bool color) const {
+        return pimpl->format_unresolved(trace, color);
+    }
+
+    void formatter::print(const object_trace& trace) const {
+        pimpl->print_unresolved(trace);
+    }
+    void formatter::print(const object_trace& trace, bool color) const {
+        pimpl->print_unresolved(trace, color);
+    }
+    void formatter::print(std::ostream& stream, const object_trace& trace) const {
+        pimpl->print_unresolved(stream, trace);
+    }
+    void formatter::print(std::ostream& stream, const object_trace& trace, bool color) const {
+        pimpl->print_unresolved(stream, trace, color);
+    }
+    void formatter::print(std::FILE* file, const object_trace& trace) const {
+        pimpl->print_unresolved(file, trace);
+    }
+    void formatter::print(std::FILE* file, const object_trace& trace, bool color) const {
+        pimpl->print_unresolved(file, trace, color);
+    }
+
     void formatter::print(const stacktrace_frame& frame) const {
         pimpl->print(frame);
     }
@@ -519,6 +805,64 @@ CPPTRACE_BEGIN_NAMESPACE
         pimpl->print(file, frame, color, filename_indent);
     }
 
+    std::size_t formatter::print(int fd, const stacktrace_frame& frame) const {
+        return pimpl->print(fd, frame);
+    }
+    std::size_t formatter::print(int fd, const stacktrace_frame& frame, bool color) const {
+        return pimpl->print(fd, frame, color);
+    }
+    std::size_t formatter::print(int fd, const stacktrace_frame& frame, bool color, size_t filename_indent) const {
+        return pimpl->print(fd, frame, color, filename_indent);
+    }
+    std::size_t formatter::print(int fd, const stacktrace& trace) const {
+        return pimpl->print(fd, trace);
+    }
+    std::size_t formatter::print(int fd, const stacktrace& trace, bool color) const {
+        return pimpl->print(fd, trace, color);
+    }
+    std::size_t formatter::print(int fd, const raw_trace& trace) const {
+        return pimpl->print_unresolved(fd, trace);
+    }
+    std::size_t formatter::print(int fd, const raw_trace& trace, bool color) const {
+        return pimpl->print_unresolved(fd, trace, color);
+    }
+    std::size_t formatter::print(int fd, const object_trace& trace) const {
+        return pimpl->print_unresolved(fd, trace);
+    }
+    std::size_t formatter::print(int fd, const object_trace& trace, bool color) const {
+        return pimpl->print_unresolved(fd, trace, color);
+    }
+
+    std::size_t formatter::format_to_sink(detail::format_sink& sink, const stacktrace_frame& frame) const {
+        return pimpl->format_to(sink, frame);
+    }
+    std::size_t formatter::format_to_sink(
+        detail::format_sink& sink,
+        const stacktrace_frame& frame,
+        bool color,
+        size_t indent
+    ) const {
+        return pimpl->format_to(sink, frame, color, indent);
+    }
+    std::size_t formatter::format_to_sink(detail::format_sink& sink, const stacktrace& trace) const {
+        return pimpl->format_to(sink, trace);
+    }
+    std::size_t formatter::format_to_sink(detail::format_sink& sink, const stacktrace& trace, bool color) const {
+        return pimpl->format_to(sink, trace, color);
+    }
+    std::size_t formatter::format_to_sink(detail::format_sink& sink, const raw_trace& trace) const {
+        return pimpl->format_to_unresolved(sink, trace);
+    }
+    std::size_t formatter::format_to_sink(detail::format_sink& sink, const raw_trace& trace, bool color) const {
+        return pimpl->format_to_unresolved(sink, trace, color);
+    }
+    std::size_t formatter::format_to_sink(detail::format_sink& sink, const object_trace& trace) const {
+        return pimpl->format_to_unresolved(sink, trace);
+    }
+    std::size_t formatter::format_to_sink(detail::format_sink& sink, const object_trace& trace, bool color) const {
+        return pimpl->format_to_unresolved(sink, trace, color);
+    }
+
     const formatter& get_default_formatter() {
         static formatter formatter;
         return formatter;
@@ -11,6 +11,7 @@
 #include "utils/error.hpp"
 #include "utils/microfmt.hpp"
 #include "utils/utils.hpp"
+#include "capture_policy.hpp"
 #include "logging.hpp"
 #include "unwind/unwind.hpp"
 
@@ -28,11 +29,11 @@ namespace detail {
         return rethrow_switch;
     }
 
-    void save_current_trace(raw_trace trace) {
+    void save_current_trace(raw_trace trace, bool sampled_out = false) {
         if(get_rethrow_switch()) {
-            saved_rethrow_trace = lazy_trace_holder(std::move(trace));
+            saved_rethrow_trace = lazy_trace_holder(std::move(trace), sampled_out);
         } else {
-            current_exception_trace = lazy_trace_holder(std::move(trace));
+            current_exception_trace = lazy_trace_holder(std::move(trace), sampled_out);
             saved_rethrow_trace = lazy_trace_holder();
         }
     }
@@ -40,6 +41,10 @@ namespace detail {
     #if defined(_MSC_VER) && defined(CPPTRACE_UNWIND_WITH_DBGHELP)
      CPPTRACE_FORCE_NO_INLINE void collect_current_trace(std::size_t skip, EXCEPTION_POINTERS* exception_ptrs) {
          try {
+             if(!should_capture(skip + 1, true)) {
+                 save_current_trace(raw_trace{}, true);
+                 return;
+             }
              #if defined(_M_IX86) || defined(__i386__)
               (void)skip; // don't skip any frames, the context record is at the throw point
               auto trace = raw_trace{detail::capture_frames(0, SIZE_MAX, exception_ptrs)};
@@ -55,6 +60,10 @@ namespace detail {
     #else
      CPPTRACE_FORCE_NO_INLINE void collect_current_trace(std::size_t skip) {
          try {
+             if(!should_capture(skip + 1, true)) {
+                 save_current_trace(raw_trace{}, true);
+                 return;
+             }
              auto trace = raw_trace{detail::capture_frames(skip + 1, SIZE_MAX)};
              save_current_trace(std::move(trace));
          } catch(...) {
@@ -426,6 +435,9 @@ CPPTRACE_BEGIN_NAMESPACE
     }
 
     bool current_exception_was_rethrown() {
+        if(detail::saved_rethrow_trace.is_sampled_out()) {
+            return true;
+        }
         if(detail::saved_rethrow_trace.is_resolved()) {
             return !detail::saved_rethrow_trace.get_resolved_trace().empty();
         } else {
@@ -433,6 +445,10 @@ CPPTRACE_BEGIN_NAMESPACE
         }
     }
 
+    bool current_exception_was_sampled_out() {
+        return detail::current_exception_trace.is_sampled_out();
+    }
+
     // The non-argument overload is to serve as room for possible future optimization under Microsoft's STL
     CPPTRACE_FORCE_NO_INLINE void rethrow() {
         auto guard = detail::setup_rethrow();
@@ -1,9 +1,13 @@
 #include "jit/jit_objects.hpp"
 
+#include <cpptrace/gdb_jit.hpp>
+
 #include "cpptrace/forward.hpp"
 #include "utils/error.hpp"
 #include "utils/optional.hpp"
 #include "utils/span.hpp"
+#include "utils/atomic_shared_ptr.hpp"
+#include "utils/persistent_interval_map.hpp"
 #include "binary/elf.hpp"
 #include "binary/mach-o.hpp"
 
@@ -11,32 +15,49 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
     #if IS_LINUX || IS_APPLE
+    // Lookups don't take a lock: they read an immutable snapshot of the range index (RCU-style) while registration
+    // and unregistration are serialized and publish a new snapshot. Updates to the index are O(log n) per range.
     class jit_object_manager {
-        struct object_entry {
+        struct range_value {
             const char* object_start;
-            std::unique_ptr<jit_object_type> object;
+            std::shared_ptr<jit_object_entry> entry;
         };
-        std::vector<object_entry> objects;
+        using range_index = persistent_interval_map<range_value>;
+        atomic_shared_ptr<const range_index> ranges{std::make_shared<const range_index>()};
 
-        struct range_entry {
-            frame_ptr low;
-            frame_ptr high; // not inclusive
-            const char* object_start;
-            jit_object_type* object;
-            bool operator<(const range_entry& other) const {
-                return low < other.low;
-            }
+        struct object_entry {
+            std::shared_ptr<jit_object_entry> entry;
+            std::vector<jit_object_type::pc_range> ranges;
         };
-        // TODO: Maybe use a set...
-        std::vector<range_entry> range_list;
+        std::mutex write_mutex;
+        std::unordered_map<const char*, object_entry> objects;
+
+        // must be called with the write lock held
+        void remove_locked(range_index& index, const char* ptr) {
+            auto it = objects.find(ptr);
+            if(it == objects.end()) {
+                return;
+            }
+            for(const auto& range : it->second.ranges) {
+                index = index.erase_if(
+                    range.low,
+                    [ptr] (const range_value& value) { return value.object_start == ptr; }
+                );
+            }
+            objects.erase(it);
+        }
 
     public:
         void add_jit_object(cbspan object) {
+            // parsing is done before taking the lock
             auto object_res = jit_object_type::open(object);
             if(object_res.is_error()) {
                 if(!should_absorb_trace_exceptions()) {
@@ -44,66 +65,50 @@ namespace detail {
                 }
                 return;
             }
-            objects.push_back({object.data(), make_unique<jit_object_type>(std::move(object_res).unwrap_value())});
-            auto* object_file = objects.back().object.get();
-            auto ranges_res = object_file->get_pc_ranges();
+            auto entry = std::make_shared<jit_object_entry>(
+                jit_object_entry{std::move(object_res).unwrap_value(), object, nullptr}
+            );
+            auto ranges_res = entry->object.get_pc_ranges();
             if(ranges_res.is_error()) {
                 if(!should_absorb_trace_exceptions()) {
                     ranges_res.drop_error();
                 }
                 return;
             }
-            auto& ranges = ranges_res.unwrap_value();
-            for(auto range : ranges) {
-                range_entry entry{range.low, range.high, object.data(), object_file};
-                // TODO: Perf
-                range_list.insert(std::upper_bound(range_list.begin(), range_list.end(), entry), entry);
+            auto& object_ranges = ranges_res.unwrap_value();
+            std::lock_guard<std::mutex> lock(write_mutex);
+            range_index index = *ranges.load();
+            // re-registration of the same object replaces it
+            remove_locked(index, object.data());
+            for(const auto& range : object_ranges) {
+                index = index.insert(range.low, range.high, range_value{object.data(), entry});
             }
+            objects.emplace(object.data(), object_entry{std::move(entry), std::move(object_ranges)});
+            ranges.store(std::make_shared<const range_index>(std::move(index)));
         }
 
         void remove_jit_object(const char* ptr) {
-            // TODO: Perf
-            objects.erase(
-                std::remove_if(
-                    objects.begin(),
-                    objects.end(),
-                    [&](const object_entry& entry) { return entry.object_start == ptr; }
-                ),
-                objects.end()
-            );
-            range_list.erase(
-                std::remove_if(
-                    range_list.begin(),
-                    range_list.end(),
-                    [&](const range_entry& entry) { return entry.object_start == ptr; }
-                ),
-                range_list.end()
-            );
+            std::lock_guard<std::mutex> lock(write_mutex);
+            range_index index = *ranges.load();
+            remove_locked(index, ptr);
+            ranges.store(std::make_shared<const range_index>(std::move(index)));
         }
 
         optional<jit_object_lookup_result> lookup(frame_ptr pc) const {
-            auto it = first_less_than_or_equal(
-                range_list.begin(),
-                range_list.end(),
-                pc,
-                [](frame_ptr pc, const range_entry& entry) {
-                    return pc < entry.low;
-                }
-            );
-            if(it == range_list.end()) {
-                return nullopt;
-            }
-            ASSERT(pc >= it->low);
-            if(pc < it->high) {
-                return jit_object_lookup_result{*it->object, it->low};
-            } else {
+            // the snapshot is kept alive until we've copied out what we need
+            const auto snapshot = ranges.load();
+            const auto* entry = snapshot->find(pc);
+            if(!entry) {
                 return nullopt;
             }
+            ASSERT(pc >= entry->low && pc < entry->high);
+            return jit_object_lookup_result{entry->value.entry, entry->low};
         }
 
         void clear_all_jit_objects() {
+            std::lock_guard<std::mutex> lock(write_mutex);
+            ranges.store(std::make_shared<const range_index>());
             objects.clear();
-            range_list.clear();
         }
     };
     #else
@@ -130,11 +135,43 @@ namespace detail {
         manager.remove_jit_object(ptr);
     }
 
+    struct gdb_jit_state {
+        std::mutex mutex;
+        gdb_jit_registrations registrations;
+    };
+
+    gdb_jit_state& get_gdb_jit_state() {
+        static gdb_jit_state state;
+        return state;
+    }
+
     void clear_all_jit_objects() {
+        auto& state = get_gdb_jit_state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.registrations.clear();
         auto& manager = get_jit_object_manager();
         manager.clear_all_jit_objects();
     }
 
+    void handle_gdb_jit_event(std::uint32_t action_flag, const jit_code_entry* relevant_entry) {
+        if(!relevant_entry) {
+            return;
+        }
+        auto& state = get_gdb_jit_state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if(action_flag == JIT_REGISTER_FN) {
+            state.registrations.add(relevant_entry, register_jit_object);
+        } else if(action_flag == JIT_UNREGISTER_FN) {
+            state.registrations.remove(relevant_entry, unregister_jit_object);
+        }
+    }
+
+    void sync_jit_objects_from_gdb_entries(const jit_code_entry* first_entry) {
+        auto& state = get_gdb_jit_state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.registrations.sync(first_entry, register_jit_object, unregister_jit_object);
+    }
+
     #if IS_LINUX || IS_APPLE
     optional<jit_object_lookup_result> lookup_jit_object(frame_ptr pc) {
         return get_jit_object_manager().lookup(pc);
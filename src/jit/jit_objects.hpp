@@ -1,26 +1,98 @@
 #ifndef JIT_OBJECTS_HPP
 #define JIT_OBJECTS_HPP
 
+#include <cpptrace/gdb_jit.hpp>
+
 #include "binary/elf.hpp"
 #include "binary/mach-o.hpp"
 #include "cpptrace/forward.hpp"
 #include "utils/optional.hpp"
+#include "utils/span.hpp"
 #include "platform/platform.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
 CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
     void register_jit_object(const char*, std::size_t);
     void unregister_jit_object(const char*);
     void clear_all_jit_objects();
 
+    // Tracks objects registered through the gdb jit interface so that syncs only parse new entries. A jit can free an
+    // object and allocate a new one at the same address between syncs, so an entry is identified by the entry's
+    // address along with its object's address and size. An object replaced in place by one of the same size through
+    // the same entry can't be told apart.
+    class gdb_jit_registrations {
+        struct registration {
+            const jit_code_entry* entry;
+            std::uint64_t size;
+        };
+        std::unordered_map<const char*, registration> registered;
+
+    public:
+        // register_object(const char*, std::size_t) replaces any object previously registered at the same address
+        template<typename R>
+        void add(const jit_code_entry* entry, R&& register_object) {
+            register_object(entry->symfile_addr, static_cast<std::size_t>(entry->symfile_size));
+            registered[entry->symfile_addr] = registration{entry, entry->symfile_size};
+        }
+
+        template<typename U>
+        void remove(const jit_code_entry* entry, U&& unregister_object) {
+            unregister_object(entry->symfile_addr);
+            registered.erase(entry->symfile_addr);
+        }
+
+        // O(live entries): registers new or changed entries and unregisters entries no longer in the list
+        template<typename R, typename U>
+        void sync(const jit_code_entry* first_entry, R&& register_object, U&& unregister_object) {
+            std::unordered_set<const char*> live;
+            for(const auto* entry = first_entry; entry; entry = entry->next_entry) {
+                live.insert(entry->symfile_addr);
+                auto it = registered.find(entry->symfile_addr);
+                if(it == registered.end() || it->second.entry != entry || it->second.size != entry->symfile_size) {
+                    add(entry, register_object);
+                }
+            }
+            for(auto it = registered.begin(); it != registered.end(); ) {
+                if(live.count(it->first) == 0) {
+                    unregister_object(it->first);
+                    it = registered.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        void clear() {
+            registered.clear();
+        }
+
+        std::size_t size() const {
+            return registered.size();
+        }
+    };
+
     #if IS_LINUX || IS_APPLE
     #if IS_LINUX
      using jit_object_type = elf;
     #elif IS_APPLE
      using jit_object_type = mach_o;
     #endif
+    struct jit_object_entry {
+        jit_object_type object;
+        cbspan data;
+        // Symbol back-end state for the object (e.g. a dwarf resolver), created lazily by the back-end and only
+        // accessed under its lock. Torn down along with the entry once the object is unregistered.
+        std::shared_ptr<void> resolver;
+    };
     struct jit_object_lookup_result {
-        jit_object_type& object;
+        // shared ownership so the entry outlives a concurrent unregister_jit_object
+        std::shared_ptr<jit_object_entry> entry;
         frame_ptr base;
     };
     optional<jit_object_lookup_result> lookup_jit_object(frame_ptr pc);
@@ -9,6 +9,7 @@ namespace detail {
     std::atomic_bool absorb_trace_exceptions(true); // NOSONAR
     std::atomic_bool resolve_inlined_calls(true); // NOSONAR
     std::atomic<cache_mode> current_cache_mode(cache_mode::prioritize_speed); // NOSONAR
+    std::atomic_bool lazy_demangling(false); // NOSONAR
 
     bool should_absorb_trace_exceptions() {
         return absorb_trace_exceptions;
@@ -21,6 +22,10 @@ namespace detail {
     cache_mode get_cache_mode() {
         return current_cache_mode;
     }
+
+    bool should_demangle_lazily() {
+        return lazy_demangling;
+    }
 }
 CPPTRACE_END_NAMESPACE
 
@@ -37,5 +42,9 @@ CPPTRACE_BEGIN_NAMESPACE
         void set_cache_mode(cache_mode mode) {
             detail::current_cache_mode = mode;
         }
+
+        void enable_lazy_demangling(bool enable) {
+            detail::lazy_demangling = enable;
+        }
     }
 CPPTRACE_END_NAMESPACE
@@ -9,6 +9,7 @@ namespace detail {
     CPPTRACE_EXPORT bool should_absorb_trace_exceptions();
     bool should_resolve_inlined_calls();
     cache_mode get_cache_mode();
+    bool should_demangle_lazily();
 }
 CPPTRACE_END_NAMESPACE
 
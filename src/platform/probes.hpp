@@ -0,0 +1,58 @@
+#ifndef PROBES_HPP
+#define PROBES_HPP
+
+#include <cpptrace/basic.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+// USDT probes for tracing cpptrace itself with bpftrace, perf, systemtap, etc, enabled with CPPTRACE_USDT_PROBES. The
+// provider is "cpptrace". A probe is a single nop when nothing is attached, the only other cost is the timing for the
+// elapsed_ns arguments. With probes disabled all of this compiles away and probe arguments aren't evaluated.
+//
+// Probes, paths and names are strings and everything else is an integer:
+// capture__begin()
+// capture__end(frames, elapsed_ns)
+// object__info(address, object_path, elapsed_ns)
+// resolver__create(object_path, elapsed_ns)
+// cu__cache__build(object_path, ranges, elapsed_ns)
+// line__table__load(object_path, cu_offset, elapsed_ns)
+// frame__resolve(object_path, object_address, elapsed_ns)
+// frames__resolve(backend, frames, elapsed_ns)
+
+#ifdef CPPTRACE_USDT_PROBES
+ #include <sys/sdt.h>
+ #define CPPTRACE_PROBE(name) DTRACE_PROBE(cpptrace, name)
+ #define CPPTRACE_PROBE2(name, a, b) DTRACE_PROBE2(cpptrace, name, a, b)
+ #define CPPTRACE_PROBE3(name, a, b, c) DTRACE_PROBE3(cpptrace, name, a, b, c)
+#else
+ #define CPPTRACE_PROBE(name) static_cast<void>(0)
+ #define CPPTRACE_PROBE2(name, a, b) static_cast<void>(0)
+ #define CPPTRACE_PROBE3(name, a, b, c) static_cast<void>(0)
+#endif
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // Measures the elapsed_ns argument for a probe, does nothing unless probes are enabled
+    class probe_timer {
+        #ifdef CPPTRACE_USDT_PROBES
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        #endif
+    public:
+        // user-provided so that a timer only used for probes doesn't warn when probes are off
+        probe_timer() {}
+
+        std::uint64_t elapsed_ns() const {
+            #ifdef CPPTRACE_USDT_PROBES
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()
+            );
+            #else
+            return 0;
+            #endif
+        }
+    };
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
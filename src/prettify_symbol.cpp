@@ -0,0 +1,268 @@
+#include <cpptrace/utils.hpp>
+
+#include "prettify_symbol.hpp"
+#include "symbol_tokenizer.hpp"
+#include "utils/string_view.hpp"
+#include "utils/utils.hpp"
+
+#include <cctype>
+#include <string>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // Matches text against a prefix of a string, character by character
+    class prefix_matcher {
+        string_view str;
+        std::size_t pos = 0;
+    public:
+        explicit prefix_matcher(string_view str) : str(str) {}
+
+        bool accept(string_view text) {
+            if(text.size() <= str.size() - pos && str.substr(pos, text.size()) == text) {
+                pos += text.size();
+                return true;
+            }
+            return false;
+        }
+
+        // [a-zA-Z0-9_]+
+        bool accept_name() {
+            const auto start = pos;
+            while(pos < str.size() && (std::isalnum(str.data()[pos]) || str.data()[pos] == '_')) {
+                pos++;
+            }
+            return pos != start;
+        }
+
+        bool accept_whitespace() {
+            const auto start = pos;
+            while(pos < str.size() && std::isspace(str.data()[pos])) {
+                pos++;
+            }
+            return pos != start;
+        }
+
+        bool at_identifier_continue() const {
+            return pos < str.size() && is_identifier_continue(str.data()[pos]);
+        }
+
+        std::size_t position() const {
+            return pos;
+        }
+    };
+
+    // Matches std::name< or std::inline_namespace::name< and returns the length of the match, or 0
+    std::size_t match_std_template(string_view str, string_view name, string_view first_argument = "") {
+        const auto matches_rest = [&] (prefix_matcher& matcher) {
+            return matcher.accept("::")
+                && matcher.accept(name)
+                && matcher.accept("<")
+                && (first_argument.empty() || (matcher.accept(first_argument) && !matcher.at_identifier_continue()));
+        };
+        prefix_matcher matcher(str);
+        if(!matcher.accept("std")) {
+            return 0;
+        }
+        auto direct = matcher;
+        if(matches_rest(direct)) {
+            // for first_argument only the template name and < are part of the match
+            return direct.position() - first_argument.size();
+        }
+        if(matcher.accept("::") && matcher.accept_name() && matches_rest(matcher)) {
+            return matcher.position() - first_argument.size();
+        }
+        return 0;
+    }
+
+    struct template_rewrite {
+        const char* name;
+        const char* replacement;
+    };
+
+    constexpr template_rewrite string_rewrites[] = {
+        {"basic_string", "std::string"},
+        {"basic_string_view", "std::string_view"},
+    };
+
+    // Rewrites a demangled symbol into a more readable form:
+    //  - "> >" -> ">>"
+    //  - whitespace around commas is normalized to ", "
+    //  - msvc's class/struct tags are removed and `anonymous namespace' is spelled (anonymous namespace)
+    //  - std::basic_string<char, ...> -> std::string and std::basic_string_view<char, ...> -> std::string_view
+    //  - std::allocator and std::default_delete template arguments are removed
+    //  - std::__cxx11:: -> std:: for gcc's dual abi https://gcc.gnu.org/onlinedocs/libstdc++/manual/using_dual_abi.html
+    // This is done in one pass over the symbol's tokens, whitespace between tokens is carried over unless a rule
+    // applies to it.
+    class symbol_prettifier {
+        string_view source;
+        symbol_tokenizer tokenizer;
+        // end of the last token consumed
+        const char* cursor;
+        // set when the whitespace before the next token is to be dropped
+        bool drop_whitespace = false;
+        std::string& output;
+
+        string_view remaining() const {
+            return {cursor, source.end()};
+        }
+
+        void skip_to(const char* position) {
+            cursor = position;
+            tokenizer = symbol_tokenizer(remaining());
+        }
+
+        // skips from just after a < to just after its matching >, or the end of the symbol
+        void skip_template_arguments(const char* position) {
+            int depth = 1;
+            while(position != source.end() && depth > 0) {
+                if(*position == '<') {
+                    depth++;
+                } else if(*position == '>') {
+                    depth--;
+                }
+                position++;
+            }
+            skip_to(position);
+        }
+
+        void append_whitespace(string_view whitespace, const token& next) {
+            if(drop_whitespace) {
+                drop_whitespace = false;
+                return;
+            }
+            // > > -> >>, this applies to the source text so that e.g. > > > folds to >>>
+            if(whitespace == " " && cursor != source.begin() && cursor[-1] == '>' && next.str.data()[0] == '>') {
+                return;
+            }
+            output += whitespace;
+        }
+
+        void append_msvc_string(string_view str) {
+            // msvc strings like `int main(void)' contain symbols which should be prettified too
+            output += '`';
+            prettify_symbol_into(str.substr(1, str.size() - 2), output);
+            output += '\'';
+        }
+
+        // handles ", std::allocator<...>" and the like, returns true if the comma was consumed
+        bool try_remove_template_argument() {
+            prefix_matcher matcher(remaining());
+            matcher.accept_whitespace();
+            // msvc's class tag
+            auto after_tag = matcher;
+            if((after_tag.accept("class") || after_tag.accept("struct")) && after_tag.accept_whitespace()) {
+                matcher = after_tag;
+            }
+            const auto argument = remaining().substr(matcher.position());
+            for(const auto name : {"allocator", "default_delete"}) {
+                const auto length = match_std_template(argument, name);
+                if(length) {
+                    skip_template_arguments(argument.data() + length);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // handles std::basic_string<char, ...> and the like along with std::__cxx11::, returns true if the std
+        // identifier was consumed
+        bool try_rewrite_std(const token& std_token) {
+            const string_view at_std = {std_token.str.data(), source.end()};
+            for(const auto& rule : string_rewrites) {
+                const auto length = match_std_template(at_std, rule.name, "char");
+                if(length) {
+                    output += rule.replacement;
+                    skip_template_arguments(at_std.data() + length);
+                    return true;
+                }
+            }
+            if(at_std.starts_with("std::__cxx11::")) {
+                output += "std::";
+                skip_to(at_std.data() + sizeof("std::__cxx11::") - 1);
+                return true;
+            }
+            return false;
+        }
+
+        Result<monostate, parse_error> rewrite() {
+            while(true) {
+                TRY_TOK(next, tokenizer.advance());
+                if(!next) {
+                    break;
+                }
+                const auto& token = next.unwrap();
+                const string_view whitespace = {cursor, token.str.data()};
+                const auto token_end = token.str.data() + token.str.size();
+                if(token.type == token_type::punctuation && token.str == ",") {
+                    // whitespace before and after the comma is dropped
+                    cursor = token_end;
+                    drop_whitespace = false;
+                    if(!try_remove_template_argument()) {
+                        output += ", ";
+                        drop_whitespace = true;
+                    }
+                    continue;
+                }
+                if(
+                    token.type == token_type::identifier
+                    && (token.str == "class" || token.str == "struct")
+                    && token_end != source.end()
+                    && std::isspace(*token_end)
+                ) {
+                    append_whitespace(whitespace, token);
+                    cursor = token_end;
+                    drop_whitespace = true;
+                    continue;
+                }
+                append_whitespace(whitespace, token);
+                cursor = token_end;
+                if(token.type == token_type::identifier && token.str == "std") {
+                    if(!try_rewrite_std(token)) {
+                        output += token.str;
+                    }
+                } else if(token.type == token_type::anonymous_namespace) {
+                    output += "(anonymous namespace)";
+                } else if(token.type == token_type::literal && token.str.data()[0] == '`') {
+                    append_msvc_string(token.str);
+                } else {
+                    output += token.str;
+                }
+            }
+            return monostate{};
+        }
+
+    public:
+        symbol_prettifier(string_view source, std::string& output)
+            : source(source), tokenizer(source), cursor(source.begin()), output(output) {
+            output.reserve(output.size() + source.size());
+        }
+
+        void run() {
+            // if the symbol can't be tokenized the rest of it is left as-is
+            rewrite();
+            output.append(cursor, source.end());
+        }
+    };
+
+    void prettify_symbol_into(string_view symbol, std::string& output) {
+        symbol_prettifier(symbol, output).run();
+    }
+
+    std::string prettify_symbol(string_view symbol) {
+        std::string output;
+        prettify_symbol_into(symbol, output);
+        return output;
+    }
+}
+CPPTRACE_END_NAMESPACE
+
+CPPTRACE_BEGIN_NAMESPACE
+    std::string prettify_symbol(std::string symbol) {
+        try {
+            return detail::prettify_symbol(symbol);
+        } catch(...) {
+            detail::log_and_maybe_propagate_exception(std::current_exception());
+            return symbol;
+        }
+    }
+CPPTRACE_END_NAMESPACE
@@ -0,0 +1,17 @@
+#ifndef PRETTIFY_SYMBOL_HPP
+#define PRETTIFY_SYMBOL_HPP
+
+#include <cpptrace/forward.hpp>
+#include "utils/string_view.hpp"
+
+#include <string>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // Appends the prettified symbol to the output
+    void prettify_symbol_into(string_view symbol, std::string& output);
+    std::string prettify_symbol(string_view symbol);
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
@@ -0,0 +1,201 @@
+#include <cpptrace/resolution.hpp>
+
+#include "batch_resolution.hpp"
+#include "binary/object.hpp"
+#include "demangle/demangle.hpp"
+#include "symbols/symbols.hpp"
+#include "utils/error.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    std::vector<std::string> get_object_paths(const std::vector<object_frame>& frames) {
+        std::vector<std::string> paths;
+        paths.reserve(frames.size());
+        for(const auto& frame : frames) {
+            paths.push_back(frame.object_path);
+        }
+        return paths;
+    }
+
+    // Object information is needed both to group frames by object and for the fallback after the deadline, so it's
+    // looked up once for the whole trace and everything after works on object frames
+    std::vector<object_frame> get_object_frames(const std::vector<frame_ptr>& frames) {
+        try {
+            return get_frames_object_info(frames);
+        } catch(...) { // NOSONAR
+            // everything is treated as one unknown object
+            log_and_maybe_propagate_exception(std::current_exception());
+            std::vector<object_frame> object_frames;
+            object_frames.reserve(frames.size());
+            for(const auto frame : frames) {
+                object_frames.push_back(object_frame{frame, 0, ""});
+            }
+            return object_frames;
+        }
+    }
+
+    // Frames are resolved in chunks of frames from the same object, so that back-ends which set up per-object state on
+    // each call (e.g. libdwarf without resolver caching, addr2line, or the remote symbolizer) do so a handful of times
+    // rather than once per frame. Each object's chunks double in size, starting with the object's top-most frame, so
+    // the top of the stack comes back quickly while the number of calls stays logarithmic in the number of frames.
+    // Chunks are resolved in order of their top-most frame.
+    std::vector<std::vector<std::size_t>> make_chunks(const std::vector<std::string>& object_paths) {
+        std::vector<std::vector<std::size_t>> objects;
+        std::unordered_map<std::string, std::size_t> object_indices;
+        for(std::size_t i = 0; i < object_paths.size(); i++) {
+            auto result = object_indices.emplace(object_paths[i], objects.size());
+            if(result.second) {
+                objects.emplace_back();
+            }
+            objects[result.first->second].push_back(i);
+        }
+        std::vector<std::vector<std::size_t>> chunks;
+        for(const auto& indices : objects) {
+            std::size_t chunk_size = 1;
+            for(std::size_t start = 0; start < indices.size(); start += chunk_size, chunk_size *= 2) {
+                auto end = std::min(start + chunk_size, indices.size());
+                chunks.emplace_back(indices.begin() + start, indices.begin() + end);
+            }
+        }
+        std::stable_sort(
+            chunks.begin(),
+            chunks.end(),
+            [] (const std::vector<std::size_t>& a, const std::vector<std::size_t>& b) { return a[0] < b[0]; }
+        );
+        return chunks;
+    }
+
+    // Resolution errors fall back to object information, exceptions from the callback propagate to the caller
+    stacktrace resolve_progressively(
+        const std::vector<object_frame>& frames,
+        std::chrono::steady_clock::time_point deadline,
+        const experimental::frame_callback& callback,
+        const experimental::cancellation_token& token
+    ) {
+        // the frames each input frame resolved to, filled in as chunks are resolved
+        std::vector<std::vector<stacktrace_frame>> results(frames.size());
+        std::vector<bool> resolved(frames.size(), false);
+        stacktrace trace;
+        std::size_t next_to_deliver = 0;
+        auto deliver_ready = [&] () {
+            for(; next_to_deliver < frames.size() && resolved[next_to_deliver]; next_to_deliver++) {
+                for(auto& frame : results[next_to_deliver]) {
+                    trace.frames.push_back(std::move(frame));
+                    if(callback) {
+                        callback(trace.frames.size() - 1, trace.frames.back());
+                    }
+                }
+            }
+        };
+        auto resolve_object_info = [] (const std::vector<object_frame>& subset) -> std::vector<stacktrace_frame> {
+            try {
+                return resolve_frames(subset, resolution_level::address_only);
+            } catch(...) { // NOSONAR
+                log_and_maybe_propagate_exception(std::current_exception());
+                return std::vector<stacktrace_frame>(subset.size());
+            }
+        };
+        // object information is one frame per input frame
+        auto store_object_info = [&] (const std::vector<std::size_t>& indices) {
+            std::vector<object_frame> subset;
+            subset.reserve(indices.size());
+            for(const auto i : indices) {
+                subset.push_back(frames[i]);
+            }
+            auto info = resolve_object_info(subset);
+            for(std::size_t j = 0; j < indices.size(); j++) {
+                if(j < info.size()) {
+                    results[indices[j]].push_back(std::move(info[j]));
+                }
+                resolved[indices[j]] = true;
+            }
+        };
+        for(const auto& chunk : make_chunks(get_object_paths(frames))) {
+            if(token.is_cancelled() || std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+            std::vector<object_frame> subset;
+            subset.reserve(chunk.size());
+            for(const auto i : chunk) {
+                subset.push_back(frames[i]);
+            }
+            optional<std::vector<stacktrace_frame>> chunk_frames;
+            try {
+                chunk_frames = resolve_frames(subset, resolution_level::full_with_inlines);
+                demangle_frames(chunk_frames.unwrap());
+            } catch(...) { // NOSONAR
+                log_and_maybe_propagate_exception(std::current_exception());
+                chunk_frames.reset();
+            }
+            auto starts = chunk_frames ? group_by_address(chunk_frames.unwrap(), chunk.size()) : nullopt;
+            if(!starts) {
+                store_object_info(chunk);
+            } else {
+                for(std::size_t j = 0; j < chunk.size(); j++) {
+                    auto& result = results[chunk[j]];
+                    result.insert(
+                        result.end(),
+                        std::make_move_iterator(chunk_frames.unwrap().begin() + starts.unwrap()[j]),
+                        std::make_move_iterator(chunk_frames.unwrap().begin() + starts.unwrap()[j + 1])
+                    );
+                    resolved[chunk[j]] = true;
+                }
+            }
+            deliver_ready();
+        }
+        std::vector<std::size_t> remaining;
+        for(std::size_t i = 0; i < frames.size(); i++) {
+            if(!resolved[i]) {
+                remaining.push_back(i);
+            }
+        }
+        if(!remaining.empty()) {
+            store_object_info(remaining);
+        }
+        deliver_ready();
+        return trace;
+    }
+}
+
+namespace experimental {
+    cancellation_token::cancellation_token() : cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancellation_token::cancel() noexcept {
+        cancelled->store(true);
+    }
+
+    bool cancellation_token::is_cancelled() const noexcept {
+        return cancelled->load();
+    }
+
+    stacktrace resolve_progressively(
+        const raw_trace& trace,
+        std::chrono::steady_clock::time_point deadline,
+        const frame_callback& callback,
+        const cancellation_token& token
+    ) {
+        return detail::resolve_progressively(detail::get_object_frames(trace.frames), deadline, callback, token);
+    }
+
+    stacktrace resolve_progressively(
+        const object_trace& trace,
+        std::chrono::steady_clock::time_point deadline,
+        const frame_callback& callback,
+        const cancellation_token& token
+    ) {
+        return detail::resolve_progressively(trace.frames, deadline, callback, token);
+    }
+}
+CPPTRACE_END_NAMESPACE
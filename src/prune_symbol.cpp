@@ -1,8 +1,8 @@
-#include "cpptrace/forward.hpp"
+#include "prune_symbol.hpp"
+#include "symbol_tokenizer.hpp"
 
-#include <array>
 #include <cctype>
-#include <vector>
+#include <string>
 
 #include "utils/error.hpp"
 #include "utils/optional.hpp"
@@ -32,53 +32,6 @@
 
 CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
-    template<typename T, typename Arg>
-    bool is_any(const T& value, const Arg& arg) {
-        return value == arg;
-    }
-
-    template<typename T, typename Arg, typename... Args>
-    bool is_any(const T& value, const Arg& arg, const Args&... args) {
-        return (value == arg) || is_any(value, args...);
-    }
-
-    // http://eel.is/c++draft/lex.name#nt:identifier
-    bool is_identifier_start(char c) {
-        return isalpha(c) || c == '$' || c == '_';
-    }
-    bool is_identifier_continue(char c) {
-        return isdigit(c) || is_identifier_start(c);
-    }
-    bool is_hex_digit(char c) {
-        return isdigit(c) || is_any(c, 'a', 'b', 'c', 'd', 'e', 'f', 'A', 'B', 'C', 'D', 'E', 'F');
-    }
-    bool is_octal_digit(char c) {
-        return is_any(c, '0', '1', '2', '3', '4', '5', '6', '7');
-    }
-    bool is_simple_escape_char(char c) {
-        return is_any(c, '\'', '"', '?', '\\', 'a', 'b', 'f', 'n', 'r', 't', 'v');
-    }
-
-    // http://eel.is/c++draft/lex.operators#nt:operator-or-punctuator
-    const std::vector<string_view> punctuators_and_operators = []() {
-        std::vector<string_view> vec{
-            "{",        "}",        "[",        "]",        "(",        ")",
-            "<:",       ":>",       "<%",       "%>",       ";",        ":",        "...",
-            "?",        "::",       ".",        ".*",       "->",       "->*",      "~",
-            "!",        "+",        "-",        "*",        "/",        "%",        "^",        "&",        "|",
-            "=",        "+=",       "-=",       "*=",       "/=",       "%=",       "^=",       "&=",       "|=",
-            "==",       "!=",       "<",        ">",        "<=",       ">=",       "<=>",      "&&",       "||",
-            "<<",       ">>",       "<<=",      ">>=",      "++",       "--",       ",",
-            // "and",      "or",       "xor",      "not",      "bitand",   "bitor",    "compl",
-            // "and_eq",   "or_eq",    "xor_eq",   "not_eq",
-            "#", // extension for {lambda()#1}
-        };
-        std::sort(vec.begin(), vec.end(), [](string_view a, string_view b) { return a.size() > b.size(); });
-        return vec;
-    } ();
-
-    const std::array<string_view, 2> anonymous_namespace_spellings = {"(anonymous namespace)", "`anonymous namespace'"};
-
     bool is_opening_punctuation(string_view token) {
         return token == "(" || token == "[" || token == "{" || token == "<";
     }
@@ -116,283 +69,10 @@ namespace detail {
         );
     }
 
-    // There are five kinds of tokens in C++: identifiers, keywords, literals, operators, and other separators
-    // We tokenize a mostly-subset of this:
-    //  - identifiers/keywords
-    //  - literals: char, string, int, float. Msvc `strings' too.
-    //  - punctuation
-    // Additionally we tokenize a few things that are useful
-    //  - anonymous namespace tags
-
-    enum class token_type {
-        identifier,
-        punctuation,
-        literal,
-        anonymous_namespace
-    };
-
-    struct token {
-        token_type type;
-        string_view str;
-
-        bool operator==(const token& other) const {
-            return type == other.type && str == other.str;
-        }
-    };
-
     bool is_pointer_ref(const token& token) {
         return token.type == token_type::punctuation && is_any(token.str, "*", "&", "&&");
     }
 
-    struct parse_error {
-        int x; // this works around a gcc bug with warn_unused_result and empty structs
-        explicit parse_error() = default;
-        string_view what() const {
-            return "Parse error";
-        }
-    };
-
-    #define CONCAT_IMPL(X, Y) X##Y
-    #define CONCAT(X, Y) CONCAT_IMPL(X, Y)
-    #define UNIQUE(X) CONCAT(X, __COUNTER__)
-    #define TRY_PARSE_IMPL(ACTION, SUCCESS, RES) \
-        Result<bool, parse_error> RES = (ACTION); \
-        if((RES).is_error()) { \
-            return std::move((RES)).unwrap_error(); \
-        } else if((RES).unwrap_value()) { \
-            SUCCESS; \
-        }
-    #define TRY_PARSE(ACTION, SUCCESS) TRY_PARSE_IMPL(ACTION, SUCCESS, UNIQUE(res))
-
-    #define TRY_TOK_IMPL(RES, ACTION, TMP) \
-        const auto TMP = (ACTION); \
-        if((TMP).is_error()) { \
-            return std::move((TMP)).unwrap_error(); \
-        } \
-        const auto RES = std::move((TMP)).unwrap_value()
-    #define TRY_TOK(RES, ACTION) TRY_TOK_IMPL(RES, ACTION, UNIQUE(tmp))
-
-    class symbol_tokenizer {
-    private:
-        string_view source;
-        optional<token> next_token;
-
-        bool peek(string_view text, size_t pos = 0) const {
-            return text == source.substr(pos, text.size());
-        }
-
-        NODISCARD Result<optional<token>, parse_error> peek_anonymous_namespace() const {
-            for(const auto& spelling : anonymous_namespace_spellings) {
-                if(peek(spelling)) {
-                    return token{token_type::anonymous_namespace, {source.begin(), spelling.size()}};
-                }
-            }
-            return nullopt;
-        }
-
-        NODISCARD Result<optional<token>, parse_error> peek_number() const {
-            // More or less following pp-number https://eel.is/c++draft/lex.ppnumber
-            auto cursor = source.begin();
-            if(cursor != source.end() && std::isdigit(*cursor)) {
-                while(
-                    cursor != source.end()
-                    && (
-                        std::isdigit(*cursor)
-                        || is_identifier_continue(*cursor)
-                        || is_any(*cursor, '\'', '-', '+', '.')
-                    )
-                ) {
-                    cursor++;
-                }
-            }
-            if(cursor == source.begin()) {
-                return nullopt;
-            }
-            return token{token_type::literal, {source.begin(), cursor}};
-        }
-
-        NODISCARD Result<optional<token>, parse_error> peek_msvc_string() const {
-            // msvc strings look like `this'
-            // they nest, e.g.: ``int main(void)'::`2'::<lambda_1>::operator()(void)const'
-            // TODO: Escapes?
-            auto cursor = source.begin();
-            if(cursor != source.end() && *cursor == '`') {
-                int depth = 0;
-                do {
-                    if(*cursor == '`') {
-                        depth++;
-                    } else if(*cursor == '\'') {
-                        depth--;
-                    }
-                    cursor++;
-                } while(cursor != source.end() && depth != 0);
-                if(depth != 0) {
-                    return parse_error{};
-                }
-            }
-            if(cursor == source.begin()) {
-                return nullopt;
-            }
-            return token{token_type::literal, {source.begin(), cursor}};
-        }
-
-        NODISCARD Result<optional<token>, parse_error> parse_quoted_string() const {
-            auto cursor = source.begin();
-            if(cursor != source.end() && is_any(*cursor, '\'', '"')) {
-                auto closing_quote = *cursor;
-                cursor++;
-                while(cursor != source.end() && *cursor != closing_quote) {
-                    if(*cursor == '\\') {
-                        if(cursor + 1 == source.end()) {
-                            return parse_error{};
-                        }
-                        cursor += 2;
-                    }
-                    cursor++;
-                }
-                if(cursor == source.end() || *cursor != closing_quote) {
-                    return parse_error{};
-                }
-                cursor++;
-            }
-            if(cursor == source.begin()) {
-                return nullopt;
-            }
-            return token{token_type::literal, {source.begin(), cursor}};
-        }
-
-        NODISCARD Result<optional<token>, parse_error> peek_literal() const {
-            TRY_TOK(number, peek_number());
-            if(number) {
-                return number;
-            }
-            TRY_TOK(msvc_string, peek_msvc_string());
-            if(msvc_string) {
-                return msvc_string;
-            }
-            TRY_TOK(quoted_string, parse_quoted_string());
-            if(quoted_string) {
-                return quoted_string;
-            }
-            return nullopt;
-        }
-
-        NODISCARD Result<optional<token>, parse_error> peek_punctuation(size_t pos = 0) const {
-            for(const auto punctuation : punctuators_and_operators) {
-                if(peek(punctuation, pos)) {
-                    return token{token_type::punctuation, {source.begin() + pos, punctuation.size()}};
-                }
-            }
-            return nullopt;
-        }
-
-        NODISCARD Result<optional<token>, parse_error> peek_identifier(size_t pos = 0) const {
-            auto start = source.begin() + std::min(pos, source.size());;
-            auto cursor = start;
-            if(cursor != source.end() && is_identifier_start(*cursor)) {
-                while(cursor != source.end() && is_identifier_continue(*cursor)) {
-                    cursor++;
-                }
-            }
-
-            if(cursor == start) {
-                return nullopt;
-            }
-            return token{token_type::identifier, {start, cursor}};
-        }
-
-        NODISCARD token peek_misc() const {
-            ASSERT(!source.empty());
-            return token{token_type::punctuation, {source.begin(), 1}};
-        }
-
-        Result<monostate, parse_error> maybe_load_next_token() {
-            if(next_token.has_value()) {
-                return monostate{};
-            }
-            while(!source.empty() && std::isspace(source[0])) {
-                source.advance(1);
-            }
-            if(source.empty()) {
-                return monostate{};
-            }
-            TRY_TOK(anon, peek_anonymous_namespace());
-            if(anon) {
-                next_token = anon.unwrap();
-                return monostate{};
-            }
-            TRY_TOK(literal, peek_literal());
-            if(literal) {
-                next_token = literal.unwrap();
-                return monostate{};
-            }
-            TRY_TOK(punctuation, peek_punctuation());
-            if(punctuation) {
-                next_token = punctuation.unwrap();
-                return monostate{};
-            }
-            TRY_TOK(identifier, peek_identifier());
-            if(identifier) {
-                next_token = identifier.unwrap();
-                return monostate{};
-            }
-            next_token = peek_misc();
-            return monostate{};
-        }
-
-        optional<token> get_adjusted_next_token(bool in_template_argument_list) {
-            // https://eel.is/c++draft/temp.names#4 decompose >> to > when we think we're in a template argument list.
-            // We don't have to do this for >>= or >=.
-            if(next_token && in_template_argument_list && next_token.unwrap() == token{token_type::punctuation, ">>"}) {
-                auto copy = next_token.unwrap();
-                copy.str = copy.str.substr(0, 1); // ">"
-                return copy;
-            }
-            return next_token;
-        }
-
-    public:
-        symbol_tokenizer(string_view source) : source(source) {}
-
-        NODISCARD Result<optional<token>, parse_error> peek(bool in_template_argument_list = false) {
-            auto res = maybe_load_next_token();
-            if(res.is_error()) {
-                return res.unwrap_error();
-            }
-            return get_adjusted_next_token(in_template_argument_list);
-        }
-
-        Result<optional<token>, parse_error> advance(bool in_template_argument_list = false) {
-            TRY_TOK(next, peek(in_template_argument_list));
-            if(!next) {
-                return nullopt;
-            }
-            source.advance(next.unwrap().str.size());
-            next_token.reset();
-            return next;
-        }
-
-        NODISCARD Result<optional<token>, parse_error> accept(token_type type, bool in_template_argument_list = false) {
-            TRY_TOK(next, peek(in_template_argument_list));
-            if(next && next.unwrap().type == type) {
-                advance();
-                return next;
-            }
-            return nullopt;
-        }
-
-        NODISCARD Result<optional<token>, parse_error> accept(token token, bool in_template_argument_list = false) {
-            TRY_TOK(next, peek(in_template_argument_list));
-            if(next && next.unwrap() == token) {
-                advance();
-                return next;
-            }
-            return nullopt;
-        }
-    };
-
-    std::string prune_symbol(string_view symbol);
-
     /*
 
     Approximate grammar, very hacky:
@@ -466,14 +146,16 @@ namespace detail {
 
     class symbol_parser {
         symbol_tokenizer& tokenizer;
-        std::string name_output;
+        // the name is written to the end of this string, starting at base
+        std::string& name_output;
+        std::size_t base;
         bool last_was_identifier = false;
         bool reset_output_flag = false;
 
         void append_output(token token) {
             auto is_identifier = token.type == token_type::identifier;
             if(reset_output_flag) {
-                name_output.clear();
+                name_output.resize(base);
                 reset_output_flag = false;
                 last_was_identifier = false;
             } else if(is_identifier && last_was_identifier) {
@@ -778,8 +460,8 @@ namespace detail {
                 append_output({token_type::punctuation, "`"});
                 auto symbol = maybe_literal_token.unwrap().str;
                 ASSERT(symbol.size() >= 2);
-                auto name = detail::prune_symbol(symbol.substr(1, symbol.size() - 2));
-                append_output({token_type::literal, name});
+                prune_symbol_into(symbol.substr(1, symbol.size() - 2), name_output);
+                last_was_identifier = false;
                 append_output({token_type::punctuation, "'"});
                 return true;
             }
@@ -934,7 +616,8 @@ namespace detail {
         }
 
     public:
-        symbol_parser(symbol_tokenizer& tokenizer) : tokenizer(tokenizer) {}
+        symbol_parser(symbol_tokenizer& tokenizer, std::string& name_output)
+            : tokenizer(tokenizer), name_output(name_output), base(name_output.size()) {}
 
         NODISCARD Result<monostate, parse_error> parse() {
             while(true) {
@@ -952,24 +635,29 @@ namespace detail {
             return monostate{};
         }
 
-        NODISCARD std::string name() && {
-            return std::move(name_output);
+        bool empty() const {
+            return name_output.size() == base;
         }
     };
 
-    NODISCARD std::string prune_symbol(string_view symbol) {
-        detail::symbol_tokenizer tokenizer(symbol);
-        detail::symbol_parser parser(tokenizer);
+    // Appends the pruned symbol to the output, or the symbol itself if it can't be pruned
+    void prune_symbol_into(string_view symbol, std::string& output) {
+        const auto base = output.size();
+        symbol_tokenizer tokenizer(symbol);
+        symbol_parser parser(tokenizer, output);
         auto res = parser.parse();
-        if(res.is_error()) {
-            // error
-            return std::string(symbol);
-        }
-        auto name = std::move(parser).name();
-        if(name.empty()) {
-            return std::string(symbol);
+        if(res.is_error() || parser.empty()) {
+            output.resize(base);
+            output += symbol;
         }
-        return name;
+    }
+
+    NODISCARD std::string prune_symbol(string_view symbol) {
+        // the name is built up in a buffer which is reused across calls, so that the only allocation is the result
+        thread_local std::string buffer;
+        buffer.clear();
+        prune_symbol_into(symbol, buffer);
+        return buffer;
     }
 }
 CPPTRACE_END_NAMESPACE
@@ -0,0 +1,17 @@
+#ifndef PRUNE_SYMBOL_HPP
+#define PRUNE_SYMBOL_HPP
+
+#include <cpptrace/forward.hpp>
+#include "utils/string_view.hpp"
+
+#include <string>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // Appends the pruned symbol to the output, or the symbol itself if it can't be pruned
+    void prune_symbol_into(string_view symbol, std::string& output);
+    std::string prune_symbol(string_view symbol);
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
@@ -0,0 +1,515 @@
+#include <cpptrace/serialization.hpp>
+
+#include "utils/string_view.hpp"
+#include "utils/utils.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // Binary trace stream format. All integers are unsigned LEB128 varints.
+    //   stream:       record*
+    //   record:       tag:u8 payload
+    //   header:       "CPTR" version                  starts a stream and clears the string table
+    //   string:       length bytes                    appended to the string table
+    //   raw trace:    count (address)*
+    //   object trace: count (address object_address module)*
+    //   stacktrace:   count (address object_address flags [line] [column] filename symbol)*
+    // Raw addresses are zigzag encoded deltas from the previous frame's raw address (or 0 for the first frame). Module
+    // and filename are string table indices. The symbol is too if the interned_symbol flag is set, otherwise it's a
+    // length followed by the bytes.
+    namespace serialization {
+        constexpr char magic[] = {'C', 'P', 'T', 'R'};
+        constexpr std::uint64_t version = 1;
+
+        enum record_tag : std::uint8_t {
+            header_tag = 0,
+            string_tag = 1,
+            raw_trace_tag = 2,
+            object_trace_tag = 3,
+            stacktrace_tag = 4,
+        };
+
+        enum frame_flags : std::uint8_t {
+            is_inline = 1,
+            has_line = 2,
+            has_column = 4,
+            interned_symbol = 8,
+        };
+
+        std::uint64_t zigzag_encode(std::uint64_t value) {
+            return (value << 1) ^ (std::uint64_t(0) - (value >> 63));
+        }
+
+        std::uint64_t zigzag_decode(std::uint64_t value) {
+            return (value >> 1) ^ (std::uint64_t(0) - (value & 1));
+        }
+
+        void write_varint(std::string& output, std::uint64_t value) {
+            while(value >= 0x80) {
+                output += static_cast<char>((value & 0x7f) | 0x80);
+                value >>= 7;
+            }
+            output += static_cast<char>(value);
+        }
+
+        enum class reader_state {
+            ok,
+            // the input ends partway through a record
+            truncated,
+            malformed,
+        };
+
+        // Reads from the input, the first failure is sticky and everything read after it is 0 / empty
+        class byte_reader {
+            const char* begin;
+            const char* pos;
+            const char* end;
+            reader_state state = reader_state::ok;
+
+        public:
+            byte_reader(const char* begin, const char* end) : begin(begin), pos(begin), end(end) {}
+
+            void fail(reader_state new_state) {
+                if(state == reader_state::ok) {
+                    state = new_state;
+                }
+            }
+
+            bool ok() const {
+                return state == reader_state::ok;
+            }
+
+            reader_state status() const {
+                return state;
+            }
+
+            std::size_t consumed() const {
+                return static_cast<std::size_t>(pos - begin);
+            }
+
+            std::size_t remaining() const {
+                return static_cast<std::size_t>(end - pos);
+            }
+
+            std::uint8_t read_byte() {
+                if(!ok() || pos == end) {
+                    fail(reader_state::truncated);
+                    return 0;
+                }
+                return static_cast<std::uint8_t>(*pos++);
+            }
+
+            std::uint64_t read_varint() {
+                std::uint64_t value = 0;
+                for(int shift = 0; ; shift += 7) {
+                    auto byte = read_byte();
+                    if(!ok()) {
+                        return 0;
+                    }
+                    if(shift == 63 && (byte & 0x7e) != 0) {
+                        fail(reader_state::malformed);
+                        return 0;
+                    }
+                    value |= std::uint64_t(byte & 0x7f) << shift;
+                    if((byte & 0x80) == 0) {
+                        return value;
+                    }
+                    if(shift == 63) {
+                        fail(reader_state::malformed);
+                        return 0;
+                    }
+                }
+            }
+
+            string_view read_bytes(std::uint64_t size) {
+                if(!ok() || size > remaining()) {
+                    fail(reader_state::truncated);
+                    return {};
+                }
+                string_view bytes(pos, to<std::size_t>(size));
+                pos += size;
+                return bytes;
+            }
+        };
+    }
+}
+
+namespace experimental {
+    class trace_encoder::impl {
+        std::string output;
+        std::unordered_map<std::string, std::uint64_t> strings;
+        bool stream_started = false;
+        bool do_intern_symbols = true;
+        // string table indices for the frames of the trace being encoded, reused between traces
+        std::vector<std::uint64_t> indices;
+
+        void start_stream() {
+            if(!stream_started) {
+                output += static_cast<char>(detail::serialization::header_tag);
+                output.append(detail::serialization::magic, sizeof(detail::serialization::magic));
+                detail::serialization::write_varint(output, detail::serialization::version);
+                stream_started = true;
+            }
+        }
+
+        std::uint64_t intern(const std::string& str) {
+            auto it = strings.find(str);
+            if(it != strings.end()) {
+                return it->second;
+            }
+            auto index = detail::to<std::uint64_t>(strings.size());
+            strings.emplace(str, index);
+            output += static_cast<char>(detail::serialization::string_tag);
+            detail::serialization::write_varint(output, str.size());
+            output += str;
+            return index;
+        }
+
+        void write_address(frame_ptr address, frame_ptr& previous) {
+            auto delta = detail::to<std::uint64_t>(address) - detail::to<std::uint64_t>(previous);
+            detail::serialization::write_varint(output, detail::serialization::zigzag_encode(delta));
+            previous = address;
+        }
+
+        void write_record_start(detail::serialization::record_tag tag, std::size_t count) {
+            output += static_cast<char>(tag);
+            detail::serialization::write_varint(output, count);
+        }
+
+    public:
+        void intern_symbols(bool intern) {
+            do_intern_symbols = intern;
+        }
+
+        void encode(const raw_trace& trace) {
+            start_stream();
+            write_record_start(detail::serialization::raw_trace_tag, trace.frames.size());
+            frame_ptr previous = 0;
+            for(const auto address : trace.frames) {
+                write_address(address, previous);
+            }
+        }
+
+        void encode(const object_trace& trace) {
+            start_stream();
+            // strings are defined before the record which uses them
+            indices.clear();
+            for(const auto& frame : trace.frames) {
+                indices.push_back(intern(frame.object_path));
+            }
+            write_record_start(detail::serialization::object_trace_tag, trace.frames.size());
+            frame_ptr previous = 0;
+            for(std::size_t i = 0; i < trace.frames.size(); i++) {
+                const auto& frame = trace.frames[i];
+                write_address(frame.raw_address, previous);
+                detail::serialization::write_varint(output, frame.object_address);
+                detail::serialization::write_varint(output, indices[i]);
+            }
+        }
+
+        void encode(const stacktrace& trace) {
+            start_stream();
+            // strings are defined before the record which uses them, filename and symbol indices are interleaved
+            indices.clear();
+            for(const auto& frame : trace.frames) {
+                indices.push_back(intern(frame.filename));
+                if(do_intern_symbols) {
+                    indices.push_back(intern(frame.symbol));
+                }
+            }
+            write_record_start(detail::serialization::stacktrace_tag, trace.frames.size());
+            frame_ptr previous = 0;
+            std::size_t index = 0;
+            for(const auto& frame : trace.frames) {
+                write_address(frame.raw_address, previous);
+                detail::serialization::write_varint(output, frame.object_address);
+                std::uint8_t flags = 0;
+                if(frame.is_inline) {
+                    flags |= detail::serialization::is_inline;
+                }
+                if(frame.line.has_value()) {
+                    flags |= detail::serialization::has_line;
+                }
+                if(frame.column.has_value()) {
+                    flags |= detail::serialization::has_column;
+                }
+                if(do_intern_symbols) {
+                    flags |= detail::serialization::interned_symbol;
+                }
+                output += static_cast<char>(flags);
+                if(frame.line.has_value()) {
+                    detail::serialization::write_varint(output, frame.line.value());
+                }
+                if(frame.column.has_value()) {
+                    detail::serialization::write_varint(output, frame.column.value());
+                }
+                detail::serialization::write_varint(output, indices[index++]);
+                if(do_intern_symbols) {
+                    detail::serialization::write_varint(output, indices[index++]);
+                } else {
+                    detail::serialization::write_varint(output, frame.symbol.size());
+                    output += frame.symbol;
+                }
+            }
+        }
+
+        const std::string& data() const {
+            return output;
+        }
+
+        std::string take() {
+            std::string taken = std::move(output);
+            output.clear();
+            return taken;
+        }
+
+        void reset() {
+            strings.clear();
+            stream_started = false;
+        }
+    };
+
+    class trace_decoder::impl {
+        std::string input;
+        std::size_t position = 0;
+        std::vector<std::string> strings;
+        bool stream_started = false;
+        bool failed = false;
+
+        enum class record_kind {
+            // header or string, these are handled internally
+            metadata,
+            trace,
+        };
+
+        const std::string& read_string_index(detail::serialization::byte_reader& reader) {
+            static const std::string empty;
+            auto index = reader.read_varint();
+            if(!reader.ok()) {
+                return empty;
+            }
+            if(index >= strings.size()) {
+                reader.fail(detail::serialization::reader_state::malformed);
+                return empty;
+            }
+            return strings[detail::to<std::size_t>(index)];
+        }
+
+        frame_ptr read_address(detail::serialization::byte_reader& reader, frame_ptr& previous) {
+            auto delta = detail::serialization::zigzag_decode(reader.read_varint());
+            previous = detail::to<frame_ptr>(detail::to<std::uint64_t>(previous) + delta);
+            return previous;
+        }
+
+        void read_header(detail::serialization::byte_reader& reader) {
+            auto magic = reader.read_bytes(sizeof(detail::serialization::magic));
+            auto version = reader.read_varint();
+            if(!reader.ok()) {
+                return;
+            }
+            if(
+                magic != detail::string_view(detail::serialization::magic, sizeof(detail::serialization::magic))
+                    || version != detail::serialization::version
+            ) {
+                reader.fail(detail::serialization::reader_state::malformed);
+                return;
+            }
+            strings.clear();
+            stream_started = true;
+        }
+
+        void read_string(detail::serialization::byte_reader& reader) {
+            auto length = reader.read_varint();
+            auto bytes = reader.read_bytes(length);
+            if(reader.ok()) {
+                strings.emplace_back(bytes.data(), bytes.size());
+            }
+        }
+
+        // frames are added one by one rather than reserving the count up front, since the count can't be trusted
+        void read_raw_trace(detail::serialization::byte_reader& reader, raw_trace& trace) {
+            auto count = reader.read_varint();
+            frame_ptr previous = 0;
+            for(std::uint64_t i = 0; i < count && reader.ok(); i++) {
+                trace.frames.push_back(read_address(reader, previous));
+            }
+        }
+
+        void read_object_trace(detail::serialization::byte_reader& reader, object_trace& trace) {
+            auto count = reader.read_varint();
+            frame_ptr previous = 0;
+            for(std::uint64_t i = 0; i < count && reader.ok(); i++) {
+                object_frame frame;
+                frame.raw_address = read_address(reader, previous);
+                frame.object_address = detail::to<frame_ptr>(reader.read_varint());
+                frame.object_path = read_string_index(reader);
+                trace.frames.push_back(std::move(frame));
+            }
+        }
+
+        void read_stacktrace(detail::serialization::byte_reader& reader, stacktrace& trace) {
+            auto count = reader.read_varint();
+            frame_ptr previous = 0;
+            for(std::uint64_t i = 0; i < count && reader.ok(); i++) {
+                stacktrace_frame frame;
+                frame.raw_address = read_address(reader, previous);
+                frame.object_address = detail::to<frame_ptr>(reader.read_varint());
+                auto flags = reader.read_byte();
+                frame.is_inline = flags & detail::serialization::is_inline;
+                if(flags & detail::serialization::has_line) {
+                    frame.line = static_cast<std::uint32_t>(reader.read_varint());
+                }
+                if(flags & detail::serialization::has_column) {
+                    frame.column = static_cast<std::uint32_t>(reader.read_varint());
+                }
+                frame.filename = read_string_index(reader);
+                if(flags & detail::serialization::interned_symbol) {
+                    frame.symbol = read_string_index(reader);
+                } else {
+                    auto length = reader.read_varint();
+                    auto symbol = reader.read_bytes(length);
+                    frame.symbol.assign(symbol.data(), symbol.size());
+                }
+                trace.frames.push_back(std::move(frame));
+            }
+        }
+
+        record_kind read_record(detail::serialization::byte_reader& reader, decoded_trace& out) {
+            auto tag = reader.read_byte();
+            if(!reader.ok()) {
+                return record_kind::metadata;
+            }
+            if(tag != detail::serialization::header_tag && !stream_started) {
+                reader.fail(detail::serialization::reader_state::malformed);
+                return record_kind::metadata;
+            }
+            switch(tag) {
+                case detail::serialization::header_tag:
+                    read_header(reader);
+                    return record_kind::metadata;
+                case detail::serialization::string_tag:
+                    read_string(reader);
+                    return record_kind::metadata;
+                case detail::serialization::raw_trace_tag:
+                    out.type = decoded_trace::trace_type::raw;
+                    out.raw.frames.clear();
+                    read_raw_trace(reader, out.raw);
+                    return record_kind::trace;
+                case detail::serialization::object_trace_tag:
+                    out.type = decoded_trace::trace_type::object;
+                    out.object.frames.clear();
+                    read_object_trace(reader, out.object);
+                    return record_kind::trace;
+                case detail::serialization::stacktrace_tag:
+                    out.type = decoded_trace::trace_type::resolved;
+                    out.resolved.frames.clear();
+                    read_stacktrace(reader, out.resolved);
+                    return record_kind::trace;
+                default:
+                    reader.fail(detail::serialization::reader_state::malformed);
+                    return record_kind::metadata;
+            }
+        }
+
+    public:
+        void feed(const char* data, std::size_t size) {
+            // drop consumed input once it makes up most of the buffer
+            if(position > input.size() / 2) {
+                input.erase(0, position);
+                position = 0;
+            }
+            input.append(data, size);
+        }
+
+        decode_status next(decoded_trace& out) {
+            while(!failed) {
+                detail::serialization::byte_reader reader(input.data() + position, input.data() + input.size());
+                auto kind = read_record(reader, out);
+                switch(reader.status()) {
+                    case detail::serialization::reader_state::truncated:
+                        // nothing is consumed, the record is read again once more input is available
+                        return decode_status::need_more_input;
+                    case detail::serialization::reader_state::malformed:
+                        failed = true;
+                        break;
+                    case detail::serialization::reader_state::ok:
+                        position += reader.consumed();
+                        if(kind == record_kind::trace) {
+                            return decode_status::ok;
+                        }
+                        break;
+                }
+            }
+            return decode_status::error;
+        }
+    };
+
+    trace_encoder::trace_encoder() : pimpl(new impl) {}
+    trace_encoder::~trace_encoder() {
+        delete pimpl;
+    }
+
+    trace_encoder::trace_encoder(trace_encoder&& other) : pimpl(detail::exchange(other.pimpl, nullptr)) {}
+    trace_encoder& trace_encoder::operator=(trace_encoder&& other) {
+        if(pimpl) {
+            delete pimpl;
+        }
+        pimpl = detail::exchange(other.pimpl, nullptr);
+        return *this;
+    }
+
+    trace_encoder& trace_encoder::intern_symbols(bool intern) {
+        pimpl->intern_symbols(intern);
+        return *this;
+    }
+
+    void trace_encoder::encode(const raw_trace& trace) {
+        pimpl->encode(trace);
+    }
+    void trace_encoder::encode(const object_trace& trace) {
+        pimpl->encode(trace);
+    }
+    void trace_encoder::encode(const stacktrace& trace) {
+        pimpl->encode(trace);
+    }
+
+    const std::string& trace_encoder::data() const {
+        return pimpl->data();
+    }
+    std::string trace_encoder::take() {
+        return pimpl->take();
+    }
+    void trace_encoder::reset() {
+        pimpl->reset();
+    }
+
+    trace_decoder::trace_decoder() : pimpl(new impl) {}
+    trace_decoder::~trace_decoder() {
+        delete pimpl;
+    }
+
+    trace_decoder::trace_decoder(trace_decoder&& other) : pimpl(detail::exchange(other.pimpl, nullptr)) {}
+    trace_decoder& trace_decoder::operator=(trace_decoder&& other) {
+        if(pimpl) {
+            delete pimpl;
+        }
+        pimpl = detail::exchange(other.pimpl, nullptr);
+        return *this;
+    }
+
+    void trace_decoder::feed(const char* data, std::size_t size) {
+        pimpl->feed(data, size);
+    }
+    void trace_decoder::feed(const std::string& data) {
+        pimpl->feed(data.data(), data.size());
+    }
+    decode_status trace_decoder::next(decoded_trace& out) {
+        return pimpl->next(out);
+    }
+}
+CPPTRACE_END_NAMESPACE
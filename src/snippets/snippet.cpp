@@ -11,6 +11,7 @@
 #include "utils/common.hpp"
 #include "utils/microfmt.hpp"
 #include "utils/utils.hpp"
+#include "statistics.hpp"
 
 CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
@@ -94,8 +95,10 @@ namespace detail {
         std::unique_lock<std::mutex> lock(snippet_manager_mutex);
         auto it = snippet_managers.find(path);
         if(it == snippet_managers.end()) {
+            stats::record_cache_insertion(stats::cache::snippet);
             return snippet_managers.insert({path, snippet_manager(path)}).first->second;
         } else {
+            stats::record_cache_hit(stats::cache::snippet);
             return it->second;
         }
     }
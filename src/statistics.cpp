@@ -0,0 +1,238 @@
+#include "statistics.hpp"
+
+#include "platform/platform.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+namespace stats {
+    // Everything is relaxed, the counters don't order anything else
+
+    // Counters that are updated together share a cache line, separate groups don't so that threads recording
+    // different things (e.g. capturing on one thread and resolving on another) don't contend
+    constexpr std::size_t cache_line_size = 64;
+
+    #if IS_MSVC
+    #pragma warning(push)
+    #pragma warning(disable: 4324) // warning C4324: structure was padded due to alignment specifier
+    #endif
+
+    constexpr std::size_t bucket_count = std::tuple_size<decltype(experimental::latency_histogram::buckets)>::value;
+
+    struct atomic_histogram {
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> total_ns{0};
+        std::array<std::atomic<std::uint64_t>, bucket_count> buckets{};
+
+        void record(std::chrono::nanoseconds duration) {
+            auto ns = static_cast<std::uint64_t>(duration.count() < 0 ? 0 : duration.count());
+            auto us = ns / 1000;
+            std::size_t bucket = 0;
+            while(us != 0 && bucket < buckets.size() - 1) {
+                us >>= 1;
+                bucket++;
+            }
+            count.fetch_add(1, std::memory_order_relaxed);
+            total_ns.fetch_add(ns, std::memory_order_relaxed);
+            buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        experimental::latency_histogram snapshot() const {
+            experimental::latency_histogram histogram;
+            histogram.count = count.load(std::memory_order_relaxed);
+            histogram.total_ns = total_ns.load(std::memory_order_relaxed);
+            for(std::size_t i = 0; i < buckets.size(); i++) {
+                histogram.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+            }
+            return histogram;
+        }
+
+        void reset() {
+            count.store(0, std::memory_order_relaxed);
+            total_ns.store(0, std::memory_order_relaxed);
+            for(auto& bucket : buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    struct alignas(cache_line_size) atomic_cache_statistics {
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+        std::atomic<std::uint64_t> evictions{0};
+        std::atomic<std::uint64_t> entries{0};
+
+        experimental::cache_statistics snapshot() const {
+            experimental::cache_statistics statistics;
+            statistics.hits = hits.load(std::memory_order_relaxed);
+            statistics.misses = misses.load(std::memory_order_relaxed);
+            statistics.evictions = evictions.load(std::memory_order_relaxed);
+            statistics.entries = entries.load(std::memory_order_relaxed);
+            return statistics;
+        }
+
+        // entries describes what's currently held so it isn't reset
+        void reset() {
+            hits.store(0, std::memory_order_relaxed);
+            misses.store(0, std::memory_order_relaxed);
+            evictions.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    struct alignas(cache_line_size) atomic_backend_statistics {
+        std::atomic<std::uint64_t> frames{0};
+        atomic_histogram resolution_time;
+    };
+
+    struct all_counters {
+        alignas(cache_line_size) std::atomic<std::uint64_t> captures{0};
+        std::atomic<std::uint64_t> frames_captured{0};
+        atomic_histogram unwinding_time;
+        std::array<atomic_backend_statistics, static_cast<std::size_t>(backend::count)> backends;
+        std::array<atomic_cache_statistics, static_cast<std::size_t>(cache::count)> caches;
+        alignas(cache_line_size) std::atomic<std::uint64_t> object_bytes_read{0};
+    };
+
+    #if IS_MSVC
+    #pragma warning(pop)
+    #endif
+
+    // Never destroyed so that counters can be updated from static destructors. Constructed in static storage since
+    // operator new doesn't respect over-alignment before C++17.
+    all_counters& get_counters() {
+        alignas(all_counters) static unsigned char storage[sizeof(all_counters)];
+        static all_counters* instance = new (storage) all_counters;
+        return *instance;
+    }
+
+    atomic_cache_statistics& get_cache(cache which) {
+        return get_counters().caches[static_cast<std::size_t>(which)];
+    }
+
+    const char* to_string(backend which) {
+        switch(which) {
+            case backend::libdwarf: return "libdwarf";
+            case backend::dbghelp: return "dbghelp";
+            case backend::addr2line: return "addr2line";
+            case backend::libdl: return "libdl";
+            case backend::libbacktrace: return "libbacktrace";
+            case backend::nothing: return "nothing";
+            case backend::remote: return "remote";
+            case backend::count: break;
+        }
+        return "unknown";
+    }
+
+    thread_local bool suppress_capture_recording = false;
+
+    unrecorded_captures::unrecorded_captures() : previous(suppress_capture_recording) {
+        suppress_capture_recording = true;
+    }
+
+    unrecorded_captures::~unrecorded_captures() {
+        suppress_capture_recording = previous;
+    }
+
+    bool captures_are_recorded() {
+        return !suppress_capture_recording;
+    }
+
+        void record_capture(std::size_t frames, std::chrono::nanoseconds duration) {
+        auto& counters = get_counters();
+        counters.captures.fetch_add(1, std::memory_order_relaxed);
+        counters.frames_captured.fetch_add(frames, std::memory_order_relaxed);
+        counters.unwinding_time.record(duration);
+    }
+
+    void record_resolution(backend which, std::size_t frames, std::chrono::nanoseconds duration) {
+        auto& statistics = get_counters().backends[static_cast<std::size_t>(which)];
+        statistics.frames.fetch_add(frames, std::memory_order_relaxed);
+        statistics.resolution_time.record(duration);
+    }
+
+    void record_cache_hit(cache which) {
+        get_cache(which).hits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void record_cache_insertion(cache which) {
+        auto& statistics = get_cache(which);
+        statistics.misses.fetch_add(1, std::memory_order_relaxed);
+        statistics.entries.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void record_cache_miss(cache which) {
+        get_cache(which).misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void record_cache_evictions(cache which, std::size_t count) {
+        if(count == 0) {
+            return;
+        }
+        auto& statistics = get_cache(which);
+        statistics.evictions.fetch_add(count, std::memory_order_relaxed);
+        statistics.entries.fetch_sub(count, std::memory_order_relaxed);
+    }
+
+    void record_cache_release(cache which, std::size_t count) {
+        if(count == 0) {
+            return;
+        }
+        get_cache(which).entries.fetch_sub(count, std::memory_order_relaxed);
+    }
+
+    void record_bytes_read(std::size_t bytes) {
+        get_counters().object_bytes_read.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+}
+
+namespace experimental {
+    statistics get_statistics() {
+        auto& counters = detail::stats::get_counters();
+        statistics result;
+        result.captures = counters.captures.load(std::memory_order_relaxed);
+        result.frames_captured = counters.frames_captured.load(std::memory_order_relaxed);
+        result.unwinding_time = counters.unwinding_time.snapshot();
+        for(std::size_t i = 0; i < counters.backends.size(); i++) {
+            const auto& backend = counters.backends[i];
+            auto resolution_time = backend.resolution_time.snapshot();
+            if(resolution_time.count == 0) {
+                continue;
+            }
+            backend_statistics entry;
+            entry.name = detail::stats::to_string(static_cast<detail::stats::backend>(i));
+            entry.frames = backend.frames.load(std::memory_order_relaxed);
+            entry.resolution_time = resolution_time;
+            result.backends.push_back(std::move(entry));
+        }
+        using detail::stats::cache;
+        using detail::stats::get_cache;
+        result.resolver_cache = get_cache(cache::resolver).snapshot();
+        result.object_cache = get_cache(cache::object).snapshot();
+        result.line_table_cache = get_cache(cache::line_table).snapshot();
+        result.subprogram_cache = get_cache(cache::subprogram).snapshot();
+        result.snippet_cache = get_cache(cache::snippet).snapshot();
+        result.object_bytes_read = counters.object_bytes_read.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    void reset_statistics() {
+        auto& counters = detail::stats::get_counters();
+        counters.captures.store(0, std::memory_order_relaxed);
+        counters.frames_captured.store(0, std::memory_order_relaxed);
+        counters.unwinding_time.reset();
+        for(auto& backend : counters.backends) {
+            backend.frames.store(0, std::memory_order_relaxed);
+            backend.resolution_time.reset();
+        }
+        for(auto& cache : counters.caches) {
+            cache.reset();
+        }
+        counters.object_bytes_read.store(0, std::memory_order_relaxed);
+    }
+}
+CPPTRACE_END_NAMESPACE
@@ -0,0 +1,102 @@
+#ifndef STATISTICS_HPP
+#define STATISTICS_HPP
+
+#include <cpptrace/utils.hpp>
+
+#include "platform/probes.hpp"
+
+#include <chrono>
+#include <cstddef>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+namespace stats {
+    // Counters behind experimental::get_statistics, all of these are cheap enough to call on every trace
+
+    enum class backend {
+        libdwarf,
+        dbghelp,
+        addr2line,
+        libdl,
+        libbacktrace,
+        nothing,
+        remote,
+        count
+    };
+
+    enum class cache {
+        resolver,
+        object,
+        line_table,
+        subprogram,
+        snippet,
+        count
+    };
+
+    const char* to_string(backend which);
+
+    void record_capture(std::size_t frames, std::chrono::nanoseconds duration);
+    void record_resolution(backend which, std::size_t frames, std::chrono::nanoseconds duration);
+    void record_cache_hit(cache which);
+    // a miss that results in a new entry being held by the cache
+    void record_cache_insertion(cache which);
+    // a miss that doesn't add an entry, e.g. because the cache mode doesn't keep the result around
+    void record_cache_miss(cache which);
+    void record_cache_evictions(cache which, std::size_t count);
+    // entries dropped along with their owner, e.g. a resolver's line tables, rather than evicted
+    void record_cache_release(cache which, std::size_t count);
+    void record_bytes_read(std::size_t bytes);
+
+    // Unwinds done by cpptrace for its own purposes, e.g. finding an exception's throw site for sampling, aren't
+    // traces anyone asked for. Captures on this thread aren't recorded while one of these is alive.
+    class unrecorded_captures {
+        bool previous;
+    public:
+        unrecorded_captures();
+        ~unrecorded_captures();
+        unrecorded_captures(const unrecorded_captures&) = delete;
+        unrecorded_captures& operator=(const unrecorded_captures&) = delete;
+    };
+    bool captures_are_recorded();
+
+    // Also fires the capture probes
+    class capture_timer {
+        bool recorded = captures_are_recorded();
+        std::chrono::steady_clock::time_point start;
+    public:
+        capture_timer() {
+            if(recorded) {
+                CPPTRACE_PROBE(capture__begin);
+            }
+            start = std::chrono::steady_clock::now();
+        }
+        void finish(std::size_t frames) const {
+            if(!recorded) {
+                return;
+            }
+            auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            record_capture(frames, duration);
+            CPPTRACE_PROBE2(capture__end, frames, duration.count());
+        }
+    };
+
+    // Records the time spent in a back-end when it goes out of scope
+    class resolution_timer {
+        backend which;
+        std::size_t frames;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    public:
+        resolution_timer(backend which_, std::size_t frames_) : which(which_), frames(frames_) {}
+        ~resolution_timer() {
+            auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            record_resolution(which, frames, duration);
+            CPPTRACE_PROBE3(frames__resolve, to_string(which), frames, duration.count());
+        }
+        resolution_timer(const resolution_timer&) = delete;
+        resolution_timer& operator=(const resolution_timer&) = delete;
+    };
+}
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
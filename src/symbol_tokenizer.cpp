@@ -0,0 +1,74 @@
+#include "symbol_tokenizer.hpp"
+
+#include <cctype>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // http://eel.is/c++draft/lex.name#nt:identifier
+    bool is_identifier_start(char c) {
+        return isalpha(c) || c == '$' || c == '_';
+    }
+    bool is_identifier_continue(char c) {
+        return isdigit(c) || is_identifier_start(c);
+    }
+    bool is_hex_digit(char c) {
+        return isdigit(c) || is_any(c, 'a', 'b', 'c', 'd', 'e', 'f', 'A', 'B', 'C', 'D', 'E', 'F');
+    }
+    bool is_octal_digit(char c) {
+        return is_any(c, '0', '1', '2', '3', '4', '5', '6', '7');
+    }
+    bool is_simple_escape_char(char c) {
+        return is_any(c, '\'', '"', '?', '\\', 'a', 'b', 'f', 'n', 'r', 't', 'v');
+    }
+
+    // http://eel.is/c++draft/lex.operators#nt:operator-or-punctuator
+    // Matches the longest operator or punctuator at the start of the string, this is called for every token so it
+    // switches on the characters instead of trying each punctuator in turn
+    std::size_t match_punctuation(string_view str) {
+        const auto at = [&str] (std::size_t i) {
+            return i < str.size() ? str.data()[i] : '\0';
+        };
+        switch(at(0)) {
+            case '{': case '}': case '[': case ']': case '(': case ')': case ';': case '?': case '~': case ',':
+            case '#': // extension for {lambda()#1}
+                return 1;
+            case '<': // < <: <% <= <=> << <<=
+                if(at(1) == '=') {
+                    return at(2) == '>' ? 3 : 2;
+                } else if(at(1) == '<') {
+                    return at(2) == '=' ? 3 : 2;
+                }
+                return at(1) == ':' || at(1) == '%' ? 2 : 1;
+            case '>': // > >= >> >>=
+                if(at(1) == '>') {
+                    return at(2) == '=' ? 3 : 2;
+                }
+                return at(1) == '=' ? 2 : 1;
+            case ':': // : :> ::
+                return at(1) == '>' || at(1) == ':' ? 2 : 1;
+            case '%': // % %> %=
+                return at(1) == '>' || at(1) == '=' ? 2 : 1;
+            case '.': // . .* ...
+                if(at(1) == '.' && at(2) == '.') {
+                    return 3;
+                }
+                return at(1) == '*' ? 2 : 1;
+            case '-': // - -= -- -> ->*
+                if(at(1) == '>') {
+                    return at(2) == '*' ? 3 : 2;
+                }
+                return at(1) == '=' || at(1) == '-' ? 2 : 1;
+            case '+': // + += ++
+            case '&': // & &= &&
+            case '|': // | |= ||
+                return at(1) == '=' || at(1) == at(0) ? 2 : 1;
+            case '!': case '*': case '/': case '^': case '=': // x x=, including ==
+                return at(1) == '=' ? 2 : 1;
+            default:
+                return 0;
+        }
+    }
+
+    const std::array<string_view, 2> anonymous_namespace_spellings = {"(anonymous namespace)", "`anonymous namespace'"};
+}
+CPPTRACE_END_NAMESPACE
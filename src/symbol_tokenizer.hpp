@@ -0,0 +1,304 @@
+#ifndef SYMBOL_TOKENIZER_HPP
+#define SYMBOL_TOKENIZER_HPP
+
+#include "cpptrace/forward.hpp"
+
+#include <array>
+#include <algorithm>
+
+#include "utils/error.hpp"
+#include "utils/optional.hpp"
+#include "utils/string_view.hpp"
+#include "utils/utils.hpp"
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    template<typename T, typename Arg>
+    bool is_any(const T& value, const Arg& arg) {
+        return value == arg;
+    }
+
+    template<typename T, typename Arg, typename... Args>
+    bool is_any(const T& value, const Arg& arg, const Args&... args) {
+        return (value == arg) || is_any(value, args...);
+    }
+
+    bool is_identifier_start(char c);
+    bool is_identifier_continue(char c);
+
+    std::size_t match_punctuation(string_view str);
+    extern const std::array<string_view, 2> anonymous_namespace_spellings;
+
+    // There are five kinds of tokens in C++: identifiers, keywords, literals, operators, and other separators
+    // We tokenize a mostly-subset of this:
+    //  - identifiers/keywords
+    //  - literals: char, string, int, float. Msvc `strings' too.
+    //  - punctuation
+    // Additionally we tokenize a few things that are useful
+    //  - anonymous namespace tags
+
+    enum class token_type {
+        identifier,
+        punctuation,
+        literal,
+        anonymous_namespace
+    };
+
+    struct token {
+        token_type type;
+        string_view str;
+
+        bool operator==(const token& other) const {
+            return type == other.type && str == other.str;
+        }
+    };
+
+    struct parse_error {
+        int x; // this works around a gcc bug with warn_unused_result and empty structs
+        explicit parse_error() = default;
+        string_view what() const {
+            return "Parse error";
+        }
+    };
+
+    #define CONCAT_IMPL(X, Y) X##Y
+    #define CONCAT(X, Y) CONCAT_IMPL(X, Y)
+    #define UNIQUE(X) CONCAT(X, __COUNTER__)
+    #define TRY_PARSE_IMPL(ACTION, SUCCESS, RES) \
+        Result<bool, parse_error> RES = (ACTION); \
+        if((RES).is_error()) { \
+            return std::move((RES)).unwrap_error(); \
+        } else if((RES).unwrap_value()) { \
+            SUCCESS; \
+        }
+    #define TRY_PARSE(ACTION, SUCCESS) TRY_PARSE_IMPL(ACTION, SUCCESS, UNIQUE(res))
+
+    #define TRY_TOK_IMPL(RES, ACTION, TMP) \
+        const auto TMP = (ACTION); \
+        if((TMP).is_error()) { \
+            return std::move((TMP)).unwrap_error(); \
+        } \
+        const auto RES = std::move((TMP)).unwrap_value()
+    #define TRY_TOK(RES, ACTION) TRY_TOK_IMPL(RES, ACTION, UNIQUE(tmp))
+
+    class symbol_tokenizer {
+    private:
+        string_view source;
+        optional<token> next_token;
+
+        bool peek(string_view text, size_t pos = 0) const {
+            return text == source.substr(pos, text.size());
+        }
+
+        NODISCARD Result<optional<token>, parse_error> peek_anonymous_namespace() const {
+            for(const auto& spelling : anonymous_namespace_spellings) {
+                if(peek(spelling)) {
+                    return token{token_type::anonymous_namespace, {source.begin(), spelling.size()}};
+                }
+            }
+            return nullopt;
+        }
+
+        NODISCARD Result<optional<token>, parse_error> peek_number() const {
+            // More or less following pp-number https://eel.is/c++draft/lex.ppnumber
+            auto cursor = source.begin();
+            if(cursor != source.end() && std::isdigit(*cursor)) {
+                while(
+                    cursor != source.end()
+                    && (
+                        std::isdigit(*cursor)
+                        || is_identifier_continue(*cursor)
+                        || is_any(*cursor, '\'', '-', '+', '.')
+                    )
+                ) {
+                    cursor++;
+                }
+            }
+            if(cursor == source.begin()) {
+                return nullopt;
+            }
+            return token{token_type::literal, {source.begin(), cursor}};
+        }
+
+        NODISCARD Result<optional<token>, parse_error> peek_msvc_string() const {
+            // msvc strings look like `this'
+            // they nest, e.g.: ``int main(void)'::`2'::<lambda_1>::operator()(void)const'
+            // TODO: Escapes?
+            auto cursor = source.begin();
+            if(cursor != source.end() && *cursor == '`') {
+                int depth = 0;
+                do {
+                    if(*cursor == '`') {
+                        depth++;
+                    } else if(*cursor == '\'') {
+                        depth--;
+                    }
+                    cursor++;
+                } while(cursor != source.end() && depth != 0);
+                if(depth != 0) {
+                    return parse_error{};
+                }
+            }
+            if(cursor == source.begin()) {
+                return nullopt;
+            }
+            return token{token_type::literal, {source.begin(), cursor}};
+        }
+
+        NODISCARD Result<optional<token>, parse_error> parse_quoted_string() const {
+            auto cursor = source.begin();
+            if(cursor != source.end() && is_any(*cursor, '\'', '"')) {
+                auto closing_quote = *cursor;
+                cursor++;
+                while(cursor != source.end() && *cursor != closing_quote) {
+                    if(*cursor == '\\') {
+                        if(cursor + 1 == source.end()) {
+                            return parse_error{};
+                        }
+                        cursor += 2;
+                    }
+                    cursor++;
+                }
+                if(cursor == source.end() || *cursor != closing_quote) {
+                    return parse_error{};
+                }
+                cursor++;
+            }
+            if(cursor == source.begin()) {
+                return nullopt;
+            }
+            return token{token_type::literal, {source.begin(), cursor}};
+        }
+
+        NODISCARD Result<optional<token>, parse_error> peek_literal() const {
+            TRY_TOK(number, peek_number());
+            if(number) {
+                return number;
+            }
+            TRY_TOK(msvc_string, peek_msvc_string());
+            if(msvc_string) {
+                return msvc_string;
+            }
+            TRY_TOK(quoted_string, parse_quoted_string());
+            if(quoted_string) {
+                return quoted_string;
+            }
+            return nullopt;
+        }
+
+        NODISCARD Result<optional<token>, parse_error> peek_punctuation(size_t pos = 0) const {
+            const auto length = match_punctuation(source.substr(std::min(pos, source.size())));
+            if(length == 0) {
+                return nullopt;
+            }
+            return token{token_type::punctuation, {source.begin() + pos, length}};
+        }
+
+        NODISCARD Result<optional<token>, parse_error> peek_identifier(size_t pos = 0) const {
+            auto start = source.begin() + std::min(pos, source.size());;
+            auto cursor = start;
+            if(cursor != source.end() && is_identifier_start(*cursor)) {
+                while(cursor != source.end() && is_identifier_continue(*cursor)) {
+                    cursor++;
+                }
+            }
+
+            if(cursor == start) {
+                return nullopt;
+            }
+            return token{token_type::identifier, {start, cursor}};
+        }
+
+        NODISCARD token peek_misc() const {
+            ASSERT(!source.empty());
+            return token{token_type::punctuation, {source.begin(), 1}};
+        }
+
+        Result<monostate, parse_error> maybe_load_next_token() {
+            if(next_token.has_value()) {
+                return monostate{};
+            }
+            while(!source.empty() && std::isspace(source[0])) {
+                source.advance(1);
+            }
+            if(source.empty()) {
+                return monostate{};
+            }
+            TRY_TOK(anon, peek_anonymous_namespace());
+            if(anon) {
+                next_token = anon.unwrap();
+                return monostate{};
+            }
+            TRY_TOK(literal, peek_literal());
+            if(literal) {
+                next_token = literal.unwrap();
+                return monostate{};
+            }
+            TRY_TOK(punctuation, peek_punctuation());
+            if(punctuation) {
+                next_token = punctuation.unwrap();
+                return monostate{};
+            }
+            TRY_TOK(identifier, peek_identifier());
+            if(identifier) {
+                next_token = identifier.unwrap();
+                return monostate{};
+            }
+            next_token = peek_misc();
+            return monostate{};
+        }
+
+        optional<token> get_adjusted_next_token(bool in_template_argument_list) {
+            // https://eel.is/c++draft/temp.names#4 decompose >> to > when we think we're in a template argument list.
+            // We don't have to do this for >>= or >=.
+            if(next_token && in_template_argument_list && next_token.unwrap() == token{token_type::punctuation, ">>"}) {
+                auto copy = next_token.unwrap();
+                copy.str = copy.str.substr(0, 1); // ">"
+                return copy;
+            }
+            return next_token;
+        }
+
+    public:
+        symbol_tokenizer(string_view source) : source(source) {}
+
+        NODISCARD Result<optional<token>, parse_error> peek(bool in_template_argument_list = false) {
+            auto res = maybe_load_next_token();
+            if(res.is_error()) {
+                return res.unwrap_error();
+            }
+            return get_adjusted_next_token(in_template_argument_list);
+        }
+
+        Result<optional<token>, parse_error> advance(bool in_template_argument_list = false) {
+            TRY_TOK(next, peek(in_template_argument_list));
+            if(!next) {
+                return nullopt;
+            }
+            source.advance(next.unwrap().str.size());
+            next_token.reset();
+            return next;
+        }
+
+        NODISCARD Result<optional<token>, parse_error> accept(token_type type, bool in_template_argument_list = false) {
+            TRY_TOK(next, peek(in_template_argument_list));
+            if(next && next.unwrap().type == type) {
+                advance();
+                return next;
+            }
+            return nullopt;
+        }
+
+        NODISCARD Result<optional<token>, parse_error> accept(token token, bool in_template_argument_list = false) {
+            TRY_TOK(next, peek(in_template_argument_list));
+            if(next && next.unwrap() == token) {
+                advance();
+                return next;
+            }
+            return nullopt;
+        }
+    };
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
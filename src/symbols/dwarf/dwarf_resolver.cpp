@@ -12,12 +12,19 @@
 #include "utils/utils.hpp"
 #include "utils/lru_cache.hpp"
 #include "platform/path.hpp"
+#include "platform/probes.hpp"
 #include "platform/program_name.hpp" // For CPPTRACE_MAX_PATH
 #include "logging.hpp"
+#include "options.hpp"
+#include "statistics.hpp"
 
 #if IS_APPLE
 #include "binary/mach-o.hpp"
 #endif
+#if IS_LINUX
+#include "binary/elf.hpp"
+#include "symbols/dwarf/object_access.hpp"
+#endif
 
 #include <algorithm>
 #include <cstdint>
@@ -53,6 +60,10 @@ namespace libdwarf {
 
     class dwarf_resolver : public symbol_resolver {
         std::string object_path;
+        #if IS_LINUX
+        // for in-memory objects, must outlive dbg
+        std::unique_ptr<elf_object_access> object_access;
+        #endif
         // dwarf_finish needs to be called after all other dwarf stuff is cleaned up, e.g. `srcfiles` and aranges etc
         // raii_wrapping ensures this is the last thing done after the destructor logic and all other data members are
         // cleaned up
@@ -160,6 +171,64 @@ namespace libdwarf {
                 &dbg.get(),
                 &error
             );
+            finish_init("dwarf_init_path_a", ret, error);
+        }
+
+        #if IS_LINUX
+        // For in-memory objects, e.g. JIT code registered with cpptrace. The object and the memory it was opened from
+        // must outlive the resolver.
+        CPPTRACE_FORCE_NO_INLINE_FOR_PROFILING
+        dwarf_resolver(elf& object, cbspan data)
+            : dbg(nullptr, [](Dwarf_Debug dbg) { if(dbg) { dwarf_object_finish(dbg); } })
+        {
+            auto sections = object.get_section_headers();
+            if(sections.is_error()) {
+                if(!should_absorb_trace_exceptions()) {
+                    sections.drop_error();
+                }
+                ok = false;
+                return;
+            }
+            object_access = detail::make_unique<elf_object_access>(
+                data,
+                object.object_is_little_endian(),
+                object.object_is_64_bit(),
+                std::move(sections).unwrap_value()
+            );
+            dwarf_set_de_alloc_flag(0);
+            Dwarf_Error error = nullptr;
+            auto ret = dwarf_object_init_b(
+                object_access->get_interface(),
+                nullptr,
+                nullptr,
+                DW_GROUPNUMBER_ANY,
+                &dbg.get(),
+                &error
+            );
+            finish_init("dwarf_object_init_b", ret, error);
+        }
+        #endif
+
+        CPPTRACE_FORCE_NO_INLINE_FOR_PROFILING
+        ~dwarf_resolver() override {
+            stats::record_cache_release(stats::cache::line_table, line_tables.size());
+            stats::record_cache_release(stats::cache::subprogram, subprograms_cache.size());
+            if(aranges) {
+                for(int i = 0; i < arange_count; i++) {
+                    dwarf_dealloc(dbg, aranges[i], DW_DLA_ARANGE);
+                    aranges[i] = nullptr;
+                }
+                dwarf_dealloc(dbg, aranges, DW_DLA_LIST);
+            }
+        }
+
+        dwarf_resolver(const dwarf_resolver&) = delete;
+        dwarf_resolver& operator=(const dwarf_resolver&) = delete;
+        dwarf_resolver(dwarf_resolver&&) = delete;
+        dwarf_resolver& operator=(dwarf_resolver&&) = delete;
+
+    private:
+        void finish_init(const char* init_function, int ret, Dwarf_Error error) {
             if(ret == DW_DLV_OK) {
                 ok = true;
             } else if(ret == DW_DLV_NO_ENTRY) {
@@ -173,10 +242,10 @@ namespace libdwarf {
                     dwarf_errmsg(error),
                     [this, error] (char*) { dwarf_dealloc_error(dbg.get(), error); }
                 );
-                log::error("dwarf error: dwarf_init_path_a failed with error {} {}", ev, msg.get());
+                log::error("dwarf error: {} failed with error {} {}", init_function, ev, msg.get());
             } else {
                 ok = false;
-                PANIC("Unknown return code from dwarf_init_path");
+                PANIC(microfmt::format("Unknown return code from {}", init_function));
             }
 
             if(skeleton) {
@@ -189,23 +258,6 @@ namespace libdwarf {
             }
         }
 
-        CPPTRACE_FORCE_NO_INLINE_FOR_PROFILING
-        ~dwarf_resolver() override {
-            if(aranges) {
-                for(int i = 0; i < arange_count; i++) {
-                    dwarf_dealloc(dbg, aranges[i], DW_DLA_ARANGE);
-                    aranges[i] = nullptr;
-                }
-                dwarf_dealloc(dbg, aranges, DW_DLA_LIST);
-            }
-        }
-
-        dwarf_resolver(const dwarf_resolver&) = delete;
-        dwarf_resolver& operator=(const dwarf_resolver&) = delete;
-        dwarf_resolver(dwarf_resolver&&) = delete;
-        dwarf_resolver& operator=(dwarf_resolver&&) = delete;
-
-    private:
         // walk all CU's in a dbg, callback is called on each die and should return true to
         // continue traversal
         void walk_compilation_units(const std::function<bool(const die_object&)>& fn) {
@@ -256,6 +308,7 @@ namespace libdwarf {
 
         void lazy_generate_cu_cache() {
             if(!generated_cu_cache) {
+                probe_timer timer;
                 walk_compilation_units([this] (const die_object& cu_die) {
                     Dwarf_Half offset_size = 0;
                     Dwarf_Half dwversion = 0;
@@ -286,6 +339,7 @@ namespace libdwarf {
                 });
                 cu_cache.finalize();
                 generated_cu_cache = true;
+                CPPTRACE_PROBE3(cu__cache__build, object_path.c_str(), cu_cache.ranges_count(), timer.elapsed_ns());
             }
         }
 
@@ -576,12 +630,15 @@ namespace libdwarf {
                 auto off = cu_die.get_global_offset();
                 auto it = subprograms_cache.find(off);
                 if(it == subprograms_cache.end()) {
+                    stats::record_cache_insertion(stats::cache::subprogram);
                     // TODO: Refactor. Do the sort in the preprocess function and return the vec directly.
                     subprogram_map subprogram_cache;
                     preprocess_subprograms(cu_die, cu_die, dwversion, subprogram_cache);
                     subprogram_cache.finalize();
                     subprograms_cache.emplace(off, std::move(subprogram_cache));
                     it = subprograms_cache.find(off);
+                } else {
+                    stats::record_cache_hit(stats::cache::subprogram);
                 }
                 const auto& subprogram_cache = it->second;
                 auto maybe_die = subprogram_cache.lookup(pc);
@@ -598,8 +655,10 @@ namespace libdwarf {
             auto off = cu_die.get_global_offset();
             auto res = line_tables.maybe_get(off);
             if(res) {
+                stats::record_cache_hit(stats::cache::line_table);
                 return res;
             } else {
+                probe_timer timer;
                 Dwarf_Unsigned version;
                 Dwarf_Small table_count;
                 Dwarf_Line_Context line_context;
@@ -665,7 +724,12 @@ namespace libdwarf {
                     });
                 }
 
-                return line_tables.insert(off, line_table_info{version, line_context, std::move(line_entries)});
+                auto size = line_tables.size();
+                auto entry = line_tables.insert(off, line_table_info{version, line_context, std::move(line_entries)});
+                stats::record_cache_insertion(stats::cache::line_table);
+                stats::record_cache_evictions(stats::cache::line_table, size + 1 - line_tables.size());
+                CPPTRACE_PROBE3(line__table__load, object_path.c_str(), off, timer.elapsed_ns());
+                return entry;
             }
         }
 
@@ -1023,6 +1087,12 @@ namespace libdwarf {
     std::unique_ptr<symbol_resolver> make_dwarf_resolver(cstring_view object_path) {
         return detail::make_unique<dwarf_resolver>(object_path);
     }
+
+    #if IS_LINUX
+    std::unique_ptr<symbol_resolver> make_dwarf_resolver(elf& object, cbspan data) {
+        return detail::make_unique<dwarf_resolver>(object, data);
+    }
+    #endif
 }
 }
 CPPTRACE_END_NAMESPACE
@@ -0,0 +1,135 @@
+#ifndef OBJECT_ACCESS_HPP
+#define OBJECT_ACCESS_HPP
+
+#include "platform/platform.hpp"
+
+#if IS_LINUX
+
+#include "binary/elf.hpp"
+#include "symbols/dwarf/dwarf.hpp" // has dwarf #includes
+#include "utils/span.hpp"
+
+#include <utility>
+#include <vector>
+
+#include <elf.h>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+namespace libdwarf {
+    // Exposes an in-memory elf (e.g. a JIT object) to libdwarf through its object access interface, as opposed to
+    // dwarf_init_path which needs a file on disk.
+    // Section data is handed out directly from the in-memory image, objects are expected to already be in their final
+    // form so no relocations are applied.
+    class elf_object_access {
+        cbspan data;
+        bool little_endian;
+        bool is_64;
+        std::vector<elf::section_header> sections;
+        Dwarf_Obj_Access_Methods_a methods;
+        Dwarf_Obj_Access_Interface_a interface;
+
+        static elf_object_access& self(void* object) {
+            return *static_cast<elf_object_access*>(object);
+        }
+
+        static int get_section_info(
+            void* object,
+            Dwarf_Unsigned section_index,
+            Dwarf_Obj_Access_Section_a* return_section,
+            int* error
+        ) {
+            auto& access = self(object);
+            if(section_index >= access.sections.size()) {
+                *error = DW_DLE_MDE;
+                return DW_DLV_ERROR;
+            }
+            const auto& section = access.sections[section_index];
+            return_section->as_name = section.name.c_str();
+            return_section->as_type = section.type;
+            return_section->as_flags = section.flags;
+            return_section->as_addr = section.addr;
+            return_section->as_offset = section.offset;
+            return_section->as_size = section.size;
+            return_section->as_link = section.link;
+            return_section->as_info = section.info;
+            return_section->as_addralign = section.addralign;
+            return_section->as_entrysize = section.entsize;
+            return DW_DLV_OK;
+        }
+
+        static Dwarf_Small get_byte_order(void* object) {
+            return self(object).little_endian ? DW_END_little : DW_END_big;
+        }
+
+        static Dwarf_Small get_length_size(void* object) {
+            return self(object).is_64 ? 8 : 4;
+        }
+
+        static Dwarf_Small get_pointer_size(void* object) {
+            return self(object).is_64 ? 8 : 4;
+        }
+
+        static Dwarf_Unsigned get_filesize(void* object) {
+            return self(object).data.size();
+        }
+
+        static Dwarf_Unsigned get_section_count(void* object) {
+            return self(object).sections.size();
+        }
+
+        static int load_section(void* object, Dwarf_Unsigned section_index, Dwarf_Small** return_data, int* error) {
+            auto& access = self(object);
+            if(section_index >= access.sections.size()) {
+                *error = DW_DLE_MDE;
+                return DW_DLV_ERROR;
+            }
+            const auto& section = access.sections[section_index];
+            if(section.type == SHT_NOBITS || section.size == 0) {
+                return DW_DLV_NO_ENTRY;
+            }
+            if(section.offset > access.data.size() || section.size > access.data.size() - section.offset) {
+                *error = DW_DLE_ELF_SECT_ERR;
+                return DW_DLV_ERROR;
+            }
+            // libdwarf only writes to section data when relocating, which we never ask it to do
+            *return_data = reinterpret_cast<Dwarf_Small*>(const_cast<char*>(access.data.data() + section.offset));
+            return DW_DLV_OK;
+        }
+
+    public:
+        elf_object_access(
+            cbspan data,
+            bool little_endian,
+            bool is_64,
+            std::vector<elf::section_header> sections
+        ) : data(data), little_endian(little_endian), is_64(is_64), sections(std::move(sections)) {
+            methods.om_get_section_info = get_section_info;
+            methods.om_get_byte_order = get_byte_order;
+            methods.om_get_length_size = get_length_size;
+            methods.om_get_pointer_size = get_pointer_size;
+            methods.om_get_filesize = get_filesize;
+            methods.om_get_section_count = get_section_count;
+            methods.om_load_section = load_section;
+            methods.om_relocate_a_section = nullptr;
+            interface.ai_object = this;
+            interface.ai_methods = &methods;
+        }
+
+        // the interface refers back to this object, so it has to stay put once handed to libdwarf
+        elf_object_access(const elf_object_access&) = delete;
+        elf_object_access& operator=(const elf_object_access&) = delete;
+        elf_object_access(elf_object_access&&) = delete;
+        elf_object_access& operator=(elf_object_access&&) = delete;
+
+        Dwarf_Obj_Access_Interface_a* get_interface() {
+            return &interface;
+        }
+    };
+}
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
+
+#endif
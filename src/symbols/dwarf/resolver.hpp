@@ -4,6 +4,7 @@
 #include <cpptrace/basic.hpp>
 #include "symbols/symbols.hpp"
 #include "platform/platform.hpp"
+#include "utils/span.hpp"
 #include "utils/string_view.hpp"
 
 #include <memory>
@@ -16,6 +17,9 @@
 
 CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
+    #if IS_LINUX
+    class elf;
+    #endif
 namespace libdwarf {
     class symbol_resolver {
     public:
@@ -47,6 +51,10 @@ namespace libdwarf {
     };
 
     std::unique_ptr<symbol_resolver> make_dwarf_resolver(cstring_view object_path);
+    #if IS_LINUX
+     // for in-memory objects such as registered JIT code, the object and data must outlive the resolver
+     std::unique_ptr<symbol_resolver> make_dwarf_resolver(elf& object, cbspan data);
+    #endif
     #if IS_APPLE
      std::unique_ptr<symbol_resolver> make_debug_map_resolver(const std::string& object_path);
     #endif
@@ -0,0 +1,229 @@
+#include <cpptrace/basic.hpp>
+#include <cpptrace/serialization.hpp>
+#include <cpptrace/utils.hpp>
+
+#include "symbols/symbols.hpp"
+#include "logging.hpp"
+#include "platform/platform.hpp"
+#include "statistics.hpp"
+#include "utils/atomic_shared_ptr.hpp"
+#include "utils/optional.hpp"
+#include "utils/utils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if IS_LINUX || IS_APPLE
+ #include <cerrno>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <sys/socket.h>
+ #include <sys/time.h>
+ #include <sys/un.h>
+#endif
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+namespace remote {
+    // Protocol: the client connects, writes a serialized trace stream holding one object trace, and shuts down its
+    // side of the connection. The symbolizer answers with a stream holding one resolved trace with symbols left
+    // mangled, and closes the connection. Each object frame resolves to its inlined frames, if any, followed by one
+    // non-inlined frame.
+
+    // null when remote symbolization is off
+    atomic_shared_ptr<const std::string> socket_path;
+    // After a failed request the symbolizer isn't tried again for a little while so that a symbolizer which is down
+    // doesn't cost a connection attempt (or a timeout) on every trace
+    std::atomic<std::chrono::steady_clock::rep> next_attempt{0};
+    constexpr std::chrono::seconds retry_interval{1};
+    // Resolving frames from a large binary for the first time can take the symbolizer a while
+    constexpr int timeout_seconds = 10;
+
+    // Checks that a resolved trace has one non-inlined frame per object frame, closing off each frame's inlines
+    bool lines_up(const std::vector<stacktrace_frame>& trace, std::size_t frame_count) {
+        std::size_t count = 0;
+        for(const auto& frame : trace) {
+            if(!frame.is_inline) {
+                count++;
+            }
+        }
+        return count == frame_count && (trace.empty() || !trace.back().is_inline);
+    }
+
+    // Appends the frames one object frame resolved to, i.e. up to and including the next non-inlined frame
+    void take_frames(
+        std::vector<stacktrace_frame>& trace,
+        std::vector<stacktrace_frame>::iterator& it,
+        const std::vector<stacktrace_frame>::iterator& end
+    ) {
+        while(it != end) {
+            bool last = !it->is_inline;
+            trace.push_back(std::move(*it++));
+            if(last) {
+                break;
+            }
+        }
+    }
+
+    #if IS_LINUX || IS_APPLE
+    #if IS_APPLE
+     // SO_NOSIGPIPE is set on the socket instead
+     constexpr int send_flags = 0;
+    #else
+     constexpr int send_flags = MSG_NOSIGNAL;
+    #endif
+
+    bool send_all(int fd, const std::string& data) {
+        std::size_t sent = 0;
+        while(sent < data.size()) {
+            auto count = send(fd, data.data() + sent, data.size() - sent, send_flags);
+            if(count < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            sent += to<std::size_t>(count);
+        }
+        return true;
+    }
+
+    optional<std::vector<stacktrace_frame>> request(const std::string& path, const std::vector<object_frame>& frames) {
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if(path.size() >= sizeof(addr.sun_path)) {
+            log::warn("Remote symbolizer socket path is too long: {}", path);
+            return nullopt;
+        }
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(fd == -1) {
+            log::warn("Failed to create a socket for the remote symbolizer: {}", strerror(errno));
+            return nullopt;
+        }
+        auto closer = raii_wrap(fd, [] (int fd) { close(fd); });
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        timeval timeout{timeout_seconds, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        #if IS_APPLE
+         int one = 1;
+         setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+        #endif
+        if(connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == -1) {
+            log::warn("Failed to connect to the remote symbolizer at {}: {}", path, strerror(errno));
+            return nullopt;
+        }
+
+        experimental::trace_encoder encoder;
+        encoder.encode(object_trace{frames});
+        if(!send_all(fd, encoder.data()) || shutdown(fd, SHUT_WR) == -1) {
+            log::warn("Failed to send frames to the remote symbolizer: {}", strerror(errno));
+            return nullopt;
+        }
+
+        experimental::trace_decoder decoder;
+        experimental::decoded_trace response;
+        char buffer[4096];
+        experimental::decode_status status;
+        while((status = decoder.next(response)) == experimental::decode_status::need_more_input) {
+            auto count = recv(fd, buffer, sizeof(buffer), 0);
+            if(count < 0 && errno == EINTR) {
+                continue;
+            }
+            if(count <= 0) {
+                log::warn(
+                    "Failed to receive a response from the remote symbolizer: {}",
+                    count == 0 ? "connection closed" : strerror(errno)
+                );
+                return nullopt;
+            }
+            decoder.feed(buffer, to<std::size_t>(count));
+        }
+        if(
+            status != experimental::decode_status::ok
+            || response.type != experimental::decoded_trace::trace_type::resolved
+            || !lines_up(response.resolved.frames, frames.size())
+        ) {
+            log::warn("Malformed response from the remote symbolizer");
+            return nullopt;
+        }
+        return std::move(response.resolved.frames);
+    }
+    #else
+    optional<std::vector<stacktrace_frame>> request(const std::string&, const std::vector<object_frame>&) {
+        return nullopt;
+    }
+    #endif
+
+    bool is_enabled() {
+        return !IS_WINDOWS && socket_path.load() != nullptr;
+    }
+
+    optional<std::vector<stacktrace_frame>> resolve_frames(const std::vector<object_frame>& frames) {
+        auto path = socket_path.load();
+        if(!path) {
+            return nullopt;
+        }
+        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        if(now < next_attempt.load(std::memory_order_relaxed)) {
+            return nullopt;
+        }
+        // addresses in JIT code or unknown mappings mean nothing in the symbolizer's process
+        std::vector<object_frame> remote_frames;
+        std::vector<object_frame> local_frames;
+        for(const auto& frame : frames) {
+            (frame.object_path.empty() ? local_frames : remote_frames).push_back(frame);
+        }
+        if(remote_frames.empty()) {
+            return nullopt;
+        }
+        optional<std::vector<stacktrace_frame>> remote_trace;
+        {
+            stats::resolution_timer timer(stats::backend::remote, remote_frames.size());
+            remote_trace = request(*path, remote_frames);
+        }
+        if(!remote_trace.has_value()) {
+            next_attempt.store(
+                now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(retry_interval).count(),
+                std::memory_order_relaxed
+            );
+            return nullopt;
+        }
+        if(local_frames.empty()) {
+            return remote_trace;
+        }
+        auto local_trace = resolve_frames_locally(local_frames);
+        std::vector<stacktrace_frame> trace;
+        trace.reserve(remote_trace.unwrap().size() + local_trace.size());
+        auto remote_it = remote_trace.unwrap().begin();
+        auto local_it = local_trace.begin();
+        for(const auto& frame : frames) {
+            if(frame.object_path.empty()) {
+                take_frames(trace, local_it, local_trace.end());
+            } else {
+                take_frames(trace, remote_it, remote_trace.unwrap().end());
+            }
+        }
+        return trace;
+    }
+}
+}
+CPPTRACE_END_NAMESPACE
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace experimental {
+    void use_remote_symbolizer(std::string socket_path) {
+        detail::remote::socket_path.store(
+            socket_path.empty() ? nullptr : std::make_shared<const std::string>(std::move(socket_path))
+        );
+        detail::remote::next_attempt.store(0, std::memory_order_relaxed);
+    }
+}
+CPPTRACE_END_NAMESPACE
@@ -3,6 +3,8 @@
 
 #include <cpptrace/basic.hpp>
 
+#include "utils/optional.hpp"
+
 #include <functional>
 #include <string>
 #include <unordered_map>
@@ -40,6 +42,8 @@ namespace detail {
     #ifdef CPPTRACE_GET_SYMBOLS_WITH_LIBDWARF
     namespace libdwarf {
         std::vector<stacktrace_frame> resolve_frames(const std::vector<object_frame>& frames);
+        // Only consults symbol tables, never constructs a dwarf resolver
+        std::vector<stacktrace_frame> resolve_frames_from_symbol_tables(const std::vector<object_frame>& frames);
     }
     #endif
     #ifdef CPPTRACE_GET_SYMBOLS_WITH_LIBDL
@@ -64,8 +68,20 @@ namespace detail {
     }
     #endif
 
+    // Resolution through a cpptrace-symbolizerd process, see experimental::use_remote_symbolizer
+    namespace remote {
+        bool is_enabled();
+        // Returns nullopt if remote symbolization is off or the request failed. Frames without an object path (e.g.
+        // JIT code) mean nothing to the symbolizer, they're resolved with resolve_frames_locally.
+        optional<std::vector<stacktrace_frame>> resolve_frames(const std::vector<object_frame>& frames);
+    }
+
     std::vector<stacktrace_frame> resolve_frames(const std::vector<object_frame>& frames);
+    // Resolves with the configured back-end(s) in this process, never through the remote symbolizer
+    std::vector<stacktrace_frame> resolve_frames_locally(const std::vector<object_frame>& frames);
     std::vector<stacktrace_frame> resolve_frames(const std::vector<frame_ptr>& frames);
+    std::vector<stacktrace_frame> resolve_frames(const std::vector<object_frame>& frames, resolution_level level);
+    std::vector<stacktrace_frame> resolve_frames(const std::vector<frame_ptr>& frames, resolution_level level);
 }
 CPPTRACE_END_NAMESPACE
 
@@ -4,6 +4,7 @@
 #include "cpptrace/forward.hpp"
 #include "symbols/symbols.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 
@@ -87,6 +88,14 @@ namespace detail {
     // TODO: Symbol resolution code should probably handle when object addresses are 0
 
     std::vector<stacktrace_frame> resolve_frames(const std::vector<object_frame>& frames) {
+        auto remote_trace = remote::resolve_frames(frames);
+        if(remote_trace.has_value()) {
+            return std::move(remote_trace).unwrap();
+        }
+        return resolve_frames_locally(frames);
+    }
+
+    std::vector<stacktrace_frame> resolve_frames_locally(const std::vector<object_frame>& frames) {
         #if defined(CPPTRACE_GET_SYMBOLS_WITH_LIBDWARF) && defined(CPPTRACE_GET_SYMBOLS_WITH_DBGHELP)
          std::vector<stacktrace_frame> trace = libdwarf::resolve_frames(frames);
          fill_blanks(trace, dbghelp::resolve_frames);
@@ -123,6 +132,9 @@ namespace detail {
     }
 
     std::vector<stacktrace_frame> resolve_frames(const std::vector<frame_ptr>& frames) {
+        if(remote::is_enabled()) {
+            return resolve_frames(get_frames_object_info(frames));
+        }
         #if defined(CPPTRACE_GET_SYMBOLS_WITH_LIBDWARF) \
             || defined(CPPTRACE_GET_SYMBOLS_WITH_ADDR2LINE)
          auto dlframes = get_frames_object_info(frames);
@@ -152,5 +164,84 @@ namespace detail {
          #endif
         #endif
     }
+
+    std::vector<stacktrace_frame> resolve_object_info_only(const std::vector<object_frame>& frames) {
+        std::vector<stacktrace_frame> trace;
+        trace.reserve(frames.size());
+        for(const auto& dlframe : frames) {
+            trace.push_back({
+                dlframe.raw_address,
+                dlframe.object_address,
+                nullable<std::uint32_t>::null(),
+                nullable<std::uint32_t>::null(),
+                dlframe.object_path,
+                "",
+                false
+            });
+        }
+        return trace;
+    }
+
+    void drop_inlined_frames(std::vector<stacktrace_frame>& trace) {
+        trace.erase(
+            std::remove_if(
+                trace.begin(),
+                trace.end(),
+                [] (const stacktrace_frame& frame) { return frame.is_inline; }
+            ),
+            trace.end()
+        );
+    }
+
+    // For back-ends without a cheaper path for a given level: trim a full resolution down to what was asked for, so
+    // that output is consistent regardless of the back-end in use
+    void trim_to_resolution_level(
+        std::vector<stacktrace_frame>& trace,
+        const std::vector<object_frame>& frames,
+        resolution_level level
+    ) {
+        if(level == resolution_level::full_with_inlines) {
+            return;
+        }
+        drop_inlined_frames(trace);
+        if(level == resolution_level::symbol_only) {
+            for(std::size_t i = 0; i < trace.size(); i++) {
+                auto& frame = trace[i];
+                frame.line = nullable<std::uint32_t>::null();
+                frame.column = nullable<std::uint32_t>::null();
+                frame.filename = trace.size() == frames.size() ? frames[i].object_path : "";
+            }
+        }
+    }
+
+    std::vector<stacktrace_frame> resolve_frames(const std::vector<object_frame>& frames, resolution_level level) {
+        if(level == resolution_level::address_only) {
+            return resolve_object_info_only(frames);
+        }
+        #ifdef CPPTRACE_GET_SYMBOLS_WITH_LIBDWARF
+        if(level == resolution_level::symbol_only) {
+            std::vector<stacktrace_frame> trace = libdwarf::resolve_frames_from_symbol_tables(frames);
+            #ifdef CPPTRACE_GET_SYMBOLS_WITH_DBGHELP
+             fill_blanks(trace, dbghelp::resolve_frames);
+            #endif
+            return trace;
+        }
+        #endif
+        std::vector<stacktrace_frame> trace = resolve_frames(frames);
+        trim_to_resolution_level(trace, frames, level);
+        return trace;
+    }
+
+    std::vector<stacktrace_frame> resolve_frames(const std::vector<frame_ptr>& frames, resolution_level level) {
+        if(level == resolution_level::full_with_inlines) {
+            return resolve_frames(frames);
+        } else if(level == resolution_level::symbol_and_line) {
+            std::vector<stacktrace_frame> trace = resolve_frames(frames);
+            drop_inlined_frames(trace);
+            return trace;
+        } else {
+            return resolve_frames(get_frames_object_info(frames), level);
+        }
+    }
 }
 CPPTRACE_END_NAMESPACE
@@ -3,12 +3,17 @@
 #include <cpptrace/basic.hpp>
 #include "symbols/symbols.hpp"
 #include "utils/common.hpp"
+#include "utils/lru_cache.hpp"
 #include "utils/microfmt.hpp"
 #include "utils/utils.hpp"
 
+#include <cerrno>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -16,18 +21,29 @@
 #include <vector>
 
 #if IS_LINUX || IS_APPLE
+ #include <fcntl.h>
+ #include <poll.h>
  #include <unistd.h>
+ #include <sys/socket.h>
  #include <sys/types.h>
  #include <sys/wait.h>
 #endif
 
 #include "binary/object.hpp"
 #include "options.hpp"
+#include "platform/probes.hpp"
+#include "statistics.hpp"
 
 CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
 namespace addr2line {
     #if IS_LINUX || IS_APPLE
+    #if !IS_APPLE
+     constexpr const char* addr2line_program = "addr2line";
+    #else
+     constexpr const char* addr2line_program = "atos";
+    #endif
+
     bool has_addr2line() {
         static std::mutex mutex;
         static bool has_addr2line = false;
@@ -35,112 +51,235 @@ namespace addr2line {
         std::lock_guard<std::mutex> lock(mutex);
         if(!checked) {
             checked = true;
-            // Detects if addr2line exists by trying to invoke addr2line --help
-            constexpr int magic = 42;
-            const pid_t pid = fork();
-            if(pid == -1) { return false; }
-            if(pid == 0) { // child
-                close(STDOUT_FILENO);
-                close(STDERR_FILENO); // atos --help writes to stderr
+            // Detects if addr2line exists by checking for an executable file, no need to spawn a process for this
+            #ifdef CPPTRACE_ADDR2LINE_SEARCH_SYSTEM_PATH
+            // Search the path the same way execlp will
+            const char* path = std::getenv("PATH");
+            if(path) {
+                for(const auto& dir : split(path, ":")) {
+                    auto candidate = (dir.empty() ? std::string(".") : dir) + "/" + addr2line_program;
+                    if(access(candidate.c_str(), X_OK) == 0) {
+                        has_addr2line = true;
+                        break;
+                    }
+                }
+            }
+            #else
+            #ifndef CPPTRACE_ADDR2LINE_PATH
+            #error "CPPTRACE_ADDR2LINE_PATH must be defined if CPPTRACE_ADDR2LINE_SEARCH_SYSTEM_PATH is not"
+            #endif
+            has_addr2line = access(CPPTRACE_ADDR2LINE_PATH, X_OK) == 0;
+            #endif
+        }
+        return has_addr2line;
+    }
+
+    #if IS_LINUX
+     constexpr int send_flags = MSG_NOSIGNAL;
+    #else
+     constexpr int send_flags = 0; // SO_NOSIGPIPE is set on the socket instead
+    #endif
+
+    // A long-lived addr2line / atos child for a single object file. Both the child's stdin and stdout are connected
+    // to one end of a socket pair, addresses are written to it and one line of output is read back per address.
+    class addr2line_process {
+        pid_t pid = -1;
+        int fd = -1;
+        // output which has been read but not yet consumed
+        std::string pending;
+        std::chrono::steady_clock::time_point last_used = std::chrono::steady_clock::now();
+
+    public:
+        explicit addr2line_process(const std::string& executable) {
+            probe_timer timer;
+            int sockets[2];
+            if(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+                throw internal_error("call to socketpair failed: {}", errno);
+            }
+            // The parent's end must not leak into other children, otherwise they wouldn't see EOF when we close it
+            fcntl(sockets[0], F_SETFD, FD_CLOEXEC);
+            const pid_t child = fork();
+            if(child == -1) {
+                close(sockets[0]);
+                close(sockets[1]);
+                throw internal_error("call to fork failed: {}", errno);
+            }
+            if(child == 0) { // child
+                dup2(sockets[1], STDIN_FILENO);
+                dup2(sockets[1], STDOUT_FILENO);
+                close(sockets[0]);
+                close(sockets[1]);
+                close(STDERR_FILENO); // TODO: Might be worth conditionally enabling or piping
                 #ifdef CPPTRACE_ADDR2LINE_SEARCH_SYSTEM_PATH
                 #if !IS_APPLE
-                execlp("addr2line", "addr2line", "--help", nullptr);
+                execlp("addr2line", "addr2line", "-e", executable.c_str(), "-f", "-C", "-p", nullptr);
                 #else
-                execlp("atos", "atos", "--help", nullptr);
+                execlp("atos", "atos", "-o", executable.c_str(), "-fullPath", nullptr);
                 #endif
                 #else
-                #ifndef CPPTRACE_ADDR2LINE_PATH
-                #error "CPPTRACE_ADDR2LINE_PATH must be defined if CPPTRACE_ADDR2LINE_SEARCH_SYSTEM_PATH is not"
+                #if !IS_APPLE
+                execl(
+                    CPPTRACE_ADDR2LINE_PATH,
+                    CPPTRACE_ADDR2LINE_PATH,
+                    "-e",
+                    executable.c_str(),
+                    "-f",
+                    "-C",
+                    "-p",
+                    nullptr
+                );
+                #else
+                execl(
+                    CPPTRACE_ADDR2LINE_PATH,
+                    CPPTRACE_ADDR2LINE_PATH,
+                    "-o", executable.c_str(),
+                    "-fullPath",
+                    nullptr
+                );
                 #endif
-                execl(CPPTRACE_ADDR2LINE_PATH, CPPTRACE_ADDR2LINE_PATH, "--help", nullptr);
                 #endif
-                _exit(magic);
+                _exit(1); // TODO: Diagnostic?
             }
-            int status;
-            waitpid(pid, &status, 0);
-            has_addr2line = WEXITSTATUS(status) == 0;
+            close(sockets[1]);
+            pid = child;
+            fd = sockets[0];
+            // non-blocking so that writes and reads can be interleaved
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            #if IS_APPLE
+            int one = 1;
+            setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+            #endif
+            CPPTRACE_PROBE2(resolver__create, executable.c_str(), timer.elapsed_ns());
         }
-        return has_addr2line;
-    }
 
-    struct pipe_ends {
-        int read;
-        int write;
-    };
+        ~addr2line_process() {
+            // addr2line exits once it sees EOF on stdin
+            close(fd);
+            waitpid(pid, nullptr, 0);
+        }
+
+        addr2line_process(const addr2line_process&) = delete;
+        addr2line_process(addr2line_process&&) = delete;
+        addr2line_process& operator=(const addr2line_process&) = delete;
+        addr2line_process& operator=(addr2line_process&&) = delete;
+
+        std::chrono::steady_clock::time_point get_last_used() const {
+            return last_used;
+        }
+
+        // Requests are pipelined: all addresses are sent without waiting for individual responses, reads are
+        // interleaved with writes so neither side can stall on a full socket buffer
+        std::vector<std::string> resolve(const std::vector<frame_ptr>& addresses) {
+            std::string request;
+            for(const auto address : addresses) {
+                request += microfmt::format("{:h}\n", address);
+            }
+            std::vector<std::string> lines;
+            lines.reserve(addresses.size());
+            std::size_t written = 0;
+            constexpr std::size_t buffer_size = 4096;
+            char buffer[buffer_size];
+            while(lines.size() < addresses.size()) {
+                pollfd poll_fd;
+                poll_fd.fd = fd;
+                poll_fd.events = static_cast<short>(POLLIN | (written < request.size() ? POLLOUT : 0));
+                poll_fd.revents = 0;
+                if(poll(&poll_fd, 1, -1) == -1) {
+                    if(errno == EINTR) {
+                        continue;
+                    }
+                    throw internal_error("call to poll failed: {}", errno);
+                }
+                if(poll_fd.revents & POLLNVAL) {
+                    throw internal_error("addr2line socket is invalid");
+                }
+                if(poll_fd.revents & POLLOUT) {
+                    const auto count = send(fd, request.data() + written, request.size() - written, send_flags);
+                    if(count == -1) {
+                        if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                            throw internal_error("call to send failed: {}", errno);
+                        }
+                    } else {
+                        written += static_cast<std::size_t>(count);
+                    }
+                }
+                if(poll_fd.revents & (POLLIN | POLLHUP | POLLERR)) {
+                    const auto count = read(fd, buffer, buffer_size);
+                    if(count == 0) {
+                        throw internal_error("addr2line exited unexpectedly");
+                    } else if(count == -1) {
+                        if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                            throw internal_error("call to read failed: {}", errno);
+                        }
+                    } else {
+                        pending.append(buffer, static_cast<std::size_t>(count));
+                        take_lines(lines, addresses.size());
+                    }
+                }
+            }
+            // anything left over means we're out of sync with the child
+            VERIFY(pending.empty(), "Unexpected output from addr2line");
+            last_used = std::chrono::steady_clock::now();
+            return lines;
+        }
 
-    struct pipe_t {
-        union {
-            pipe_ends end;
-            int data[2];
-        };
+    private:
+        void take_lines(std::vector<std::string>& lines, std::size_t count) {
+            std::size_t start = 0;
+            std::size_t newline;
+            while(lines.size() < count && (newline = pending.find('\n', start)) != std::string::npos) {
+                lines.push_back(pending.substr(start, newline - start));
+                start = newline + 1;
+            }
+            pending.erase(0, start);
+        }
     };
-    static_assert(sizeof(pipe_t) == 2 * sizeof(int), "Unexpected struct packing");
 
-    std::string resolve_addresses(const std::string& addresses, const std::string& executable) {
-        pipe_t output_pipe;
-        pipe_t input_pipe;
-        if(pipe(output_pipe.data) != 0 || pipe(input_pipe.data) != 0) {
-            throw internal_error("call to pipe failed: {}", errno);
+    // Bounds on the coprocess pool, each child holds the parsed debug info for an object file in memory
+    constexpr std::size_t max_addr2line_processes = 8;
+    constexpr std::chrono::seconds addr2line_idle_timeout{30};
+
+    std::vector<std::string> resolve_addresses(const std::vector<frame_ptr>& addresses, const std::string& executable) {
+        if(get_cache_mode() != cache_mode::prioritize_speed) {
+            // don't keep children around between traces
+            stats::record_cache_miss(stats::cache::resolver);
+            return addr2line_process(executable).resolve(addresses);
         }
-        const pid_t pid = fork();
-        if(pid == -1) { return ""; } // error? TODO: Diagnostic
-        if(pid == 0) { // child
-            dup2(output_pipe.end.write, STDOUT_FILENO);
-            dup2(input_pipe.end.read, STDIN_FILENO);
-            close(output_pipe.end.read);
-            close(output_pipe.end.write);
-            close(input_pipe.end.read);
-            close(input_pipe.end.write);
-            close(STDERR_FILENO); // TODO: Might be worth conditionally enabling or piping
-            #ifdef CPPTRACE_ADDR2LINE_SEARCH_SYSTEM_PATH
-            #if !IS_APPLE
-            execlp("addr2line", "addr2line", "-e", executable.c_str(), "-f", "-C", "-p", nullptr);
-            #else
-            execlp("atos", "atos", "-o", executable.c_str(), "-fullPath", nullptr);
-            #endif
-            #else
-            #ifndef CPPTRACE_ADDR2LINE_PATH
-            #error "CPPTRACE_ADDR2LINE_PATH must be defined if CPPTRACE_ADDR2LINE_SEARCH_SYSTEM_PATH is not"
-            #endif
-            #if !IS_APPLE
-            execl(
-                CPPTRACE_ADDR2LINE_PATH,
-                CPPTRACE_ADDR2LINE_PATH,
-                "-e",
-                executable.c_str(),
-                "-f",
-                "-C",
-                "-p",
-                nullptr
-            );
-            #else
-            execl(
-                CPPTRACE_ADDR2LINE_PATH,
-                CPPTRACE_ADDR2LINE_PATH,
-                "-o", executable.c_str(),
-                "-fullPath",
-                nullptr
-            );
-            #endif
-            #endif
-            _exit(1); // TODO: Diagnostic?
+        static std::mutex mutex;
+        static lru_cache<std::string, std::unique_ptr<addr2line_process>> pool{max_addr2line_processes};
+        static pid_t owner = getpid();
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto now = std::chrono::steady_clock::now();
+        auto pool_size = pool.size();
+        if(owner != getpid()) {
+            // we've been forked, the children in the pool belong to the parent process
+            pool.trim_while([] (const std::unique_ptr<addr2line_process>&) { return true; });
+            owner = getpid();
         }
-        if(write(input_pipe.end.write, addresses.data(), addresses.size()) == -1) {
-            throw internal_error("call to write failed: {}", errno);
+        // Idle children are only reaped when resolution happens, there is no background thread
+        pool.trim_while([now] (const std::unique_ptr<addr2line_process>& process) {
+            return now - process->get_last_used() > addr2line_idle_timeout;
+        });
+        stats::record_cache_evictions(stats::cache::resolver, pool_size - pool.size());
+        auto maybe_process = pool.maybe_get(executable);
+        addr2line_process* process;
+        if(maybe_process) {
+            stats::record_cache_hit(stats::cache::resolver);
+            process = maybe_process.unwrap().get();
+        } else {
+            pool_size = pool.size();
+            process = pool.insert(executable, detail::make_unique<addr2line_process>(executable)).unwrap().get();
+            stats::record_cache_insertion(stats::cache::resolver);
+            stats::record_cache_evictions(stats::cache::resolver, pool_size + 1 - pool.size());
         }
-        close(input_pipe.end.read);
-        close(input_pipe.end.write);
-        close(output_pipe.end.write);
-        std::string output;
-        constexpr int buffer_size = 4096;
-        char buffer[buffer_size];
-        std::size_t count = 0;
-        while((count = read(output_pipe.end.read, buffer, buffer_size)) > 0) {
-            output.insert(output.end(), buffer, buffer + count);
+        try {
+            return process->resolve(addresses);
+        } catch(...) {
+            // the child is in an unknown state, don't reuse it
+            pool.erase(executable);
+            stats::record_cache_evictions(stats::cache::resolver, 1);
+            throw;
         }
-        // TODO: check status from addr2line?
-        waitpid(pid, nullptr, 0);
-        return output;
     }
     #elif IS_WINDOWS
     bool has_addr2line() {
@@ -166,7 +305,11 @@ namespace addr2line {
         return has_addr2line;
     }
 
-    std::string resolve_addresses(const std::string& addresses, const std::string& executable) {
+    std::vector<std::string> resolve_addresses(const std::vector<frame_ptr>& address_list, const std::string& executable) {
+        std::string addresses;
+        for(const auto address : address_list) {
+            addresses += microfmt::format("{:h} ", address);
+        }
         // TODO: Popen is a hack. Implement properly with CreateProcess and pipes later.
         ///fprintf(stderr, ("addr2line -e " + executable + " -fCp " + addresses + "\n").c_str());
         #ifdef CPPTRACE_ADDR2LINE_SEARCH_SYSTEM_PATH
@@ -189,7 +332,7 @@ namespace addr2line {
         }
         pclose(p);
         ///fprintf(stderr, "%s\n", output.c_str());
-        return output;
+        return split(trim(output), "\n");
     }
     #endif
 
@@ -273,6 +416,7 @@ namespace addr2line {
     }
 
     std::vector<stacktrace_frame> resolve_frames(const std::vector<object_frame>& frames) {
+        stats::resolution_timer timer(stats::backend::addr2line, frames.size());
         // TODO: Refactor better
         std::vector<stacktrace_frame> trace(frames.size(), null_frame());
         for(std::size_t i = 0; i < frames.size(); i++) {
@@ -297,19 +441,12 @@ namespace addr2line {
                     if(entries_vec.empty()) {
                         continue;
                     }
-                    std::string address_input;
+                    std::vector<frame_ptr> addresses;
+                    addresses.reserve(entries_vec.size());
                     for(const auto& pair : entries_vec) {
-                        address_input += microfmt::format(
-                            "{:h}{}",
-                            pair.first.get().object_address,
-                        #if !IS_WINDOWS
-                            '\n'
-                        #else
-                            ' '
-                        #endif
-                        );
+                        addresses.push_back(pair.first.get().object_address);
                     }
-                    auto output = split(trim(resolve_addresses(address_input, object_name)), "\n");
+                    auto output = resolve_addresses(addresses, object_name);
                     VERIFY(output.size() == entries_vec.size());
                     for(std::size_t i = 0; i < output.size(); i++) {
                         update_trace(output[i], i, entries_vec);
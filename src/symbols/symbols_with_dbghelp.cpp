@@ -10,6 +10,7 @@
 #include "utils/utils.hpp"
 #include "options.hpp"
 #include "logging.hpp"
+#include "statistics.hpp"
 
 #include <regex>
 #include <system_error>
@@ -425,6 +426,7 @@ namespace dbghelp {
     }
 
     std::vector<stacktrace_frame> resolve_frames(const std::vector<frame_ptr>& frames) {
+        stats::resolution_timer timer(stats::backend::dbghelp, frames.size());
         // Dbghelp is is single-threaded, so acquire a lock.
         auto lock = get_dbghelp_lock();
         std::vector<stacktrace_frame> trace;
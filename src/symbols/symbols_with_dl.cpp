@@ -3,6 +3,7 @@
 #include <cpptrace/basic.hpp>
 #include "symbols/symbols.hpp"
 #include "binary/module_base.hpp"
+#include "statistics.hpp"
 
 #include <cstdint>
 #include <memory>
@@ -42,6 +43,7 @@ namespace libdl {
     }
 
     std::vector<stacktrace_frame> resolve_frames(const std::vector<frame_ptr>& frames) {
+        stats::resolution_timer timer(stats::backend::libdl, frames.size());
         std::vector<stacktrace_frame> trace;
         trace.reserve(frames.size());
         for(const auto frame : frames) {
@@ -6,6 +6,7 @@
 #include "utils/error.hpp"
 #include "utils/common.hpp"
 #include "options.hpp"
+#include "statistics.hpp"
 
 #include <cstdint>
 #include <cstdio>
@@ -93,6 +94,7 @@ namespace libbacktrace {
     }
 
     std::vector<stacktrace_frame> resolve_frames(const std::vector<frame_ptr>& frames) {
+        stats::resolution_timer timer(stats::backend::libbacktrace, frames.size());
         std::vector<stacktrace_frame> trace;
         trace.reserve(frames.size());
         for(const auto frame : frames) {
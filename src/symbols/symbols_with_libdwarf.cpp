@@ -10,6 +10,9 @@
 #include "binary/elf.hpp"
 #include "binary/mach-o.hpp"
 #include "jit/jit_objects.hpp"
+#include "options.hpp"
+#include "platform/probes.hpp"
+#include "statistics.hpp"
 
 #include <cstdint>
 #include <cstdio>
@@ -37,13 +40,18 @@ namespace libdwarf {
         static std::unordered_map<std::string, std::unique_ptr<symbol_resolver>> resolver_map;
         auto it = resolver_map.find(object_name);
         if(it != resolver_map.end()) {
+            stats::record_cache_hit(stats::cache::resolver);
             return it->second.get();
         } else {
+            probe_timer timer;
             std::unique_ptr<symbol_resolver> resolver_object = get_resolver_for_object(object_name);
+            CPPTRACE_PROBE2(resolver__create, object_name.c_str(), timer.elapsed_ns());
             if(get_cache_mode() == cache_mode::prioritize_speed) {
+                stats::record_cache_insertion(stats::cache::resolver);
                 // .emplace needed, for some reason .insert tries to copy <= gcc 7.2
                 return resolver_map.emplace(object_name, std::move(resolver_object)).first->second.get();
             } else {
+                stats::record_cache_miss(stats::cache::resolver);
                 // gcc 4 has trouble with automatic moves of locals here https://godbolt.org/z/9oWdWjbf8
                 return maybe_owned<symbol_resolver>{std::move(resolver_object)};
             }
@@ -85,18 +93,6 @@ namespace libdwarf {
         return final_trace;
     }
 
-    #if IS_LINUX || IS_APPLE
-    CPPTRACE_FORCE_NO_INLINE_FOR_PROFILING
-    void try_resolve_jit_frame(const cpptrace::object_frame& dlframe, frame_with_inlines& frame) {
-        auto object_res = lookup_jit_object(dlframe.raw_address);
-        // TODO: At some point, dwarf resolution
-        if(object_res) {
-            frame.frame.symbol = object_res.unwrap().object
-                .lookup_symbol(dlframe.raw_address - object_res.unwrap().base).value_or("");
-        }
-    }
-    #endif
-
     CPPTRACE_FORCE_NO_INLINE_FOR_PROFILING
     void try_resolve_frame(
         symbol_resolver* resolver,
@@ -104,7 +100,9 @@ namespace libdwarf {
         frame_with_inlines& frame
     ) {
         try {
+            probe_timer timer;
             frame = resolver->resolve_frame(dlframe);
+            CPPTRACE_PROBE3(frame__resolve, dlframe.object_path.c_str(), dlframe.object_address, timer.elapsed_ns());
         } catch(...) {
             detail::log_and_maybe_propagate_exception(std::current_exception());
             frame.frame.raw_address = dlframe.raw_address;
@@ -113,20 +111,81 @@ namespace libdwarf {
         }
     }
 
+    // Locking around all libdwarf interaction per https://github.com/davea42/libdwarf-code/discussions/184
+    // And also locking for interactions with get_resolver and the shared elf / mach-o objects
+    // Recursive since JIT resolvers take the lock when torn down, which can happen during resolution if the object is
+    // unregistered concurrently
+    std::recursive_mutex& get_resolution_mutex() {
+        static std::recursive_mutex mutex;
+        return mutex;
+    }
+
+    #if IS_LINUX
+    // not thread-safe, relies on caller to lock
+    maybe_owned<symbol_resolver> get_jit_resolver(jit_object_entry& entry) {
+        if(entry.resolver) {
+            return static_cast<symbol_resolver*>(entry.resolver.get());
+        }
+        std::unique_ptr<symbol_resolver> resolver_object = make_dwarf_resolver(entry.object, entry.data);
+        if(get_cache_mode() == cache_mode::prioritize_speed) {
+            // the resolver lives as long as the jit object is registered, the last reference can be dropped by
+            // unregister_jit_object on any thread
+            entry.resolver = std::shared_ptr<symbol_resolver>(
+                resolver_object.release(),
+                [] (symbol_resolver* resolver) {
+                    const std::lock_guard<std::recursive_mutex> lock(get_resolution_mutex());
+                    delete resolver;
+                }
+            );
+            return static_cast<symbol_resolver*>(entry.resolver.get());
+        } else {
+            return maybe_owned<symbol_resolver>{std::move(resolver_object)};
+        }
+    }
+    #endif
+
+    #if IS_LINUX || IS_APPLE
+    CPPTRACE_FORCE_NO_INLINE_FOR_PROFILING
+    void try_resolve_jit_frame(const cpptrace::object_frame& dlframe, frame_with_inlines& frame, bool use_dwarf) {
+        auto object_res = lookup_jit_object(dlframe.raw_address);
+        if(!object_res) {
+            return;
+        }
+        auto& entry = *object_res.unwrap().entry;
+        #if IS_LINUX
+        if(use_dwarf) {
+            auto resolver = get_jit_resolver(entry);
+            // debug info for JIT code is in terms of run-time addresses
+            try_resolve_frame(resolver.get(), {dlframe.raw_address, dlframe.raw_address, ""}, frame);
+            frame.frame.object_address = dlframe.object_address;
+            for(auto& inline_frame : frame.inlines) {
+                inline_frame.object_address = dlframe.object_address;
+            }
+        }
+        #else
+        // dwarf resolution for in-memory mach-o objects isn't supported
+        (void)use_dwarf;
+        #endif
+        if(frame.frame.symbol.empty()) {
+            frame.frame.symbol = entry.object
+                .lookup_symbol(dlframe.raw_address - object_res.unwrap().base)
+                .value_or("");
+        }
+    }
+    #endif
+
     CPPTRACE_FORCE_NO_INLINE_FOR_PROFILING
     std::vector<stacktrace_frame> resolve_frames(const std::vector<object_frame>& frames) {
+        stats::resolution_timer timer(stats::backend::libdwarf, frames.size());
         std::vector<frame_with_inlines> trace(frames.size(), {null_frame(), {}});
-        // Locking around all libdwarf interaction per https://github.com/davea42/libdwarf-code/discussions/184
-        // And also locking for interactions with get_resolver
-        static std::mutex mutex;
-        const std::lock_guard<std::mutex> lock(mutex);
+        const std::lock_guard<std::recursive_mutex> lock(get_resolution_mutex());
         for(const auto& group : collate_frames(frames, trace)) {
             try {
                 const auto& object_name = group.first;
                 if(object_name.empty()) {
                     #if IS_LINUX || IS_APPLE
                     for(const auto& entry : group.second) {
-                        try_resolve_jit_frame(entry.first.get(), entry.second.get());
+                        try_resolve_jit_frame(entry.first.get(), entry.second.get(), true);
                     }
                     #endif
                     continue;
@@ -177,6 +236,60 @@ namespace libdwarf {
         // flatten and finish
         return flatten_inlines(trace);
     }
+
+    CPPTRACE_FORCE_NO_INLINE_FOR_PROFILING
+    std::vector<stacktrace_frame> resolve_frames_from_symbol_tables(const std::vector<object_frame>& frames) {
+        stats::resolution_timer timer(stats::backend::libdwarf, frames.size());
+        std::vector<frame_with_inlines> trace;
+        trace.reserve(frames.size());
+        for(const auto& dlframe : frames) {
+            trace.push_back({
+                {
+                    dlframe.raw_address,
+                    dlframe.object_address,
+                    nullable<std::uint32_t>::null(),
+                    nullable<std::uint32_t>::null(),
+                    dlframe.object_path,
+                    "",
+                    false
+                },
+                {}
+            });
+        }
+        #if IS_LINUX || IS_APPLE
+        const std::lock_guard<std::recursive_mutex> lock(get_resolution_mutex());
+        for(const auto& group : collate_frames(frames, trace)) {
+            try {
+                const auto& object_name = group.first;
+                if(object_name.empty()) {
+                    for(const auto& entry : group.second) {
+                        try_resolve_jit_frame(entry.first.get(), entry.second.get(), false);
+                    }
+                    continue;
+                }
+                #if IS_LINUX
+                auto object = open_elf_cached(object_name);
+                #elif IS_APPLE
+                auto object = open_mach_o_cached(object_name);
+                #endif
+                if(object.is_error()) {
+                    if(!should_absorb_trace_exceptions()) {
+                        object.drop_error();
+                    }
+                    continue;
+                }
+                for(const auto& entry : group.second) {
+                    entry.second.get().frame.symbol = object
+                        .unwrap_value()
+                        ->lookup_symbol(entry.first.get().object_address).value_or("");
+                }
+            } catch(...) { // NOSONAR
+                detail::log_and_maybe_propagate_exception(std::current_exception());
+            }
+        }
+        #endif
+        return flatten_inlines(trace);
+    }
 }
 }
 CPPTRACE_END_NAMESPACE
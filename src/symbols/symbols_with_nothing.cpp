@@ -3,6 +3,7 @@
 #include <cpptrace/basic.hpp>
 #include "symbols/symbols.hpp"
 #include "utils/common.hpp"
+#include "statistics.hpp"
 
 #include <vector>
 
@@ -10,10 +11,12 @@ CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
 namespace nothing {
     std::vector<stacktrace_frame> resolve_frames(const std::vector<frame_ptr>& frames) {
+        stats::resolution_timer timer(stats::backend::nothing, frames.size());
         return std::vector<stacktrace_frame>(frames.size(), null_frame());
     }
 
     std::vector<stacktrace_frame> resolve_frames(const std::vector<object_frame>& frames) {
+        stats::resolution_timer timer(stats::backend::nothing, frames.size());
         return std::vector<stacktrace_frame>(frames.size(), null_frame());
     }
 }
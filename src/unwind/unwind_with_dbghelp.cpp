@@ -2,6 +2,7 @@
 
 #include <cpptrace/basic.hpp>
 #include "unwind/unwind.hpp"
+#include "statistics.hpp"
 #include "utils/common.hpp"
 #include "utils/utils.hpp"
 #include "platform/dbghelp_utils.hpp"
@@ -29,6 +30,7 @@ namespace detail {
         std::size_t max_depth,
         EXCEPTION_POINTERS* exception_pointers
     ) {
+        stats::capture_timer timer;
         // https://jpassing.com/2008/03/12/walking-the-stack-of-the-current-thread/
 
         // Get current thread context
@@ -159,6 +161,7 @@ namespace detail {
                 break;
             }
         }
+        timer.finish(trace.size());
         return trace;
     }
 
@@ -1,6 +1,7 @@
 #ifdef CPPTRACE_UNWIND_WITH_EXECINFO
 
 #include "unwind/unwind.hpp"
+#include "statistics.hpp"
 #include "utils/common.hpp"
 #include "utils/utils.hpp"
 
@@ -15,6 +16,7 @@ CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
     CPPTRACE_FORCE_NO_INLINE
     std::vector<frame_ptr> capture_frames(std::size_t skip, std::size_t max_depth) {
+        stats::capture_timer timer;
         skip++;
         std::vector<void*> addrs(skip + std::min(hard_max_frames, max_depth), nullptr);
         // thread safe
@@ -27,6 +29,7 @@ namespace detail {
             // This is done with _Unwind too but conditionally based on info from _Unwind_GetIPInfo.
             frames[i - skip] = reinterpret_cast<frame_ptr>(addrs[i]) - 1;
         }
+        timer.finish(frames.size());
         return frames;
     }
 
@@ -1,6 +1,7 @@
 #ifdef CPPTRACE_UNWIND_WITH_LIBUNWIND
 
 #include "unwind/unwind.hpp"
+#include "statistics.hpp"
 #include "utils/common.hpp"
 #include "utils/error.hpp"
 #include "utils/utils.hpp"
@@ -16,6 +17,7 @@ CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
     CPPTRACE_FORCE_NO_INLINE
     std::vector<frame_ptr> capture_frames(std::size_t skip, std::size_t max_depth) {
+        stats::capture_timer timer;
         skip++;
         std::vector<frame_ptr> frames;
         unw_context_t context;
@@ -34,6 +36,7 @@ namespace detail {
                 frames.push_back(to_frame_ptr(pc) - 1);
             }
         } while(unw_step(&cursor) > 0 && frames.size() < max_depth);
+        timer.finish(frames.size());
         return frames;
     }
 
@@ -1,6 +1,7 @@
 #ifdef CPPTRACE_UNWIND_WITH_UNWIND
 
 #include "unwind/unwind.hpp"
+#include "statistics.hpp"
 #include "utils/common.hpp"
 #include "utils/error.hpp"
 #include "utils/utils.hpp"
@@ -54,9 +55,11 @@ namespace detail {
 
     CPPTRACE_FORCE_NO_INLINE
     std::vector<frame_ptr> capture_frames(std::size_t skip, std::size_t max_depth) {
+        stats::capture_timer timer;
         std::vector<frame_ptr> frames;
         unwind_state state{skip + 1, max_depth, frames};
         _Unwind_Backtrace(unwind_callback, &state); // presumably thread-safe
+        timer.finish(frames.size());
         return frames;
     }
 
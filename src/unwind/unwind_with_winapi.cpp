@@ -2,6 +2,7 @@
 
 #include <cpptrace/basic.hpp>
 #include "unwind/unwind.hpp"
+#include "statistics.hpp"
 #include "utils/common.hpp"
 #include "utils/utils.hpp"
 
@@ -23,6 +24,7 @@ CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
     CPPTRACE_FORCE_NO_INLINE
     std::vector<frame_ptr> capture_frames(std::size_t skip, std::size_t max_depth) {
+        stats::capture_timer timer;
         std::vector<void*> addrs(skip + std::min(hard_max_frames, max_depth), nullptr);
         std::size_t n_frames = CaptureStackBackTrace(
             static_cast<ULONG>(skip + 1),
@@ -38,6 +40,7 @@ namespace detail {
             // This is done with _Unwind too but conditionally based on info from _Unwind_GetIPInfo.
             frames[i] = reinterpret_cast<frame_ptr>(addrs[i]) - 1;
         }
+        timer.finish(frames.size());
         return frames;
     }
 
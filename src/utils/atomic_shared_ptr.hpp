@@ -0,0 +1,47 @@
+#ifndef ATOMIC_SHARED_PTR_HPP
+#define ATOMIC_SHARED_PTR_HPP
+
+#include "cpptrace/forward.hpp"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // std::atomic<std::shared_ptr<T>> where available, the pre-C++20 atomic free functions otherwise (these are
+    // deprecated in C++20)
+    template<typename T>
+    class atomic_shared_ptr {
+        #ifdef __cpp_lib_atomic_shared_ptr
+        std::atomic<std::shared_ptr<T>> ptr;
+        #else
+        std::shared_ptr<T> ptr;
+        #endif
+
+    public:
+        atomic_shared_ptr() = default;
+        explicit atomic_shared_ptr(std::shared_ptr<T> value) : ptr(std::move(value)) {}
+        atomic_shared_ptr(const atomic_shared_ptr&) = delete;
+        atomic_shared_ptr& operator=(const atomic_shared_ptr&) = delete;
+
+        std::shared_ptr<T> load() const {
+            #ifdef __cpp_lib_atomic_shared_ptr
+            return ptr.load(std::memory_order_acquire);
+            #else
+            return std::atomic_load_explicit(&ptr, std::memory_order_acquire);
+            #endif
+        }
+
+        void store(std::shared_ptr<T> value) {
+            #ifdef __cpp_lib_atomic_shared_ptr
+            ptr.store(std::move(value), std::memory_order_release);
+            #else
+            std::atomic_store_explicit(&ptr, std::move(value), std::memory_order_release);
+            #endif
+        }
+    };
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef FD_WRITER_HPP
+#define FD_WRITER_HPP
+
+#include "utils/microfmt.hpp"
+#include "utils/utils.hpp"
+
+#include <cstddef>
+#include <iterator>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // Buffered output to a file descriptor. Only the stack and write(2) are used, this is async-signal-safe.
+    class fd_writer {
+        int fd;
+        char buffer[256];
+        std::size_t used = 0;
+        std::size_t written = 0;
+
+    public:
+        // output iterator for microfmt
+        class iterator {
+            fd_writer* writer;
+        public:
+            using iterator_category = std::output_iterator_tag;
+            using value_type = void;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = void;
+
+            explicit iterator(fd_writer& writer) : writer(&writer) {}
+            iterator& operator=(char c) {
+                writer->put(c);
+                return *this;
+            }
+            iterator& operator*() {
+                return *this;
+            }
+            iterator& operator++() {
+                return *this;
+            }
+            iterator& operator++(int) {
+                return *this;
+            }
+        };
+
+        explicit fd_writer(int fd) : fd(fd) {}
+        fd_writer(const fd_writer&) = delete;
+        fd_writer& operator=(const fd_writer&) = delete;
+
+        void put(char c) {
+            if(used == sizeof(buffer)) {
+                flush();
+            }
+            buffer[used++] = c;
+        }
+
+        template<typename... Args>
+        void print(const char* fmt, Args&&... args) {
+            microfmt::format_to(iterator(*this), fmt, std::forward<Args>(args)...);
+        }
+
+        void flush() {
+            written += write_fd(fd, buffer, used);
+            used = 0;
+        }
+
+        // bytes written to the file descriptor so far, not including anything still buffered
+        std::size_t bytes_written() const {
+            return written;
+        }
+    };
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
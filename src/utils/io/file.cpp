@@ -1,5 +1,6 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "utils/io/file.hpp"
+#include "statistics.hpp"
 
 CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
@@ -22,6 +23,7 @@ namespace detail {
         if(std::fread(buffer.data(), buffer.size(), 1, file_obj) != 1) {
             return internal_error("fread error in {} at offset {} for {} bytes", path(), offset, buffer.size());
         }
+        stats::record_bytes_read(buffer.size());
         return monostate{};
     }
 }
@@ -85,6 +85,25 @@ namespace detail {
             return lru.front().value;
         }
 
+        void erase(const K& key) {
+            auto it = map.find(key);
+            if(it == map.end()) {
+                return;
+            }
+            lru.erase(it->second);
+            map.erase(it);
+        }
+
+        // Evict least recently used entries for as long as the predicate holds for them
+        template<typename F>
+        void trim_while(F predicate) {
+            while(!lru.empty() && predicate(lru.back().value)) {
+                const auto& to_remove = lru.back();
+                map.erase(to_remove.key);
+                lru.pop_back();
+            }
+        }
+
         std::size_t size() const {
             return lru.size();
         }
@@ -69,10 +69,15 @@ namespace microfmt {
             }
         }
 
+        // enough for a 64-bit integer in any supported base, along with a sign
+        constexpr std::size_t max_integer_chars = 65;
+
+        // Writes the digits of value to the start of buffer and returns the number of characters written
         template<int shift, int mask>
-        std::string to_string(std::uint64_t value, const char* digits = "0123456789abcdef") {
+        std::size_t to_chars(char* buffer, std::uint64_t value, const char* digits = "0123456789abcdef") {
             if(value == 0) {
-                return "0";
+                buffer[0] = '0';
+                return 1;
             } else {
                 // digits = floor(1 + log_base(x))
                 // log_base(x) = log_2(x) / log_2(base)
@@ -80,24 +85,35 @@ namespace microfmt {
                 // 1 + (63 - clz(value)) / (63 - clz(1 << shift))
                 // 63 - clz(1 << shift) is the same as shift
                 auto n_digits = to<std::size_t>(1 + (63 - clz(value)) / shift);
-                std::string number;
-                number.resize(n_digits);
-                std::size_t i = n_digits - 1;
+                std::size_t i = n_digits;
                 while(value > 0) {
-                    number[i--] = digits[value & mask];
+                    buffer[--i] = digits[value & mask];
                     value >>= shift;
                 }
-                return number;
+                return n_digits;
+            }
+        }
+
+        inline std::size_t to_chars_decimal(char* buffer, std::uint64_t value) {
+            char digits[20];
+            std::size_t n_digits = 0;
+            do {
+                digits[n_digits++] = to<char>('0' + value % 10);
+                value /= 10;
+            } while(value > 0);
+            for(std::size_t i = 0; i < n_digits; i++) {
+                buffer[i] = digits[n_digits - i - 1];
             }
+            return n_digits;
         }
 
-        inline std::string to_string(std::uint64_t value, const format_options& options) {
+        inline std::size_t to_chars(char* buffer, std::uint64_t value, const format_options& options) {
             switch(options.base) {
-                case 'H': return to_string<4, 0xf>(value, "0123456789ABCDEF");
-                case 'h': return to_string<4, 0xf>(value);
-                case 'o': return to_string<3, 0x7>(value);
-                case 'b': return to_string<1, 0x1>(value);
-                default: return std::to_string(value); // failure: decimal
+                case 'H': return to_chars<4, 0xf>(buffer, value, "0123456789ABCDEF");
+                case 'h': return to_chars<4, 0xf>(buffer, value);
+                case 'o': return to_chars<3, 0x7>(buffer, value);
+                case 'b': return to_chars<1, 0x1>(buffer, value);
+                default: return to_chars_decimal(buffer, value); // failure: decimal
             }
         }
 
@@ -162,20 +178,23 @@ namespace microfmt {
                         break;
                     case value_type::int64_value:
                         {
-                            std::string str;
-                            std::int64_t val = int64_value;
-                            if(val < 0) {
-                                str += '-';
-                                val *= -1;
+                            // integers are formatted on the stack, this path doesn't allocate
+                            char buffer[max_integer_chars];
+                            std::size_t size = 0;
+                            auto magnitude = static_cast<std::uint64_t>(int64_value);
+                            if(int64_value < 0) {
+                                buffer[size++] = '-';
+                                magnitude = 0 - magnitude;
                             }
-                            str += to_string(static_cast<std::uint64_t>(val), options);
-                            do_write(out, str.begin(), str.end(), options);
+                            size += to_chars(buffer + size, magnitude, options);
+                            do_write(out, buffer, buffer + size, options);
                         }
                         break;
                     case value_type::uint64_value:
                         {
-                            std::string str = to_string(uint64_value, options);
-                            do_write(out, str.begin(), str.end(), options);
+                            char buffer[max_integer_chars];
+                            auto size = to_chars(buffer, uint64_value, options);
+                            do_write(out, buffer, buffer + size, options);
                         }
                         break;
                     case value_type::string_value:
@@ -203,7 +222,8 @@ namespace microfmt {
             auto read_number = [&] () -> int { // -1 on failure
                 auto scan = it;
                 int num = 0;
-                while(scan != fmt_end && isdigit(*scan)) {
+                // not isdigit, which consults the locale, so that formatting stays async-signal-safe
+                while(scan != fmt_end && *scan >= '0' && *scan <= '9') {
                     num *= 10;
                     num += *scan - '0';
                     scan++;
@@ -291,6 +311,12 @@ namespace microfmt {
         return str;
     }
 
+    // Formats into an output iterator
+    template<typename OutputIt, typename S, typename... Args>
+    void format_to(OutputIt out, const S& fmt, Args&&... args) {
+        detail::format(out, fmt, {detail::format_value(args)...});
+    }
+
     template<typename S, typename... Args>
     void print(const S& fmt, Args&&... args) {
         detail::format(std::ostream_iterator<char>(detail::get_cout()), fmt, {args...});
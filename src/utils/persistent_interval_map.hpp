@@ -0,0 +1,181 @@
+#ifndef PERSISTENT_INTERVAL_MAP_HPP
+#define PERSISTENT_INTERVAL_MAP_HPP
+
+#include "cpptrace/forward.hpp"
+#include "utils/common.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+CPPTRACE_BEGIN_NAMESPACE
+namespace detail {
+    // Immutable map of non-overlapping [low, high) intervals, keyed by low
+    // Updates produce a new map in O(log n) which shares all untouched nodes with the old one (an AVL tree with path
+    // copying). This allows a snapshot to be read concurrently with updates: readers hold onto a copy of the map and
+    // writers publish a new one.
+    template<typename V>
+    class persistent_interval_map {
+    public:
+        struct entry {
+            frame_ptr low;
+            frame_ptr high; // not inclusive
+            V value;
+        };
+
+    private:
+        struct node;
+        using node_ptr = std::shared_ptr<const node>;
+        struct node {
+            entry value;
+            node_ptr left;
+            node_ptr right;
+            int height;
+            node(entry value, node_ptr left, node_ptr right, int height)
+                : value(std::move(value)), left(std::move(left)), right(std::move(right)), height(height) {}
+        };
+
+        node_ptr root;
+
+        explicit persistent_interval_map(node_ptr root) : root(std::move(root)) {}
+
+        static int height(const node_ptr& n) {
+            return n ? n->height : 0;
+        }
+
+        static node_ptr make_node(entry value, node_ptr left, node_ptr right) {
+            const int h = 1 + std::max(height(left), height(right));
+            return std::make_shared<const node>(std::move(value), std::move(left), std::move(right), h);
+        }
+
+        // Builds a node from the parts, doing a single or double rotation if the two sides differ in height by two
+        static node_ptr balance(entry value, node_ptr left, node_ptr right) {
+            const int left_height = height(left);
+            const int right_height = height(right);
+            if(left_height > right_height + 1) {
+                if(height(left->left) >= height(left->right)) {
+                    return make_node(
+                        left->value,
+                        left->left,
+                        make_node(std::move(value), left->right, std::move(right))
+                    );
+                } else {
+                    const auto& pivot = left->right;
+                    return make_node(
+                        pivot->value,
+                        make_node(left->value, left->left, pivot->left),
+                        make_node(std::move(value), pivot->right, std::move(right))
+                    );
+                }
+            } else if(right_height > left_height + 1) {
+                if(height(right->right) >= height(right->left)) {
+                    return make_node(
+                        right->value,
+                        make_node(std::move(value), std::move(left), right->left),
+                        right->right
+                    );
+                } else {
+                    const auto& pivot = right->left;
+                    return make_node(
+                        pivot->value,
+                        make_node(std::move(value), std::move(left), pivot->left),
+                        make_node(right->value, pivot->right, right->right)
+                    );
+                }
+            }
+            return make_node(std::move(value), std::move(left), std::move(right));
+        }
+
+        static node_ptr insert(const node_ptr& n, entry value) {
+            if(!n) {
+                return make_node(std::move(value), nullptr, nullptr);
+            }
+            if(value.low < n->value.low) {
+                return balance(n->value, insert(n->left, std::move(value)), n->right);
+            } else if(n->value.low < value.low) {
+                return balance(n->value, n->left, insert(n->right, std::move(value)));
+            } else {
+                return make_node(std::move(value), n->left, n->right);
+            }
+        }
+
+        static node_ptr remove_min(const node_ptr& n) {
+            if(!n->left) {
+                return n->right;
+            }
+            return balance(n->value, remove_min(n->left), n->right);
+        }
+
+        template<typename P>
+        static node_ptr erase(const node_ptr& n, frame_ptr low, P& predicate) {
+            if(!n) {
+                return n;
+            }
+            if(low < n->value.low) {
+                auto left = erase(n->left, low, predicate);
+                return left == n->left ? n : balance(n->value, std::move(left), n->right);
+            } else if(n->value.low < low) {
+                auto right = erase(n->right, low, predicate);
+                return right == n->right ? n : balance(n->value, n->left, std::move(right));
+            } else {
+                if(!predicate(n->value.value)) {
+                    return n;
+                }
+                if(!n->left) {
+                    return n->right;
+                } else if(!n->right) {
+                    return n->left;
+                }
+                const node* min = n->right.get();
+                while(min->left) {
+                    min = min->left.get();
+                }
+                return balance(min->value, n->left, remove_min(n->right));
+            }
+        }
+
+    public:
+        persistent_interval_map() = default;
+
+        // An existing interval with the same low is replaced
+        NODISCARD persistent_interval_map insert(frame_ptr low, frame_ptr high, V value) const {
+            return persistent_interval_map(insert(root, entry{low, high, std::move(value)}));
+        }
+
+        // Removes the interval starting at low if the predicate holds for its value
+        template<typename P>
+        NODISCARD persistent_interval_map erase_if(frame_ptr low, P predicate) const {
+            return persistent_interval_map(erase(root, low, predicate));
+        }
+
+        // The returned pointer is valid for as long as this map, or any map it's shared with, is alive
+        const entry* find(frame_ptr pc) const {
+            const node* candidate = nullptr;
+            const node* current = root.get();
+            while(current) {
+                if(pc < current->value.low) {
+                    current = current->left.get();
+                } else {
+                    candidate = current;
+                    current = current->right.get();
+                }
+            }
+            if(candidate && pc < candidate->value.high) {
+                return &candidate->value;
+            }
+            return nullptr;
+        }
+
+        bool empty() const {
+            return root == nullptr;
+        }
+
+        // exposed for testing
+        int depth() const {
+            return height(root);
+        }
+    };
+}
+CPPTRACE_END_NAMESPACE
+
+#endif
@@ -1,6 +1,9 @@
 #include "utils/utils.hpp"
 #include "utils/string_view.hpp"
 
+#include <cerrno>
+#include <climits>
+
 #if IS_WINDOWS
  #include <io.h>
  #ifndef WIN32_LEAN_AND_MEAN
@@ -31,6 +34,29 @@ namespace detail {
         #endif
     }
 
+    std::size_t write_fd(int fd, const char* data, std::size_t size) noexcept {
+        std::size_t written = 0;
+        while(written < size) {
+            #if IS_WINDOWS
+             auto chunk = static_cast<unsigned>(std::min<std::size_t>(size - written, INT_MAX));
+             auto res = _write(fd, data + written, chunk);
+            #else
+             auto res = ::write(fd, data + written, size - written);
+            #endif
+            if(res < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            if(res == 0) {
+                break;
+            }
+            written += static_cast<std::size_t>(res);
+        }
+        return written;
+    }
+
     void enable_virtual_terminal_processing_if_needed() noexcept {
         // enable colors / ansi processing if necessary
         #if IS_WINDOWS
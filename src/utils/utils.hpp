@@ -21,6 +21,9 @@ CPPTRACE_BEGIN_NAMESPACE
 namespace detail {
     bool isatty(int fd);
     int fileno(std::FILE* stream);
+    // Writes to a file descriptor, retrying on partial writes and interrupts. Returns the number of bytes written,
+    // which is less than size only if an error occurred. Only uses write(2), so this is async-signal-safe.
+    std::size_t write_fd(int fd, const char* data, std::size_t size) noexcept;
 
     void enable_virtual_terminal_processing_if_needed() noexcept;
 
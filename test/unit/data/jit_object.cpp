@@ -0,0 +1,15 @@
+// Built into a standalone elf object which the JIT tests load into memory and register with cpptrace. The tests check
+// the line numbers in this file.
+
+extern "C" {
+    volatile int jit_object_value;
+
+    __attribute__((always_inline)) inline void jit_inner(int x) {
+        jit_object_value = x * 3;
+    }
+
+    __attribute__((noinline)) void jit_outer(int x) {
+        jit_inner(x + 1);
+        jit_object_value = jit_object_value + 1;
+    }
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "jit/jit_objects.hpp"
+
+using cpptrace::detail::gdb_jit_registrations;
+using cpptrace::detail::jit_code_entry;
+
+namespace {
+
+// Records the registration calls a sync makes
+struct registration_log {
+    std::vector<std::pair<const char*, std::size_t>> registered;
+    std::vector<const char*> unregistered;
+
+    void sync(gdb_jit_registrations& registrations, const jit_code_entry* first_entry) {
+        registrations.sync(
+            first_entry,
+            [this] (const char* ptr, std::size_t size) { registered.emplace_back(ptr, size); },
+            [this] (const char* ptr) { unregistered.push_back(ptr); }
+        );
+    }
+
+    void clear() {
+        registered.clear();
+        unregistered.clear();
+    }
+};
+
+void link(std::vector<jit_code_entry*> entries) {
+    for(std::size_t i = 0; i < entries.size(); i++) {
+        entries[i]->prev_entry = i == 0 ? nullptr : entries[i - 1];
+        entries[i]->next_entry = i + 1 == entries.size() ? nullptr : entries[i + 1];
+    }
+}
+
+TEST(GdbJitRegistrations, AddAndRemove) {
+    char objects[3][16];
+    jit_code_entry a{nullptr, nullptr, objects[0], 16};
+    jit_code_entry b{nullptr, nullptr, objects[1], 8};
+    jit_code_entry c{nullptr, nullptr, objects[2], 4};
+    gdb_jit_registrations registrations;
+    registration_log log;
+
+    link({&a, &b});
+    log.sync(registrations, &a);
+    ASSERT_EQ(log.registered.size(), 2);
+    EXPECT_EQ(log.registered[0], std::make_pair(static_cast<const char*>(objects[0]), std::size_t(16)));
+    EXPECT_EQ(log.registered[1], std::make_pair(static_cast<const char*>(objects[1]), std::size_t(8)));
+    EXPECT_TRUE(log.unregistered.empty());
+    EXPECT_EQ(registrations.size(), 2);
+
+    // unchanged entries aren't registered again
+    log.clear();
+    log.sync(registrations, &a);
+    EXPECT_TRUE(log.registered.empty());
+    EXPECT_TRUE(log.unregistered.empty());
+
+    // a is removed, c is added
+    log.clear();
+    link({&b, &c});
+    log.sync(registrations, &b);
+    ASSERT_EQ(log.registered.size(), 1);
+    EXPECT_EQ(log.registered[0].first, objects[2]);
+    ASSERT_EQ(log.unregistered.size(), 1);
+    EXPECT_EQ(log.unregistered[0], objects[0]);
+    EXPECT_EQ(registrations.size(), 2);
+
+    // everything is removed
+    log.clear();
+    log.sync(registrations, nullptr);
+    EXPECT_TRUE(log.registered.empty());
+    EXPECT_EQ(log.unregistered.size(), 2);
+    EXPECT_EQ(registrations.size(), 0);
+}
+
+TEST(GdbJitRegistrations, AddressReuse) {
+    char object[32];
+    jit_code_entry old_entry{nullptr, nullptr, object, 16};
+    gdb_jit_registrations registrations;
+    registration_log log;
+    log.sync(registrations, &old_entry);
+    ASSERT_EQ(log.registered.size(), 1);
+
+    // the object is freed and a new one of a different size is allocated at the same address, through the same entry
+    log.clear();
+    old_entry.symfile_size = 32;
+    log.sync(registrations, &old_entry);
+    ASSERT_EQ(log.registered.size(), 1);
+    EXPECT_EQ(log.registered[0], std::make_pair(static_cast<const char*>(object), std::size_t(32)));
+    EXPECT_TRUE(log.unregistered.empty());
+
+    // same address and size but a new entry
+    log.clear();
+    jit_code_entry new_entry{nullptr, nullptr, object, 32};
+    log.sync(registrations, &new_entry);
+    ASSERT_EQ(log.registered.size(), 1);
+    EXPECT_EQ(log.registered[0].first, object);
+    EXPECT_TRUE(log.unregistered.empty());
+    EXPECT_EQ(registrations.size(), 1);
+}
+
+TEST(GdbJitRegistrations, Events) {
+    char object[16];
+    jit_code_entry entry{nullptr, nullptr, object, 16};
+    gdb_jit_registrations registrations;
+    registration_log log;
+    registrations.add(&entry, [&] (const char* ptr, std::size_t size) { log.registered.emplace_back(ptr, size); });
+    EXPECT_EQ(registrations.size(), 1);
+    // a sync afterwards sees the entry as registered
+    log.clear();
+    log.sync(registrations, &entry);
+    EXPECT_TRUE(log.registered.empty());
+    registrations.remove(&entry, [&] (const char* ptr) { log.unregistered.push_back(ptr); });
+    ASSERT_EQ(log.unregistered.size(), 1);
+    EXPECT_EQ(log.unregistered[0], object);
+    EXPECT_EQ(registrations.size(), 0);
+}
+
+}
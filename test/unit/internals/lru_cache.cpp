@@ -101,4 +101,31 @@ TEST(LruCacheTest, Touch) {
     EXPECT_EQ(cache.maybe_get(0).unwrap(), 50);
 }
 
+TEST(LruCacheTest, Erase) {
+    lru_cache<int, int> cache;
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+    cache.erase(1);
+    cache.erase(3);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_FALSE(cache.maybe_get(1).has_value());
+    EXPECT_EQ(cache.maybe_get(2).unwrap(), 20);
+}
+
+TEST(LruCacheTest, TrimWhile) {
+    lru_cache<int, int> cache;
+    for(int i = 0; i < 10; i++) {
+        cache.insert(i, i);
+    }
+    cache.maybe_touch(0);
+    // 1 through 4 are the least recently used, 0 was touched and is the most recently used
+    cache.trim_while([] (int value) { return value != 0 && value < 5; });
+    EXPECT_EQ(cache.size(), 6);
+    for(int i = 1; i < 5; i++) {
+        EXPECT_FALSE(cache.maybe_get(i).has_value());
+    }
+    EXPECT_EQ(cache.maybe_get(0).unwrap(), 0);
+    EXPECT_EQ(cache.maybe_get(5).unwrap(), 5);
+}
+
 }
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "utils/persistent_interval_map.hpp"
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+using cpptrace::detail::persistent_interval_map;
+
+namespace {
+
+TEST(PersistentIntervalMapTest, Empty) {
+    persistent_interval_map<int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(0), nullptr);
+    EXPECT_EQ(map.find(100), nullptr);
+}
+
+TEST(PersistentIntervalMapTest, Find) {
+    auto map = persistent_interval_map<int>{}
+        .insert(10, 20, 1)
+        .insert(30, 40, 2)
+        .insert(20, 25, 3);
+    EXPECT_EQ(map.find(9), nullptr);
+    ASSERT_NE(map.find(10), nullptr);
+    EXPECT_EQ(map.find(10)->value, 1);
+    EXPECT_EQ(map.find(19)->value, 1);
+    EXPECT_EQ(map.find(20)->value, 3);
+    EXPECT_EQ(map.find(24)->low, 20);
+    EXPECT_EQ(map.find(25), nullptr);
+    EXPECT_EQ(map.find(29), nullptr);
+    EXPECT_EQ(map.find(35)->value, 2);
+    EXPECT_EQ(map.find(40), nullptr);
+}
+
+TEST(PersistentIntervalMapTest, InsertReplaces) {
+    auto map = persistent_interval_map<int>{}.insert(10, 20, 1).insert(10, 15, 2);
+    EXPECT_EQ(map.find(12)->value, 2);
+    EXPECT_EQ(map.find(17), nullptr);
+}
+
+TEST(PersistentIntervalMapTest, EraseIf) {
+    auto map = persistent_interval_map<int>{}.insert(10, 20, 1).insert(30, 40, 2);
+    auto unchanged = map.erase_if(10, [] (int value) { return value == 5; });
+    EXPECT_EQ(unchanged.find(15)->value, 1);
+    auto erased = map.erase_if(10, [] (int value) { return value == 1; });
+    EXPECT_EQ(erased.find(15), nullptr);
+    EXPECT_EQ(erased.find(35)->value, 2);
+    auto missing = erased.erase_if(50, [] (int) { return true; });
+    EXPECT_EQ(missing.find(35)->value, 2);
+}
+
+TEST(PersistentIntervalMapTest, SnapshotsAreUnchanged) {
+    auto before = persistent_interval_map<int>{}.insert(10, 20, 1);
+    auto after = before.insert(30, 40, 2).erase_if(10, [] (int) { return true; });
+    EXPECT_EQ(before.find(15)->value, 1);
+    EXPECT_EQ(before.find(35), nullptr);
+    EXPECT_EQ(after.find(15), nullptr);
+    EXPECT_EQ(after.find(35)->value, 2);
+}
+
+TEST(PersistentIntervalMapTest, MatchesReference) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 999);
+    persistent_interval_map<int> map;
+    std::map<cpptrace::frame_ptr, int> reference;
+    for(int i = 0; i < 5000; i++) {
+        cpptrace::frame_ptr low = dist(rng) * 10;
+        if(dist(rng) % 3 == 0) {
+            map = map.erase_if(low, [] (int) { return true; });
+            reference.erase(low);
+        } else {
+            map = map.insert(low, low + 5, i);
+            reference[low] = i;
+        }
+    }
+    for(cpptrace::frame_ptr pc = 0; pc < 10000; pc++) {
+        auto it = reference.find(pc - pc % 10);
+        const auto* entry = map.find(pc);
+        if(it == reference.end() || pc % 10 >= 5) {
+            EXPECT_EQ(entry, nullptr);
+        } else {
+            ASSERT_NE(entry, nullptr);
+            EXPECT_EQ(entry->value, it->second);
+        }
+    }
+    // AVL height bound
+    EXPECT_LE(map.depth(), 1.45 * std::log2(reference.size() + 2));
+}
+
+}
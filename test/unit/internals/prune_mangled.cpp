@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#include <string>
+
+#include <cpptrace/utils.hpp>
+#include "demangle/prune_mangled.hpp"
+
+using cpptrace::detail::prune_mangled_symbol;
+
+namespace {
+
+#ifndef _MSC_VER
+
+#define DO_TEST(symbol, expected) \
+    do { \
+        auto res = prune_mangled_symbol(symbol); \
+        ASSERT_TRUE(res.has_value()) << "Input: " << symbol; \
+        EXPECT_EQ(res.unwrap(), expected) << "Input: " << symbol; \
+        EXPECT_EQ(res.unwrap(), cpptrace::prune_symbol(cpptrace::demangle(symbol))) << "Input: " << symbol; \
+    } while(false)
+
+TEST(PruneMangledTests, Basic) {
+    DO_TEST("_Z3foov", "foo");
+    DO_TEST("_Z3fooic", "foo");
+    DO_TEST("__Z3fooic", "foo");
+    DO_TEST("_ZN2ns3fooEv", "ns::foo");
+    DO_TEST("_ZN2ns3ns23fooEv", "ns::ns2::foo");
+    DO_TEST("_ZNK2ns1S3fooEv", "ns::S::foo");
+    DO_TEST("_ZN12_GLOBAL__N_13fooEv", "(anonymous namespace)::foo");
+    DO_TEST("_ZL3fooi", "foo");
+    DO_TEST("_ZN2ns3fooB5cxx11Ev", "ns::foo");
+}
+
+TEST(PruneMangledTests, Templates) {
+    DO_TEST("_Z3fooIiEvT_", "foo");
+    DO_TEST("_ZN2ns1SIiE3fooIcEEvT_", "ns::S::foo");
+    DO_TEST("_ZNSt6vectorIiSaIiEE9push_backERKi", "std::vector::push_back");
+    DO_TEST(
+        "_ZNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE12_M_constructIPKcEEvT_S8_St20forward_iterator_tag",
+        "std::__cxx11::basic_string::_M_construct"
+    );
+    DO_TEST("_ZN2ns3fooILi5EEEvv", "ns::foo");
+    DO_TEST("_ZN2ns3fooIJicEEEvDpT_", "ns::foo");
+}
+
+TEST(PruneMangledTests, Substitutions) {
+    DO_TEST("_ZN2ns1S3barERKS0_", "ns::S::bar");
+    DO_TEST("_ZN2ns1SC2ERKS0_", "ns::S::S");
+    DO_TEST("_ZN2ns1SD0Ev", "ns::S::~S");
+    DO_TEST("_ZNSt6vectorIiSaIiEEC2Ev", "std::vector::vector");
+    DO_TEST("_ZNSsC1EPKc", "std::basic_string::basic_string");
+    DO_TEST("_ZNSoD1Ev", "std::basic_ostream::~basic_ostream");
+    DO_TEST("_ZNSo5flushEv", "std::ostream::flush");
+}
+
+TEST(PruneMangledTests, Operators) {
+    DO_TEST("_ZN2ns1SplERKS0_", "ns::S::operator+");
+    DO_TEST("_ZN2ns1SaSEOS0_", "ns::S::operator=");
+    DO_TEST("_ZN2ns1SclEv", "ns::S::operator()");
+    DO_TEST("_ZN2ns1SnwEm", "ns::S::operator new");
+    DO_TEST("_ZN2ns1SdaEPv", "ns::S::operator delete[]");
+}
+
+TEST(PruneMangledTests, LocalNames) {
+    DO_TEST("_ZZ4mainE3foo", "main::foo");
+    DO_TEST("_ZZN2ns3fooEvEN1S3barEv", "ns::foo::S::bar");
+    #ifdef __GLIBCXX__
+    DO_TEST("_ZZN2ns3fooEvENKUlvE_clEv", "ns::foo::<lambda#1>::operator()");
+    #endif
+    DO_TEST("_Z3fooi.cold", "foo");
+    DO_TEST("_ZN2ns3fooEv.constprop.0.isra.0", "ns::foo");
+}
+
+TEST(PruneMangledTests, Fallback) {
+    // not mangled
+    EXPECT_FALSE(prune_mangled_symbol("foo").has_value());
+    EXPECT_FALSE(prune_mangled_symbol("").has_value());
+    // special names
+    EXPECT_FALSE(prune_mangled_symbol("_ZTV3Foo").has_value());
+    EXPECT_FALSE(prune_mangled_symbol("_ZGVZ4mainE1x").has_value());
+    // conversion operators
+    EXPECT_FALSE(prune_mangled_symbol("_ZN2ns1ScvbEv").has_value());
+    // expressions
+    EXPECT_FALSE(prune_mangled_symbol("_Z3fooIiEDTcl3barfp_EET_").has_value());
+    // malformed
+    EXPECT_FALSE(prune_mangled_symbol("_Z").has_value());
+    EXPECT_FALSE(prune_mangled_symbol("_Z3fo").has_value());
+    EXPECT_FALSE(prune_mangled_symbol("_ZN2ns3foo").has_value());
+    EXPECT_FALSE(prune_mangled_symbol("_Z3fooS_").has_value());
+    EXPECT_FALSE(prune_mangled_symbol("_Z3fooi junk").has_value());
+}
+
+#endif
+
+}
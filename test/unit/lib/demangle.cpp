@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef TEST_MODULE
+import cpptrace;
+#else
+#include <cpptrace/utils.hpp>
+#endif
+
+namespace {
+
+#ifndef _MSC_VER
+TEST(DemangleTests, Basic) {
+    EXPECT_EQ(cpptrace::demangle("_Z3fooi"), "foo(int)");
+    EXPECT_EQ(cpptrace::demangle("_ZN2ns3barEv"), "ns::bar()");
+    EXPECT_EQ(cpptrace::demangle("not a mangled name"), "not a mangled name");
+    EXPECT_EQ(cpptrace::demangle("_Zinvalid"), "_Zinvalid");
+}
+
+TEST(DemangleTests, Suffix) {
+    EXPECT_EQ(cpptrace::demangle("_Z3fooi (.cold)"), "foo(int) (.cold)");
+    EXPECT_EQ(cpptrace::demangle("_Z3fooi (.cold)"), "foo(int) (.cold)");
+    EXPECT_EQ(cpptrace::demangle("_Z3fooi"), "foo(int)");
+}
+
+TEST(DemangleTests, Repeated) {
+    // exercises both the cached path and reuse of the output buffer with names of different lengths
+    for(int i = 0; i < 3; i++) {
+        EXPECT_EQ(
+            cpptrace::demangle("_ZNSt6vectorIiSaIiEE9push_backEOi"),
+            "std::vector<int, std::allocator<int> >::push_back(int&&)"
+        );
+        EXPECT_EQ(cpptrace::demangle("_Z1fv"), "f()");
+    }
+}
+
+TEST(DemangleTests, Concurrent) {
+    std::vector<std::thread> threads;
+    std::vector<int> failures(8, 0);
+    for(std::size_t t = 0; t < failures.size(); t++) {
+        threads.emplace_back([t, &failures] {
+            for(int i = 0; i < 1000; i++) {
+                const std::string symbol = "_Z2f" + std::to_string(i % 10) + "v";
+                if(cpptrace::demangle(symbol) != "f" + std::to_string(i % 10) + "()") {
+                    failures[t]++;
+                }
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    for(auto count : failures) {
+        EXPECT_EQ(count, 0);
+    }
+}
+#endif
+
+}
@@ -7,6 +7,9 @@
 #include "utils/utils.hpp"
 
 #include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
 
 #ifdef TEST_MODULE
 import cpptrace;
@@ -557,4 +560,176 @@ TEST(FormatterTest, PrunedSymbols) {
     );
 }
 
+TEST(FormatterTest, FormatToIterator) {
+    auto formatter = cpptrace::formatter{}
+        .symbols(cpptrace::formatter::symbol_mode::pruned);
+    // enough frames to go through the scratch buffer more than once
+    auto trace = make_test_stacktrace(100);
+    std::string str;
+    auto res = formatter.format_to(std::back_inserter(str), trace);
+    EXPECT_EQ(str, formatter.format(trace));
+    EXPECT_EQ(res.size, str.size());
+}
+
+TEST(FormatterTest, FormatToBuffer) {
+    auto trace = make_test_stacktrace();
+    char buffer[512];
+    auto res = cpptrace::get_default_formatter().format_to_n(buffer, sizeof(buffer), trace.frames[0], false);
+    EXPECT_EQ(res.out, buffer + res.size);
+    EXPECT_EQ(std::string(buffer, res.size), "0x" ADDR_PREFIX "00000001 in foo() at foo.cpp:20:30");
+}
+
+TEST(FormatterTest, FormatToBufferTruncated) {
+    auto formatter = cpptrace::formatter{}
+        .symbols(cpptrace::formatter::symbol_mode::pruned);
+    // long enough that the output is handed over in several chunks
+    auto trace = make_test_stacktrace(100);
+    auto expected = formatter.format(trace);
+    std::string buffer(expected.size() + 16, '*');
+    const std::size_t limit = expected.size() / 2;
+    auto res = formatter.format_to_n(&buffer[0], limit, trace);
+    EXPECT_EQ(res.size, expected.size());
+    EXPECT_EQ(res.out, &buffer[0] + limit);
+    EXPECT_EQ(buffer.substr(0, limit), expected.substr(0, limit));
+    // nothing is written past the limit
+    EXPECT_EQ(buffer.substr(limit), std::string(buffer.size() - limit, '*'));
+    // nothing at all with no space
+    auto empty = formatter.format_to_n(&buffer[0], 0, trace.frames[0], false);
+    EXPECT_EQ(empty.out, &buffer[0]);
+    EXPECT_EQ(empty.size, formatter.format(trace.frames[0], false).size());
+    EXPECT_EQ(buffer.substr(limit), std::string(buffer.size() - limit, '*'));
+}
+
+TEST(FormatterTest, FormatToBufferExactSize) {
+    auto trace = make_test_stacktrace();
+    auto expected = cpptrace::get_default_formatter().format(trace, false);
+    std::string buffer(expected.size(), '*');
+    auto res = cpptrace::get_default_formatter().format_to_n(&buffer[0], buffer.size(), trace, false);
+    EXPECT_EQ(res.size, expected.size());
+    EXPECT_EQ(buffer, expected);
+}
+
+TEST(FormatterTest, PrintToFileDescriptor) {
+    auto trace = make_test_stacktrace();
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    auto written = cpptrace::get_default_formatter().print(cpptrace::detail::fileno(file), trace, false);
+    auto expected = cpptrace::get_default_formatter().format(trace, false) + "\n";
+    EXPECT_EQ(written, expected.size());
+    std::string contents(expected.size() + 1, '\0');
+    std::rewind(file);
+    contents.resize(std::fread(&contents[0], 1, contents.size(), file));
+    std::fclose(file);
+    EXPECT_EQ(contents, expected);
+}
+
+// runs a function writing to a file descriptor and returns what it wrote
+template<typename F>
+std::string capture_fd_output(F f) {
+    std::FILE* file = std::tmpfile();
+    if(!file) {
+        ADD_FAILURE() << "couldn't create a temporary file";
+        return "";
+    }
+    f(cpptrace::detail::fileno(file));
+    std::string contents;
+    std::rewind(file);
+    char buffer[1024];
+    std::size_t read;
+    while((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.append(buffer, read);
+    }
+    std::fclose(file);
+    return contents;
+}
+
+TEST(FormatterTest, SafePrintObjectFrames) {
+    cpptrace::safe_object_frame frames[] = {
+        {0x1, 0x1001, "/usr/lib/libfoo.so"},
+        {0x2, 0, ""},
+    };
+    std::size_t written = 0;
+    auto contents = capture_fd_output([&] (int fd) {
+        written = cpptrace::safe_print_object_frames(fd, frames, 2);
+    });
+    EXPECT_EQ(
+        contents,
+        "Stack trace (most recent call first):\n"
+        "#0 0x" ADDR_PREFIX "00000001 in libfoo.so+0x1001\n"
+        "#1 0x" ADDR_PREFIX "00000002\n"
+    );
+    EXPECT_EQ(written, contents.size());
+}
+
+TEST(FormatterTest, SafePrintRawTrace) {
+    cpptrace::frame_ptr frames[] = {reinterpret_cast<cpptrace::frame_ptr>(&make_test_stacktrace)};
+    auto contents = capture_fd_output([&] (int fd) {
+        cpptrace::safe_print_raw_trace(fd, frames, 1);
+    });
+    auto lines = split(contents, "\n");
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_EQ(lines[0], "Stack trace (most recent call first):");
+    EXPECT_THAT(lines[1], testing::StartsWith("#0 0x"));
+    if(cpptrace::can_get_safe_object_frame()) {
+        EXPECT_THAT(lines[1], testing::HasSubstr(" in "));
+        EXPECT_THAT(lines[1], testing::HasSubstr("+0x"));
+    }
+    EXPECT_EQ(lines[2], "");
+    auto empty = capture_fd_output([&] (int fd) {
+        cpptrace::safe_print_raw_trace(fd, frames, 0);
+    });
+    EXPECT_EQ(empty, "Stack trace (most recent call first):\n<empty trace>\n");
+}
+
+#ifndef _MSC_VER
+TEST(FormatterTest, LazyDemangling) {
+    cpptrace::experimental::enable_lazy_demangling(true);
+    cpptrace::stacktrace trace;
+    trace.frames.push_back({0x1, 0x1001, {20}, {30}, "foo.cpp", "_ZN2ns3fooEi", false});
+    trace.frames.push_back({0x2, 0x1002, {30}, {40}, "bar.cpp", "_ZN2ns3barEv", false});
+    EXPECT_EQ(trace.frames[0].demangled_symbol(), "ns::foo(int)");
+    auto formatter = cpptrace::formatter{}
+        .filter([] (const cpptrace::stacktrace_frame& frame) { return frame.symbol != "_ZN2ns3barEv"; });
+    auto res = split(formatter.format(trace), "\n");
+    cpptrace::experimental::enable_lazy_demangling(false);
+    EXPECT_THAT(
+        res,
+        ElementsAre(
+            "Stack trace (most recent call first):",
+            "#0 0x" ADDR_PREFIX "00000001 in ns::foo(int) at foo.cpp:20:30",
+            "#1 (filtered)"
+        )
+    );
+}
+
+TEST(FormatterTest, LazilyResolvedTraceFormattedAfterDisabling) {
+    // the frames aren't touched by the formatter so this stands in for a trace resolved with lazy demangling on
+    cpptrace::stacktrace trace;
+    trace.frames.push_back({0x1, 0x1001, {20}, {30}, "foo.cpp", "_ZN2ns3fooEi", false});
+    trace.frames.push_back({0x2, 0x1002, {30}, {40}, "bar.cpp", "ns::bar()", false});
+    cpptrace::experimental::enable_lazy_demangling(false);
+    auto res = split(cpptrace::formatter{}.format(trace), "\n");
+    EXPECT_THAT(
+        res,
+        ElementsAre(
+            "Stack trace (most recent call first):",
+            "#0 0x" ADDR_PREFIX "00000001 in ns::foo(int) at foo.cpp:20:30",
+            "#1 0x" ADDR_PREFIX "00000002 in ns::bar() at bar.cpp:30:40"
+        )
+    );
+    auto pruned = split(
+        cpptrace::formatter{}.symbols(cpptrace::formatter::symbol_mode::pruned).format(trace),
+        "\n"
+    );
+    EXPECT_THAT(
+        pruned,
+        ElementsAre(
+            "Stack trace (most recent call first):",
+            "#0 0x" ADDR_PREFIX "00000001 in ns::foo at foo.cpp:20:30",
+            "#1 0x" ADDR_PREFIX "00000002 in ns::bar at bar.cpp:30:40"
+        )
+    );
+}
+#endif
+
 }
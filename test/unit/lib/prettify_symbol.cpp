@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef TEST_MODULE
+import cpptrace;
+#else
+#include <cpptrace/utils.hpp>
+#endif
+
+namespace {
+
+#define DO_TEST(symbol, expected) EXPECT_EQ(cpptrace::prettify_symbol(symbol), expected) << "Input: " << symbol
+
+TEST(PrettifySymbolTests, Unchanged) {
+    DO_TEST("", "");
+    DO_TEST("foo()", "foo()");
+    DO_TEST("ns::S<int>::foo(int, char) const", "ns::S<int>::foo(int, char) const");
+    DO_TEST("(anonymous namespace)::foo(unsigned long)", "(anonymous namespace)::foo(unsigned long)");
+    DO_TEST("foo(char const*, char const (&) [5])", "foo(char const*, char const (&) [5])");
+    DO_TEST("  foo()  ", "  foo()  ");
+}
+
+TEST(PrettifySymbolTests, AngleBrackets) {
+    DO_TEST("std::vector<std::vector<int> >::size()", "std::vector<std::vector<int>>::size()");
+    DO_TEST("a<b<c<int> > >::d()", "a<b<c<int>>>::d()");
+    DO_TEST("S<(1>>2)>::f()", "S<(1>>2)>::f()");
+}
+
+TEST(PrettifySymbolTests, Commas) {
+    DO_TEST("foo(int,char)", "foo(int, char)");
+    DO_TEST("foo(int , char)", "foo(int, char)");
+    DO_TEST("S<int,\tchar>::f()", "S<int, char>::f()");
+    DO_TEST("S<','>::f()", "S<','>::f()");
+}
+
+TEST(PrettifySymbolTests, Msvc) {
+    DO_TEST("class S<int> __cdecl foo(struct T const &)", "S<int> __cdecl foo(T const &)");
+    DO_TEST("`anonymous namespace'::foo(void)", "(anonymous namespace)::foo(void)");
+    DO_TEST("subclass::classify(void)", "subclass::classify(void)");
+    DO_TEST(
+        "class std::basic_string<char,struct std::char_traits<char>,class std::allocator<char> > __cdecl "
+        "foo(class std::vector<int,class std::allocator<int> > const &)",
+        "std::string __cdecl foo(std::vector<int> const &)"
+    );
+    DO_TEST(
+        "``void __cdecl foo(class S)'::`2'::<lambda_1>::operator()(void)const'",
+        "``void __cdecl foo(S)'::`2'::<lambda_1>::operator()(void)const'"
+    );
+}
+
+TEST(PrettifySymbolTests, Strings) {
+    DO_TEST(
+        "foo(std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> > const&)",
+        "foo(std::string const&)"
+    );
+    DO_TEST(
+        "foo(std::__1::basic_string<char, std::__1::char_traits<char>, std::__1::allocator<char> > const&)",
+        "foo(std::string const&)"
+    );
+    DO_TEST("foo(std::basic_string_view<char, std::char_traits<char> >)", "foo(std::string_view)");
+    DO_TEST(
+        "foo(std::__cxx11::basic_string<char16_t, std::char_traits<char16_t>, std::allocator<char16_t> >)",
+        "foo(std::basic_string<char16_t, std::char_traits<char16_t>>)"
+    );
+    DO_TEST("mystd::basic_string<char>::f()", "mystd::basic_string<char>::f()");
+}
+
+TEST(PrettifySymbolTests, DefaultArguments) {
+    DO_TEST("std::vector<int, std::allocator<int> >::push_back(int const&)", "std::vector<int>::push_back(int const&)");
+    DO_TEST(
+        "std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >"
+        "::~vector()",
+        "std::vector<std::vector<int>>::~vector()"
+    );
+    DO_TEST("std::unique_ptr<S, std::default_delete<S> >::~unique_ptr()", "std::unique_ptr<S>::~unique_ptr()");
+    DO_TEST(
+        "std::map<int, int, std::less<int>, std::allocator<std::pair<int const, int> > >::find(int const&)",
+        "std::map<int, int, std::less<int>>::find(int const&)"
+    );
+}
+
+TEST(PrettifySymbolTests, DualAbi) {
+    DO_TEST("std::__cxx11::list<int, std::allocator<int> >::clear()", "std::list<int>::clear()");
+    DO_TEST(
+        "std::__cxx11::regex_traits<char>::value(char, int) const",
+        "std::regex_traits<char>::value(char, int) const"
+    );
+}
+
+}
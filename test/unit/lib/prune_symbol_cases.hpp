@@ -0,0 +1,538 @@
+#ifndef PRUNE_SYMBOL_CASES_HPP
+#define PRUNE_SYMBOL_CASES_HPP
+
+#include <cstddef>
+
+// Inputs to cpptrace::prune_symbol and their expected results, shared by test/unit/lib/prune_symbol.cpp and
+// benchmarking/prune_symbol.cpp
+
+struct prune_symbol_case {
+    const char* symbol;
+    const char* expected;
+};
+
+namespace prune_symbol_cases {
+
+const prune_symbol_case basic[] = {
+    // https://godbolt.org/z/Weas1ETPv
+    {"foo()", "foo"},
+    {"foo(int, char)", "foo"},
+    {"void foo(void)", "foo"},
+    {"void foo(int, char)", "foo"},
+};
+
+const prune_symbol_case namespaces[] = {
+    // https://godbolt.org/z/WzfsrPhE4
+    {"foo()", "foo"},
+    {"ns::foo()", "ns::foo"},
+    {"ns::ns2::foo()", "ns::ns2::foo"},
+    {"ns::v1::bar()", "ns::v1::bar"},
+    {"(anonymous namespace)::bar()", "(anonymous namespace)::bar"},
+
+    {"void foo(void)", "foo"},
+    {"void ns::foo(void)", "ns::foo"},
+    {"void ns::ns2::foo(void)", "ns::ns2::foo"},
+    {"void ns::v1::bar(void)", "ns::v1::bar"},
+    {"void `anonymous namespace'::bar(void)", "(anonymous namespace)::bar"},
+};
+
+const prune_symbol_case basic_templates[] = {
+    // https://godbolt.org/z/czWo9bdrn
+    {"void foo<int>(int const&)", "foo"},
+    {"void foo<int, double>(int const&, double const&)", "foo"},
+    {"void foo<S<int>>(S<int> const&)", "foo"}, // llvm
+    {"void foo<S<int> >(S<int> const&)", "foo"}, // gnutils
+    {"void foo<S<int, float>>(S<int, float> const&)", "foo"},
+    {"void foo<S<int, float> >(S<int, float> const&)", "foo"},
+    {"void foo<S<S<float>, S<int>>>(S<S<float>, S<int>> const&)", "foo"},
+    {"void foo<S<S<float>, S<int> > >(S<S<float>, S<int> > const&)", "foo"},
+
+    {"void foo<int>(int const &)", "foo"},
+    {"void foo<int,double>(int const &,double const &)", "foo"},
+    {"void foo<S<int> >(S<int> const &)", "foo"},
+    {"void foo<S<int,float> >(S<int,float> const &)", "foo"},
+    {"void foo<S<S<float>,S<int> > >(S<S<float>,S<int> > const &)", "foo"},
+};
+
+const prune_symbol_case member_functions[] = {
+    // https://godbolt.org/z/re9zfzPq5
+    {"S::S()", "S::S"},
+    {"S::~S()", "S::~S"},
+    {"S::foo()", "S::foo"},
+    {"S::bar() const", "S::bar"},
+    {"void S::bar() const", "S::bar"},
+
+    {"ns::SS<>::SS()", "ns::SS::SS"},
+    {"ns::SS<>::~SS()", "ns::SS::~SS"},
+    {"ns::SS<>::foo()", "ns::SS::foo"},
+    {"ns::SS<int, float>::SS()", "ns::SS::SS"},
+    {"ns::SS<int, float>::~SS()", "ns::SS::~SS"},
+    {"ns::SS<int, float>::foo()", "ns::SS::foo"},
+    {"ns::SS<ns::SS<int>, ns::SS<float>>::SS()", "ns::SS::SS"},
+    {"ns::SS<ns::SS<int>, ns::SS<float>>::~SS()", "ns::SS::~SS"},
+    {"ns::SS<ns::SS<int>, ns::SS<float>>::foo()", "ns::SS::foo"},
+
+    {"ns::SS<>::SS<>(void)", "ns::SS::SS"},
+    {"ns::SS<>::~SS<>(void)", "ns::SS::~SS"},
+    {"void ns::SS<>::foo(void)", "ns::SS::foo"},
+    {"ns::SS<int,float>::SS<int,float>(void)", "ns::SS::SS"},
+    {"ns::SS<int,float>::~SS<int,float>(void)", "ns::SS::~SS"},
+    {"void ns::SS<int,float>::foo(void)", "ns::SS::foo"},
+    {"ns::SS<ns::SS<int>,ns::SS<float> >::SS<ns::SS<int>,ns::SS<float> >(void)", "ns::SS::SS"},
+    {"ns::SS<ns::SS<int>,ns::SS<float> >::~SS<ns::SS<int>,ns::SS<float> >(void)", "ns::SS::~SS"},
+    {"void ns::SS<ns::SS<int>,ns::SS<float> >::foo(void)", "ns::SS::foo"},
+};
+
+const prune_symbol_case templated_member_functions[] = {
+    // https://godbolt.org/z/dc3TEheK9
+    {"ns::SS<>::SS<>()", "ns::SS::SS"},
+    {"void ns::SS<>::foo<>()", "ns::SS::foo"},
+    {"ns::SS<int, float>::SS<int, float>(int, float)", "ns::SS::SS"},
+    {"void ns::SS<int, float>::foo<int, float>()", "ns::SS::foo"},
+    {"ns::SS<ns::SS<int>, ns::SS<float>>::SS<ns::SS<int>, ns::SS<float>>(ns::SS<int>, ns::SS<float>)", "ns::SS::SS"},
+    {"void ns::SS<ns::SS<int>, ns::SS<float>>::foo<ns::SS<int>, ns::SS<float>>()", "ns::SS::foo"},
+
+    {"ns::SS<ns::SS<int>, ns::SS<float> >::SS<ns::SS<int>, ns::SS<float> >(ns::SS<int>, ns::SS<float>)", "ns::SS::SS"},
+    {"void ns::SS<ns::SS<int>, ns::SS<float> >::foo<ns::SS<int>, ns::SS<float> >()", "ns::SS::foo"},
+
+    {"ns::SS<>::SS<><>(void)", "ns::SS::SS"},
+    {"void ns::SS<>::foo<>(void)", "ns::SS::foo"},
+    {"ns::SS<int,float>::SS<int,float><int,float>(int,float)", "ns::SS::SS"},
+    {"void ns::SS<int,float>::foo<int,float>(void)", "ns::SS::foo"},
+    {"ns::SS<ns::SS<int>,ns::SS<float> >::SS<ns::SS<int>,ns::SS<float> ><ns::SS<int>,ns::SS<float> >(ns::SS<int>,ns::SS<float>)", "ns::SS::SS"},
+    {"void ns::SS<ns::SS<int>,ns::SS<float> >::foo<ns::SS<int>,ns::SS<float> >(void)", "ns::SS::foo"},
+};
+
+const prune_symbol_case decltype_expressions[] = {
+    // https://godbolt.org/z/dc3TEheK9
+    {"decltype(declval<int>() + declval<int>()) foo<int>(int)", "foo"},
+    {"decltype (((declval<int>)())+((declval<int>)())) foo<int>(int)", "foo"},
+    {"decltype(std::declval<int>() + std::declval<int>()) foo<int>(int)", "foo"},
+    {"int foo<int>(int)", "foo"},
+
+    {"decltype(declval<int>() + declval<int>()) bar<int>(decltype(declval<int>()))", "bar"},
+    {"decltype (((declval<int>)())+((declval<int>)())) bar<int>(decltype ((declval<int>)()))", "bar"},
+    {"decltype(std::declval<int>() + std::declval<int>()) bar<int>(decltype(std::declval<int>()))", "bar"},
+    {"int bar<int>(int &&)", "bar"},
+
+    {"decltype(declval<int>() < declval<int>()) baz<int>(int)", "baz"},
+    {"decltype (((declval<int>)())<((declval<int>)())) baz<int>(int)", "baz"},
+    {"decltype(std::declval<int>() < std::declval<int>()) baz<int>(int)", "baz"},
+    {"bool baz<int>(int)", "baz"},
+
+    // https://godbolt.org/z/4M1xfW5rP
+    {"decltype(int{} + int{}) foo<int>(int)", "foo"},
+    {"decltype (int{}+int{}) foo<int>(int)", "foo"},
+    {"int foo<int>(int)", "foo"},
+};
+
+const prune_symbol_case operators[] = {
+    // https://godbolt.org/z/qMKEKW656
+    {"S<int>::operator*() const", "S::operator*"},
+    {"S<int>::operator+(S<int> const&) const", "S::operator+"},
+    {"S<int>::operator>(S<int> const&) const", "S::operator>"},
+    {"S<int>::operator<<(S<int> const&) const", "S::operator<<"},
+    {"S<int>::operator()() const", "S::operator()"},
+    {"S<int>::operator[](int) const", "S::operator[]"},
+
+    {"void S<int>::operator*(void)const", "S::operator*"},
+    {"void S<int>::operator+(S<int> const &)const", "S::operator+"},
+    {"void S<int>::operator>(S<int> const &)const", "S::operator>"},
+    {"void S<int>::operator<<(S<int> const &)const", "S::operator<<"},
+    {"void S<int>::operator()(void)const", "S::operator()"},
+    {"void S<int>::operator[](int)const", "S::operator[]"},
+
+    // https://godbolt.org/z/E1bqKf8vv
+    {"operator*(S, S)", "operator*"},
+    {"operator\"\" _w(unsigned long long)", "operator\"\"_w"},
+    {"unsigned __int64 operator \"\" _w(unsigned __int64)", "operator\"\"_w"},
+};
+
+const prune_symbol_case templated_operators[] = {
+    // https://godbolt.org/z/nfcrTfj7M
+    {"void operator+<S>(S, S)", "operator+"},
+    // {"void operator<<S>(S, S)", "operator<"}, // TODO FAIL
+    {"void operator<<<S>(S, S)", "operator<<"},
+    {"void operator< <S>(S, S)", "operator<"},
+    {"void operator<< <S>(S, S)", "operator<<"},
+};
+
+const prune_symbol_case operator_new_delete_co_await[] = {
+    // https://godbolt.org/z/rq16K9sK3
+    {"operator new(unsigned long)", "operator new"},
+    {"operator new[](unsigned long)", "operator new[]"},
+    {"operator delete(unsigned long)", "operator delete"},
+    {"operator delete[](unsigned long)", "operator delete[]"},
+    {"S::operator new(unsigned long)", "S::operator new"},
+    {"S::operator new[](unsigned long)", "S::operator new[]"},
+    {"S::operator delete(void*)", "S::operator delete"},
+    {"S::operator delete[](void*)", "S::operator delete[]"},
+
+    {"void * operator new(unsigned __int64)", "operator new"},
+    {"void * operator new[](unsigned __int64)", "operator new[]"},
+    {"void operator delete(void *)", "operator delete"},
+    {"void operator delete[](void *)", "operator delete[]"},
+    {"static void * S::operator new(unsigned __int64)", "S::operator new"},
+    {"static void * S::operator new[](unsigned __int64)", "S::operator new[]"},
+    {"static void S::operator delete(void *)", "S::operator delete"},
+    {"static void S::operator delete[](void *)", "S::operator delete[]"},
+
+    // https://godbolt.org/z/a3GeKjh5a
+    {"operator co_await(A)", "operator co_await"},
+    {"B::operator co_await()", "B::operator co_await"},
+    {"void operator co_await(A)", "operator co_await"},
+    {"void B::operator co_await(void)", "B::operator co_await"},
+};
+
+const prune_symbol_case nttps[] = {
+    // https://godbolt.org/z/4aPavzsba
+    {"void foo<12, 20, 256, 1>()", "foo"},
+    {"void foo<true, false>()", "foo"},
+    {"void foo<(char)97, (char)98, (char)0, (char)39>()", "foo"},
+    {"void foo<0x1p-1, 0x1.8p+3f, 0x1.00aabbccp+10>()", "foo"},
+    {"void foo<&p>()", "foo"},
+    {"void foo<&main>()", "foo"},
+    {"void foo<&void foo<20, true>()>()", "foo"},
+
+    {"void foo<12,20,256,1>(void)", "foo"},
+    {"void foo<1,0>(void)", "foo"},
+    {"void foo<0.500000,12.000000,1026.667712>(void)", "foo"},
+    {"void foo<&int p>(void)", "foo"},
+    {"void foo<&void foo<20,1>(void)>(void)", "foo"},
+
+    // https://godbolt.org/z/WEz836Yv7
+    {"void foo<fixed_string<12ul>{\"foobar`'\\\"bar\"}>()", "foo"},
+    {"void foo<fixed_string<12>{char{102,111,111,98,97,114,96,39,34,98,97,114,0}}>(void)", "foo"},
+
+    {"void foo<fixed_string<12ul>{\"foobar`'\\\"bar\"}>()::test", "foo::test"},
+    {"void foo<fixed_string<13ul>{\"foobar`\\\"bar\\\"'\"}>()::test", "foo::test"},
+    {"void foo<fixed_string<13ul>{\"foobar`\\\"bar'\"}>()::test", "foo::test"},
+    {"void foo<fixed_string<13>{char{102,111,111,98,97,114,96,34,98,97,114,34,39,0}}>(void)::test", "foo::test"},
+
+    // test that unterminated strings cause errors
+    {"void foo<bar(\"test\")>::baz", "foo::baz"},
+    {"void foo<bar(`test')>::baz", "foo::baz"},
+    {"void foo<bar(\"test)>::baz", "void foo<bar(\"test)>::baz"},
+    {"void foo<bar(`test)>::baz", "void foo<bar(`test)>::baz"},
+};
+
+const prune_symbol_case operator_nttps[] = {
+    // https://godbolt.org/z/foY7WfGv3
+    {"void foo<&S::operator<(S const&)>()", "foo"},
+    {"void foo<&S::operator>(S const&)>()", "foo"},
+    {"void foo<&S::operator>>(S const&)>()", "foo"},
+    {"void foo<&S::operator>>=(S const&)>()", "foo"},
+    {"void foo<&S::operator<=(S const&)>()", "foo"},
+    {"void foo<&S::operator<<=(S const&)>()", "foo"},
+    // {"void foo<&bool X<int, float>::operator<<int, float>(X<int, float> const&)>()", "foo"}, // TODO: FAIL
+    {"void foo<&bool X<int, float>::operator><int, float>(X<int, float> const&)>()", "foo"},
+    {"void foo<&bool X<int, float>::operator>><int, float>(X<int, float> const&)>()", "foo"},
+    {"void foo<&bool X<int, float>::operator>>=<int, float>(X<int, float> const&)>()", "foo"},
+    {"void foo<&bool X<int, float>::operator<=<int, float>(X<int, float> const&)>()", "foo"},
+    {"void foo<&bool X<int, float>::operator<<=<int, float>(X<int, float> const&)>()", "foo"},
+
+    {"void foo<&bool S::operator<(S const &)>(void)", "foo"},
+    {"void foo<&bool S::operator>(S const &)>(void)", "foo"},
+    {"void foo<&bool S::operator>>(S const &)>(void)", "foo"},
+    {"void foo<&bool S::operator>>=(S const &)>(void)", "foo"},
+    {"void foo<&bool S::operator<=(S const &)>(void)", "foo"},
+    {"void foo<&bool S::operator<<=(S const &)>(void)", "foo"},
+    // {"void foo<&bool X<int,float>::operator<<int,float>(X<int,float> const &)>(void)", "foo"}, // TODO: FAIL
+    {"void foo<&bool X<int,float>::operator><int,float>(X<int,float> const &)>(void)", "foo"},
+    {"void foo<&bool X<int,float>::operator>><int,float>(X<int,float> const &)>(void)", "foo"},
+    {"void foo<&bool X<int,float>::operator>>=<int,float>(X<int,float> const &)>(void)", "foo"},
+    {"void foo<&bool X<int,float>::operator<=<int,float>(X<int,float> const &)>(void)", "foo"},
+    {"void foo<&bool X<int,float>::operator<<=<int,float>(X<int,float> const &)>(void)", "foo"},
+
+    {"void foo<&S::operator>(S const&)>()::test", "foo::test"},
+    {"void foo<&S::operator>>(S const&)>()::test", "foo::test"},
+    {"void foo<&S::operator>>=(S const&)>()::test", "foo::test"},
+    {"void foo<&bool S::operator>(S const &)>(void)::test", "foo::test"},
+    {"void foo<&bool S::operator>>(S const &)>(void)::test", "foo::test"},
+    {"void foo<&bool S::operator>>=(S const &)>(void)::test", "foo::test"},
+    {"void foo<&bool X<int,float>::operator><int,float>(X<int,float> const &)>(void)::test", "foo::test"},
+    {"void foo<&bool X<int,float>::operator>><int,float>(X<int,float> const &)>(void)::test", "foo::test"},
+    {"void foo<&bool X<int,float>::operator>>=<int,float>(X<int,float> const &)>(void)::test", "foo::test"},
+    {"void foo<&S::operator>(S const&), bar>()::test", "foo::test"},
+    {"void foo<&S::operator>>(S const&), bar>()::test", "foo::test"},
+    {"void foo<&S::operator>>=(S const&), bar>()::test", "foo::test"},
+    {"void foo<&bool S::operator>(S const &)>(vo, barid)::test", "foo::test"},
+    {"void foo<&bool S::operator>>(S const &)>(vo, barid)::test", "foo::test"},
+    {"void foo<&bool S::operator>>=(S const &)>(vo, barid)::test", "foo::test"},
+    {"void foo<&bool X<int,float>::operator><int,float>(X<int,float> const &)>(vo, barid)::test", "foo::test"},
+    {"void foo<&bool X<int,float>::operator>><int,float>(X<int,float> const &)>(vo, barid)::test", "foo::test"},
+    {"void foo<&bool X<int,float>::operator>>=<int,float>(X<int,float> const &)>(vo, barid)::test", "foo::test"},
+
+    // TODO: foo<&S::operator>>() isn't legal C++ but maybe it could appear in demangled output?
+};
+
+const prune_symbol_case basic_lambdas[] = {
+    // https://godbolt.org/z/5n83rGK8j
+    {"main::'lambda'()::operator()() const", "main::<lambda>::operator()"},
+    {"main::'lambda0'()::operator()() const", "main::<lambda0>::operator()"},
+    {"main::{lambda()#1}::operator()() const", "main::<lambda#1>::operator()"},
+    {"main::{lambda()#2}::operator()() const", "main::<lambda#2>::operator()"},
+    {"main::$_0::operator()() const", "main::$_0::operator()"},
+    {"main::$_1::operator()() const", "main::$_1::operator()"},
+    {"`int main(void)'::`2'::<lambda_1>::operator()(void)const", "`main'::`2'::<lambda_1>::operator()"},
+    {"`int main(void)'::`2'::<lambda_2>::operator()(void)const", "`main'::`2'::<lambda_2>::operator()"},
+};
+
+const prune_symbol_case templated_lambdas[] = {
+    // https://godbolt.org/z/GGEWfE144
+    {"auto main::'lambda'<typename $T>($T)::operator()<int>($T) const", "main::<lambda>::operator()"},
+    {"auto main::{lambda<typename $T0>($T0)#1}::operator()<int>(int) const", "main::<lambda#1>::operator()"},
+    // {"", ""}, // TODO: llvm-symbolizer can't handle currently
+    {"auto `int main(void)'::`2'::<lambda_1>::operator()<int>(int)const", "`main'::`2'::<lambda_1>::operator()"},
+};
+
+const prune_symbol_case nested_lambdas[] = {
+    // https://godbolt.org/z/s4GseqrGK
+    {"main::'lambda'()::operator()() const", "main::<lambda>::operator()"},
+    {"main::'lambda'()::operator()() const::'lambda'()::operator()() const", "main::<lambda>::operator()::<lambda>::operator()"},
+    {"main::{lambda()#1}::operator()() const", "main::<lambda#1>::operator()"},
+    {"main::{lambda()#1}::operator()() const::{lambda()#1}::operator()() const", "main::<lambda#1>::operator()::<lambda#1>::operator()"},
+    {"main::$_0::operator()() const", "main::$_0::operator()"},
+    {"main::$_0::operator()() const::'lambda'()::operator()() const", "main::$_0::operator()::<lambda>::operator()"},
+    {"`int main(void)'::`2'::<lambda_1>::operator()(void)const", "`main'::`2'::<lambda_1>::operator()"},
+    {"``int main(void)'::`2'::<lambda_1>::operator()(void)const '::`2'::<lambda_1>::operator()(void)const", "``main'::`2'::<lambda_1>::operator()'::`2'::<lambda_1>::operator()"},
+    // https://godbolt.org/z/fnvW63819
+    {"auto main::'lambda'<typename $T>($T)::operator()<int>($T) const", "main::<lambda>::operator()"},
+    {"auto auto main::'lambda'<typename $T>($T)::operator()<int>($T) const::'lambda'<typename $T0>($T)::operator()<int>($T) const", "main::<lambda>::operator()::<lambda>::operator()"},
+    {"auto main::{lambda<typename $T0>($T0)#1}::operator()<int>(int) const", "main::<lambda#1>::operator()"},
+    {"auto main::{lambda<typename $T0>($T0)#1}::operator()<int>(int) const::{lambda<typename $T0>($T0)#1}::operator()<int>(int) const", "main::<lambda#1>::operator()::<lambda#1>::operator()"},
+    // TODO: LLVM
+    // TODO: LLVM
+    {"auto `int main(void)'::`2'::<lambda_1>::operator()<int>(int)const", "`main'::`2'::<lambda_1>::operator()"},
+    {"auto `auto `int main(void)'::`2'::<lambda_1>::operator()<int>(int)const '::`2'::<lambda_1>::operator()<int>(int)const", "``main'::`2'::<lambda_1>::operator()'::`2'::<lambda_1>::operator()"},
+};
+
+const prune_symbol_case lambda_template_args[] = {
+    // https://godbolt.org/z/9f53KezPE
+    {"S<main::'lambda'()>::foo()", "S::foo"},
+    {"SS<main::'lambda0'(){}>::foo()", "SS::foo"},
+    {"S<main::{lambda()#1}>::foo()", "S::foo"},
+    {"SS<main::{lambda()#2}{}>::foo()", "SS::foo"},
+    {"void S<`int main(void)'::`2'::<lambda_1_> >::foo(void)", "S::foo"},
+    {"void SS<`int main(void)'::`2'::<lambda_2_>{}>::foo(void)", "SS::foo"},
+};
+
+const prune_symbol_case lambdas_in_templates[] = {
+    // https://godbolt.org/z/qKv8xz7Mv
+    {"S<int>::foo()::'lambda'()::operator()() const", "S::foo::<lambda>::operator()"},
+    {"S<int>::foo()::{lambda()#1}::operator()() const", "S::foo::<lambda#1>::operator()"},
+    {"`void S<int>::foo(void)'::`2'::<lambda_1>::operator()(void)const", "`S::foo'::`2'::<lambda_1>::operator()"},
+};
+
+const prune_symbol_case local_types[] = {
+    // https://godbolt.org/z/51fbhMTMe
+    {"foo()::S::bar()", "foo::S::bar"},
+    {"void `void foo(void)'::`2'::S::bar(void)", "`foo'::`2'::S::bar"},
+
+    {"foo()::S::bar()::'lambda'()::operator()() const::V::boo()", "foo::S::bar::<lambda>::operator()::V::boo"},
+    {"foo()::S::bar()::{lambda()#1}::operator()() const::V::boo()", "foo::S::bar::<lambda#1>::operator()::V::boo"},
+    {"void ``void `void foo(void)'::`2'::S::bar(void)'::`2'::<lambda_1>::operator()(void)const '::`2'::V::boo(void)", "```foo'::`2'::S::bar'::`2'::<lambda_1>::operator()'::`2'::V::boo"},
+
+    // https://godbolt.org/z/hGaW8j9r3
+    {"auto auto A<SS>::foo<SS>()::'lambda'(auto)::operator()<int>(auto) const", "A::foo::<lambda>::operator()"},
+    {"auto auto A<SS>::foo<SS>()::'lambda'(auto)::operator()<int>(auto) const::S::foo()", "A::foo::<lambda>::operator()::S::foo"},
+    {"auto A<SS>::foo<SS>()::{lambda(auto:1)#1}::operator()<int>(int) const", "A::foo::<lambda#1>::operator()"},
+    {"A<SS>::foo<SS>()::{lambda(auto:1)#1}::operator()<int>(int) const::S::foo()", "A::foo::<lambda#1>::operator()::S::foo"},
+    {"auto `auto A<SS>::foo<SS>(void)'::`2'::<lambda_1>::operator()<int>(int)const", "`A::foo'::`2'::<lambda_1>::operator()"},
+    {"void `auto `auto A<SS>::foo<SS>(void)'::`2'::<lambda_1>::operator()<int>(int)const '::`2'::S::foo(void)", "``A::foo'::`2'::<lambda_1>::operator()'::`2'::S::foo"},
+};
+
+const prune_symbol_case qualifiers_and_attributes[] = {
+    // https://godbolt.org/z/rG5Ed5qed
+    {"S::foo() const volatile &&", "S::foo"},
+    {"int const && S::foo(void)const volatile &&", "S::foo"},
+
+    {"auto main::'lambda'(auto const volatile&&)::operator()<'lambda'(auto const volatile&&)>(this auto const volatile&&)", "main::<lambda>::operator()"},
+    {"auto main::{lambda(auto:1 const volatile&&)#1}::operator()<{lambda(auto:1 const volatile&&)#1}>(this {lambda(auto:1 const volatile&&)#1} const volatile&&)", "main::<lambda#1>::operator()"},
+    {"static auto `int main(void)'::`2'::<lambda_1>::operator()<`int main(void)'::`2'::<lambda_1> >(UNKNOWN,`int main(void)'::`2'::<lambda_1> const volatile &&)", "`main'::`2'::<lambda_1>::operator()"},
+};
+
+const prune_symbol_case conversion_operator[] = {
+    // https://godbolt.org/z/v8hc1vb9P
+    {"S::operator int()", "S::operator int"},
+    {"S::operator void*()", "S::operator void*"},
+    {"S::operator std::nullptr_t()", "S::operator std::nullptr_t"},
+    {"S::operator X<int>()", "S::operator X"},
+    {"S::operator ns::Z()", "S::operator ns::Z"},
+    {"S::operator ns::Y<int><int>()", "S::operator ns::Y"},
+    {"S::operator main::'lambda'()<main::'lambda'()>()", "S::operator main::<lambda>"},
+    {"S::operator main::'lambda'()<main::'lambda'()>()::'lambda'()::operator()() const", "S::operator main::<lambda>::<lambda>::operator()"},
+
+    {"S::operator decltype(nullptr)()", "S::operator decltype(nullptr)"},
+    {"S::operator main::{lambda()#1}<main::{lambda()#1}>()", "S::operator main::<lambda#1>"},
+    {"S::operator main::{lambda()#1}<main::{lambda()#1}>()::{lambda()#1}::operator()() const", "S::operator main::<lambda#1>::<lambda#1>::operator()"},
+
+    {"S::operator main::$_0<main::$_0>()", "S::operator main::$_0"},
+    {"S::operator main::$_0<main::$_0>()::'lambda'()::operator()() const", "S::operator main::$_0::<lambda>::operator()"},
+
+    // https://godbolt.org/z/4qqP9reqr
+    {"S::operator S::operator*()::X<S::operator*()::X>()", "S::operator S::operator*::X"},
+    // {"S::operator<`S::operator*(void)'::`2'::X> `S::operator*(void)'::`2'::X(void)", "S::operator `S::operator*'::`2'::X"}, // TODO FAIL
+
+    {"S::operator T&()", "S::operator T&"},
+    {"S::operator T&&()", "S::operator T&&"},
+
+    // https://godbolt.org/z/PTe1xh6Go
+    {"S::operator int X::*()", "S::operator int X::*"},
+    {"S::operator int Y<int>::*()", "S::operator int Y::*"},
+
+    {"S::operator std::vector<int> X::*()", "S::operator std::vector X::*"},
+    {"S::operator std::vector<int> Y<int>::*()", "S::operator std::vector Y::*"},
+    {"S::operator std::vector<int> ns<X>::ns::X::*()", "S::operator std::vector ns::ns::X::*"},
+    {"S::operator std::vector<int> ns<X>::ns::Y<int>::*()", "S::operator std::vector ns::ns::Y::*"},
+    {"S::operator std::vector<int> ns<X>::ns::X::*()::test", "S::operator std::vector ns::ns::X::*::test"},
+    {"S::operator std::vector<int> ns<X>::ns::Y<int>::*()::test", "S::operator std::vector ns::ns::Y::*::test"},
+};
+
+const prune_symbol_case deduced_conversion_operator[] = {
+    // https://godbolt.org/z/9rzdKvGh7
+    {"S<float>::operator auto()", "S::operator auto"},
+    {"S<float>::operator auto()", "S::operator auto"},
+    {"S<float>::operator decltype(auto)()", "S::operator decltype(auto)"},
+
+    // {"S<float>::operator (void)", "S::operator"}, // Microsoft's lovely demangling
+    // {"S<float>::operator (void)::test", "S::operator::test"},
+    {"S<float>::operator float(void)", "S::operator float"},
+};
+
+const prune_symbol_case function_pointers[] = {
+    // https://godbolt.org/z/TWfa4f6Kc
+    {"void (*foo<int>())(int, double)", "foo"},
+    {"void (**foo<int>())(int, double)", "foo"},
+    {"void (&baz<int>())(int, double)", "baz"},
+    {"void (** (**bar<int>())(int, double))(int, double)", "bar"},
+    {"void (**(**bar<int>())(int, double))(int, double)", "bar"},
+    {"void (__cdecl** foo<int>(void))(int,double)", "foo"},
+    {"void (__cdecl** (__cdecl** bar<int>(void))(int,double))(int,double)", "bar"},
+    {"void (__cdecl&baz<int>(void))(int,double)", "baz"},
+};
+
+const prune_symbol_case unnamed_types[] = {
+    // https://godbolt.org/z/jx8GnrW4v
+    {"main::'unnamed'::foo()", "main::<unnamed>::foo"},
+    {"main::{unnamed type#1}::foo()", "main::<unnamed type#1>::foo"},
+};
+
+const prune_symbol_case template_heavy_symbols[] = {
+    // https://godbolt.org/z/z1nrMsYfs
+    {"__find_if<__gnu_cxx::__normal_iterator<int*, std::vector<int> >, __gnu_cxx::__ops::_Iter_pred<main()::<lambda(auto:19)> > >", "__find_if"},
+    // {"operator()<__gnu_cxx::__normal_iterator<int*, std::vector<int> >, __gnu_cxx::__normal_iterator<int*, std::vector<int> >, std::identity, main()::<lambda(auto:18)> >", "ns::SS::SS"},
+    {"std::__1::find_if[abi:ne200100]<std::__1::__wrap_iter<int*>, main::$_1>(std::__1::__wrap_iter<int*>, std::__1::__wrap_iter<int*>, main::$_1)", "std::__1::find_if"},
+    {"std::__1::_IfImpl<borrowed_range<T>>::_Select<decltype(std::__1::ranges::__cpo::begin(std::declval<T&>())), std::__1::ranges::dangling> std::__1::ranges::__find_if::operator()[abi:ne200100]<std::__1::vector<int, std::__1::allocator<int>>&, std::__1::identity, main::$_0>(T&&, main::$_0, T0) const", "std::__1::ranges::__find_if::operator()"},
+    {"std::__1::ranges::__find_if_impl[abi:ne200100]<std::__1::__wrap_iter<int*>, std::__1::__wrap_iter<int*>, main::$_0, std::__1::identity>(std::__1::__wrap_iter<int*>, std::__1::__wrap_iter<int*>, main::$_0&, std::__1::identity&)", "std::__1::ranges::__find_if_impl"},
+};
+
+const prune_symbol_case storage_classes[] = {
+    // https://godbolt.org/z/xPYKW8Pz5
+    {"static void S::foo(void)", "S::foo"},
+};
+
+const prune_symbol_case noexcept_specifiers[] = {
+    // https://godbolt.org/z/xjsM67s17
+    {"void foo<X>(X (*)() noexcept(X::n))", "foo"},
+};
+
+const prune_symbol_case misc_nesting[] = {
+    // https://godbolt.org/z/5Gj99ernr
+    {"void use1<5>(Wrapper<(5)<(5)>)", "use1"},
+    {"void use2<5>(Wrapper<((5)>(5))>)", "use2"},
+    {"void use1<5>(Wrapper<5 < 5>)", "use1"},
+    {"void use2<5>(Wrapper<(5 > 5)>)", "use2"},
+    {"void use1<5>(Wrapper<0>)", "use1"},
+    {"void use2<5>(Wrapper<0>)", "use2"},
+};
+
+const prune_symbol_case misc[] = {
+    // https://godbolt.org/z/cqfW7MK57
+    {"foo(...)", "foo"},
+};
+
+const prune_symbol_case extra[] = {
+    {"operator<<(std::ostream&, Foo const&)", "operator<<"},
+    {"std::ostream & operator<<(std::ostream &, Foo const &)", "operator<<"},
+    {"Foo::operator+=(int)", "Foo::operator+="},
+    {"Foo::operator+=(int) const", "Foo::operator+="},
+    {"Foo::operator bool() const noexcept", "Foo::operator bool"},
+    {"Foo::operator int() const", "Foo::operator int"},
+
+    {"Foo::bar() const", "Foo::bar"},
+    {"Foo::bar() volatile", "Foo::bar"},
+    {"Foo::bar() const &", "Foo::bar"},
+    {"Foo::bar() &&", "Foo::bar"},
+    {"Foo::bar() const noexcept", "Foo::bar"},
+    {"Foo::bar() const & noexcept", "Foo::bar"},
+
+    {"void foo<3>()", "foo"},
+    {"void foo<'a'>()", "foo"},
+    {"void foo<true>()", "foo"},
+    {"void foo<&Foo::bar>()", "foo"},
+    {"void foo<(int)5>()", "foo"},
+
+    {"main::{lambda()#1}::operator()() const", "main::<lambda#1>::operator()"},
+    {"main::$_0::operator()() const", "main::$_0::operator()"},
+
+    {"virtual void __cdecl ns::Foo::bar(int) const", "ns::Foo::bar"},
+    {"static int __cdecl ns::Foo::baz(char)", "ns::Foo::baz"},
+    {"__thiscall Foo::Foo(void)", "Foo::Foo"},
+    {"virtual __thiscall Foo::~Foo(void)", "Foo::~Foo"},
+
+    {"virtual thunk to Foo::bar()", "Foo::bar"},
+
+    {"void foo<std::vector<int,std::allocator<int>>>(std::vector<int,std::allocator<int>> const&)", "foo"},
+    {"void foo<std::basic_string<char>>(std::basic_string<char> const&)", "foo"},
+};
+
+const prune_symbol_case regression_tests[] = {
+    // Symbols I've observed not pruning correctly
+    {"void (* const&std::_Any_data::_M_access<void (*)(cpptrace::v1::log_level, char const*)>() const)(cpptrace::v1::log_level, char const*)", "std::_Any_data::_M_access"},
+    {"void (* const*std::__addressof<void (* const)(cpptrace::v1::log_level, char const*)>(void (* const&)(cpptrace::v1::log_level, char const*)))(cpptrace::v1::log_level, char const*)", "std::__addressof"},
+    {"void (* const&std::forward<void (* const&)(cpptrace::v1::log_level, char const*)>(std::remove_reference<void (* const&)(cpptrace::v1::log_level, char const*)>::type&))(cpptrace::v1::log_level, char const*)", "std::forward"},
+    {"fmt::v10::detail::parse_format_specs<char>(char const*, char const*, fmt::v10::detail::dynamic_format_specs<char>&, fmt::v10::basic_format_parse_context<char>&, fmt::v10::detail::type)::{unnamed type#1}::operator()(fmt::v10::detail::state, bool)", "fmt::v10::detail::parse_format_specs::<unnamed type#1>::operator()"},
+    {"fmt::v10::detail::parse_format_specs<char>(char const*, char const*, fmt::v10::detail::dynamic_format_specs<char>&, fmt::v10::basic_format_parse_context<char>&, fmt::v10::detail::type)::{unnamed type#2}::operator()(fmt::v10::presentation_type, int)", "fmt::v10::detail::parse_format_specs::<unnamed type#2>::operator()"},
+};
+
+struct group {
+    const prune_symbol_case* begin;
+    const prune_symbol_case* end;
+};
+
+const group all[] = {
+    {basic, basic + sizeof(basic) / sizeof(basic[0])},
+    {namespaces, namespaces + sizeof(namespaces) / sizeof(namespaces[0])},
+    {basic_templates, basic_templates + sizeof(basic_templates) / sizeof(basic_templates[0])},
+    {member_functions, member_functions + sizeof(member_functions) / sizeof(member_functions[0])},
+    {templated_member_functions, templated_member_functions + sizeof(templated_member_functions) / sizeof(templated_member_functions[0])},
+    {decltype_expressions, decltype_expressions + sizeof(decltype_expressions) / sizeof(decltype_expressions[0])},
+    {operators, operators + sizeof(operators) / sizeof(operators[0])},
+    {templated_operators, templated_operators + sizeof(templated_operators) / sizeof(templated_operators[0])},
+    {operator_new_delete_co_await, operator_new_delete_co_await + sizeof(operator_new_delete_co_await) / sizeof(operator_new_delete_co_await[0])},
+    {nttps, nttps + sizeof(nttps) / sizeof(nttps[0])},
+    {operator_nttps, operator_nttps + sizeof(operator_nttps) / sizeof(operator_nttps[0])},
+    {basic_lambdas, basic_lambdas + sizeof(basic_lambdas) / sizeof(basic_lambdas[0])},
+    {templated_lambdas, templated_lambdas + sizeof(templated_lambdas) / sizeof(templated_lambdas[0])},
+    {nested_lambdas, nested_lambdas + sizeof(nested_lambdas) / sizeof(nested_lambdas[0])},
+    {lambda_template_args, lambda_template_args + sizeof(lambda_template_args) / sizeof(lambda_template_args[0])},
+    {lambdas_in_templates, lambdas_in_templates + sizeof(lambdas_in_templates) / sizeof(lambdas_in_templates[0])},
+    {local_types, local_types + sizeof(local_types) / sizeof(local_types[0])},
+    {qualifiers_and_attributes, qualifiers_and_attributes + sizeof(qualifiers_and_attributes) / sizeof(qualifiers_and_attributes[0])},
+    {conversion_operator, conversion_operator + sizeof(conversion_operator) / sizeof(conversion_operator[0])},
+    {deduced_conversion_operator, deduced_conversion_operator + sizeof(deduced_conversion_operator) / sizeof(deduced_conversion_operator[0])},
+    {function_pointers, function_pointers + sizeof(function_pointers) / sizeof(function_pointers[0])},
+    {unnamed_types, unnamed_types + sizeof(unnamed_types) / sizeof(unnamed_types[0])},
+    {template_heavy_symbols, template_heavy_symbols + sizeof(template_heavy_symbols) / sizeof(template_heavy_symbols[0])},
+    {storage_classes, storage_classes + sizeof(storage_classes) / sizeof(storage_classes[0])},
+    {noexcept_specifiers, noexcept_specifiers + sizeof(noexcept_specifiers) / sizeof(noexcept_specifiers[0])},
+    {misc_nesting, misc_nesting + sizeof(misc_nesting) / sizeof(misc_nesting[0])},
+    {misc, misc + sizeof(misc) / sizeof(misc[0])},
+    {extra, extra + sizeof(extra) / sizeof(extra[0])},
+    {regression_tests, regression_tests + sizeof(regression_tests) / sizeof(regression_tests[0])},
+};
+
+}
+
+#endif
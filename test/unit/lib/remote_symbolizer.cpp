@@ -0,0 +1,160 @@
+#ifndef _WIN32
+
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifdef TEST_MODULE
+import cpptrace;
+#else
+#include <cpptrace/cpptrace.hpp>
+#include <cpptrace/serialization.hpp>
+#endif
+
+using namespace std::literals;
+
+namespace {
+
+// Stands in for cpptrace-symbolizerd, answering a single request
+class fake_symbolizer {
+    std::string path;
+    int listener;
+    std::thread thread;
+    // resolve every frame with an inlined call, as libdwarf would report it
+    bool with_inlines;
+    std::size_t requested = 0;
+
+public:
+    explicit fake_symbolizer(bool with_inlines = false)
+        : path("/tmp/cpptrace-test-symbolizer-" + std::to_string(getpid()) + ".sock"),
+          with_inlines(with_inlines) {
+        listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, path.c_str());
+        unlink(path.c_str());
+        EXPECT_EQ(bind(listener, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), 0);
+        EXPECT_EQ(listen(listener, 1), 0);
+        thread = std::thread([this] { serve(); });
+    }
+
+    ~fake_symbolizer() {
+        thread.join();
+        close(listener);
+        unlink(path.c_str());
+    }
+
+    const std::string& socket_path() const {
+        return path;
+    }
+
+    // only valid after the request was served
+    std::size_t requested_frames() const {
+        return requested;
+    }
+
+private:
+    void serve() {
+        int fd = accept(listener, nullptr, nullptr);
+        if(fd == -1) {
+            return;
+        }
+        cpptrace::experimental::trace_decoder decoder;
+        char buffer[256];
+        ssize_t count;
+        while((count = read(fd, buffer, sizeof(buffer))) > 0) {
+            decoder.feed(buffer, static_cast<std::size_t>(count));
+        }
+        cpptrace::experimental::decoded_trace request;
+        if(decoder.next(request) == cpptrace::experimental::decode_status::ok) {
+            requested = request.object.frames.size();
+            cpptrace::stacktrace response;
+            for(const auto& frame : request.object.frames) {
+                if(with_inlines) {
+                    response.frames.push_back(
+                        {frame.raw_address, frame.object_address, {7}, {}, frame.object_path + ".hpp", "inlined", true}
+                    );
+                }
+                response.frames.push_back(
+                    {frame.raw_address, frame.object_address, {42}, {}, frame.object_path + ".cpp", "remote", false}
+                );
+            }
+            cpptrace::experimental::trace_encoder encoder;
+            encoder.encode(response);
+            auto data = encoder.take();
+            EXPECT_EQ(write(fd, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+        }
+        close(fd);
+    }
+};
+
+TEST(RemoteSymbolizer, Basic) {
+    fake_symbolizer symbolizer;
+    cpptrace::experimental::use_remote_symbolizer(symbolizer.socket_path());
+    cpptrace::object_trace trace{{{0x1234, 0x234, "/no/such/object"}, {0x5678, 0x678, "/no/such/object"}}};
+    auto resolved = trace.resolve();
+    cpptrace::experimental::use_remote_symbolizer("");
+    ASSERT_EQ(resolved.frames.size(), 2);
+    EXPECT_EQ(resolved.frames[0].raw_address, 0x1234);
+    EXPECT_EQ(resolved.frames[0].object_address, 0x234);
+    EXPECT_EQ(resolved.frames[0].filename, "/no/such/object.cpp");
+    EXPECT_EQ(resolved.frames[0].line.value(), 42);
+    EXPECT_EQ(resolved.frames[0].symbol, "remote");
+    EXPECT_EQ(resolved.frames[1].object_address, 0x678);
+}
+
+TEST(RemoteSymbolizer, InlinedFrames) {
+    fake_symbolizer symbolizer(true);
+    cpptrace::experimental::use_remote_symbolizer(symbolizer.socket_path());
+    cpptrace::object_trace trace{{{0x1234, 0x234, "/no/such/object"}, {0x5678, 0x678, "/no/such/object"}}};
+    auto resolved = trace.resolve();
+    cpptrace::experimental::use_remote_symbolizer("");
+    ASSERT_EQ(resolved.frames.size(), 4);
+    EXPECT_EQ(resolved.frames[0].symbol, "inlined");
+    EXPECT_TRUE(resolved.frames[0].is_inline);
+    EXPECT_EQ(resolved.frames[0].line.value(), 7);
+    EXPECT_EQ(resolved.frames[1].symbol, "remote");
+    EXPECT_FALSE(resolved.frames[1].is_inline);
+    EXPECT_EQ(resolved.frames[2].symbol, "inlined");
+    EXPECT_EQ(resolved.frames[3].symbol, "remote");
+    EXPECT_EQ(resolved.frames[3].object_address, 0x678);
+}
+
+TEST(RemoteSymbolizer, FramesWithoutObjectResolvedLocally) {
+    fake_symbolizer symbolizer(true);
+    cpptrace::experimental::use_remote_symbolizer(symbolizer.socket_path());
+    cpptrace::object_trace trace{
+        {{0x1234, 0x234, "/no/such/object"}, {0x9999, 0, ""}, {0x5678, 0x678, "/no/such/object"}}
+    };
+    auto resolved = trace.resolve();
+    cpptrace::experimental::use_remote_symbolizer("");
+    EXPECT_EQ(symbolizer.requested_frames(), 2);
+    ASSERT_EQ(resolved.frames.size(), 5);
+    EXPECT_EQ(resolved.frames[1].symbol, "remote");
+    EXPECT_EQ(resolved.frames[1].raw_address, 0x1234);
+    EXPECT_EQ(resolved.frames[2].raw_address, 0x9999);
+    EXPECT_NE(resolved.frames[2].symbol, "remote");
+    EXPECT_EQ(resolved.frames[3].symbol, "inlined");
+    EXPECT_EQ(resolved.frames[4].raw_address, 0x5678);
+}
+
+TEST(RemoteSymbolizer, FallsBackWhenUnreachable) {
+    cpptrace::experimental::use_remote_symbolizer("/tmp/cpptrace-test-no-symbolizer.sock");
+    auto trace = cpptrace::generate_trace();
+    cpptrace::experimental::use_remote_symbolizer("");
+    ASSERT_GE(trace.frames.size(), 1);
+    EXPECT_THAT(trace.frames[0].symbol, testing::HasSubstr("RemoteSymbolizer_FallsBackWhenUnreachable_Test::TestBody"));
+}
+
+}
+
+#endif
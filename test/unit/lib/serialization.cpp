@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#include <string>
+#include <vector>
+
+#ifdef TEST_MODULE
+import cpptrace;
+#else
+#include <cpptrace/serialization.hpp>
+#endif
+
+using cpptrace::experimental::decode_status;
+using cpptrace::experimental::decoded_trace;
+using cpptrace::experimental::trace_decoder;
+using cpptrace::experimental::trace_encoder;
+
+namespace {
+
+cpptrace::raw_trace make_raw_trace() {
+    return cpptrace::raw_trace{{0x7f001234, 0x7f001000, 0x5555a000, 0x7f001234}};
+}
+
+cpptrace::object_trace make_object_trace() {
+    return cpptrace::object_trace{{
+        {0x7f001234, 0x1234, "/usr/lib/libfoo.so"},
+        {0x7f005678, 0x5678, "/usr/lib/libfoo.so"},
+        {0x5555a000, 0x6000, "/opt/app/bin/app"},
+    }};
+}
+
+cpptrace::stacktrace make_stacktrace() {
+    cpptrace::stacktrace trace;
+    trace.frames.push_back({0x5555a000, 0x6000, {20}, {30}, "foo.cpp", "foo()", false});
+    trace.frames.push_back({0, 0, {10}, {}, "foo.cpp", "bar()", true});
+    trace.frames.push_back({0x5555b000, 0x7000, {}, {}, "", "main", false});
+    return trace;
+}
+
+void expect_raw_trace(trace_decoder& decoder, const cpptrace::raw_trace& expected) {
+    decoded_trace out;
+    ASSERT_EQ(decoder.next(out), decode_status::ok);
+    ASSERT_EQ(out.type, decoded_trace::trace_type::raw);
+    EXPECT_EQ(out.raw.frames, expected.frames);
+}
+
+void expect_object_trace(trace_decoder& decoder, const cpptrace::object_trace& expected) {
+    decoded_trace out;
+    ASSERT_EQ(decoder.next(out), decode_status::ok);
+    ASSERT_EQ(out.type, decoded_trace::trace_type::object);
+    ASSERT_EQ(out.object.frames.size(), expected.frames.size());
+    for(std::size_t i = 0; i < expected.frames.size(); i++) {
+        EXPECT_EQ(out.object.frames[i].raw_address, expected.frames[i].raw_address);
+        EXPECT_EQ(out.object.frames[i].object_address, expected.frames[i].object_address);
+        EXPECT_EQ(out.object.frames[i].object_path, expected.frames[i].object_path);
+    }
+}
+
+void expect_stacktrace(trace_decoder& decoder, const cpptrace::stacktrace& expected) {
+    decoded_trace out;
+    ASSERT_EQ(decoder.next(out), decode_status::ok);
+    ASSERT_EQ(out.type, decoded_trace::trace_type::resolved);
+    EXPECT_EQ(out.resolved.frames, expected.frames);
+}
+
+TEST(SerializationTest, RoundTrip) {
+    trace_encoder encoder;
+    encoder.encode(make_raw_trace());
+    encoder.encode(make_object_trace());
+    encoder.encode(make_stacktrace());
+    encoder.encode(cpptrace::raw_trace{});
+    trace_decoder decoder;
+    decoder.feed(encoder.take());
+    EXPECT_TRUE(encoder.data().empty());
+    expect_raw_trace(decoder, make_raw_trace());
+    expect_object_trace(decoder, make_object_trace());
+    expect_stacktrace(decoder, make_stacktrace());
+    expect_raw_trace(decoder, cpptrace::raw_trace{});
+    decoded_trace out;
+    EXPECT_EQ(decoder.next(out), decode_status::need_more_input);
+}
+
+TEST(SerializationTest, UninternedSymbols) {
+    trace_encoder encoder;
+    encoder.intern_symbols(false);
+    encoder.encode(make_stacktrace());
+    trace_decoder decoder;
+    decoder.feed(encoder.data());
+    expect_stacktrace(decoder, make_stacktrace());
+}
+
+TEST(SerializationTest, StringsAreWrittenOnce) {
+    trace_encoder encoder;
+    encoder.encode(make_stacktrace());
+    auto first = encoder.take();
+    encoder.encode(make_stacktrace());
+    auto second = encoder.take();
+    EXPECT_LT(second.size(), first.size());
+    EXPECT_EQ(second.find("foo.cpp"), std::string::npos);
+    // the second piece continues the stream
+    trace_decoder decoder;
+    decoder.feed(first);
+    decoder.feed(second);
+    expect_stacktrace(decoder, make_stacktrace());
+    expect_stacktrace(decoder, make_stacktrace());
+}
+
+TEST(SerializationTest, ByteAtATime) {
+    trace_encoder encoder;
+    encoder.encode(make_object_trace());
+    encoder.encode(make_stacktrace());
+    auto data = encoder.take();
+    trace_decoder decoder;
+    std::vector<decoded_trace> traces;
+    for(char c : data) {
+        decoder.feed(&c, 1);
+        decoded_trace out;
+        auto status = decoder.next(out);
+        ASSERT_NE(status, decode_status::error);
+        if(status == decode_status::ok) {
+            traces.push_back(std::move(out));
+        }
+    }
+    ASSERT_EQ(traces.size(), 2);
+    EXPECT_EQ(traces[0].type, decoded_trace::trace_type::object);
+    EXPECT_EQ(traces[0].object.frames.size(), 3);
+    EXPECT_EQ(traces[1].type, decoded_trace::trace_type::resolved);
+    EXPECT_EQ(traces[1].resolved.frames, make_stacktrace().frames);
+}
+
+TEST(SerializationTest, Reset) {
+    trace_encoder encoder;
+    encoder.encode(make_object_trace());
+    auto first = encoder.take();
+    encoder.reset();
+    encoder.encode(make_object_trace());
+    auto second = encoder.take();
+    // a new stream doesn't depend on the previous one
+    EXPECT_EQ(first, second);
+    trace_decoder decoder;
+    decoder.feed(first + second);
+    expect_object_trace(decoder, make_object_trace());
+    expect_object_trace(decoder, make_object_trace());
+}
+
+TEST(SerializationTest, MalformedInput) {
+    decoded_trace out;
+    trace_decoder garbage;
+    garbage.feed(std::string("not a trace stream"));
+    EXPECT_EQ(garbage.next(out), decode_status::error);
+    EXPECT_EQ(garbage.next(out), decode_status::error);
+
+    // a stream has to start with a header
+    trace_encoder encoder;
+    encoder.encode(make_raw_trace());
+    auto data = encoder.take();
+    encoder.encode(make_raw_trace());
+    trace_decoder headerless;
+    headerless.feed(encoder.take());
+    EXPECT_EQ(headerless.next(out), decode_status::error);
+
+    // string references must refer to strings defined earlier in the stream
+    // header, then an object trace record with one frame referring to string 0
+    auto header = data.substr(0, 6);
+    trace_decoder missing_strings;
+    missing_strings.feed(header + std::string("\x03\x01\x00\x00\x00", 5));
+    EXPECT_EQ(missing_strings.next(out), decode_status::error);
+}
+
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#include <cstdint>
+#include <numeric>
+
+#ifdef TEST_MODULE
+import cpptrace;
+#else
+#include <cpptrace/cpptrace.hpp>
+#include <cpptrace/utils.hpp>
+#endif
+
+namespace {
+
+std::uint64_t bucket_total(const cpptrace::experimental::latency_histogram& histogram) {
+    return std::accumulate(histogram.buckets.begin(), histogram.buckets.end(), std::uint64_t(0));
+}
+
+TEST(Statistics, Captures) {
+    cpptrace::experimental::reset_statistics();
+    auto trace = cpptrace::generate_raw_trace();
+    cpptrace::generate_raw_trace();
+    auto statistics = cpptrace::experimental::get_statistics();
+    EXPECT_EQ(statistics.captures, 2);
+    EXPECT_GE(statistics.frames_captured, 2 * trace.frames.size());
+    EXPECT_EQ(statistics.unwinding_time.count, 2);
+    EXPECT_EQ(bucket_total(statistics.unwinding_time), 2);
+    cpptrace::experimental::reset_statistics();
+    EXPECT_EQ(cpptrace::experimental::get_statistics().captures, 0);
+}
+
+TEST(Statistics, Resolution) {
+    auto trace = cpptrace::generate_raw_trace();
+    cpptrace::experimental::reset_statistics();
+    trace.resolve();
+    auto statistics = cpptrace::experimental::get_statistics();
+    ASSERT_GE(statistics.backends.size(), 1);
+    EXPECT_FALSE(statistics.backends[0].name.empty());
+    EXPECT_EQ(statistics.backends[0].frames, trace.frames.size());
+    EXPECT_EQ(statistics.backends[0].resolution_time.count, 1);
+    EXPECT_EQ(bucket_total(statistics.backends[0].resolution_time), 1);
+}
+
+TEST(Statistics, SnippetCache) {
+    cpptrace::get_snippet(__FILE__, __LINE__, 1);
+    cpptrace::experimental::reset_statistics();
+    cpptrace::get_snippet(__FILE__, __LINE__, 1);
+    auto statistics = cpptrace::experimental::get_statistics();
+    EXPECT_EQ(statistics.snippet_cache.hits, 1);
+    EXPECT_EQ(statistics.snippet_cache.misses, 0);
+    // entries describe what's held rather than what happened since the reset
+    EXPECT_GE(statistics.snippet_cache.entries, 1);
+}
+
+}
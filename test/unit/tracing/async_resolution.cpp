@@ -0,0 +1,109 @@
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef TEST_MODULE
+import cpptrace;
+#else
+#include <cpptrace/cpptrace.hpp>
+#include <cpptrace/resolution.hpp>
+#endif
+
+using cpptrace::experimental::async_resolver_options;
+using cpptrace::experimental::full_queue_policy;
+
+namespace {
+
+class AsyncResolution : public testing::Test {
+protected:
+    void TearDown() override {
+        cpptrace::experimental::configure_async_resolver(async_resolver_options{});
+        cpptrace::experimental::set_exception_resolution_timeout(cpptrace::nullable<std::size_t>::null());
+    }
+};
+
+CPPTRACE_FORCE_NO_INLINE cpptrace::raw_trace trace_a() {
+    static volatile int lto_guard; lto_guard = lto_guard + 1;
+    return cpptrace::generate_raw_trace();
+}
+
+CPPTRACE_FORCE_NO_INLINE cpptrace::raw_trace trace_b() {
+    static volatile int lto_guard; lto_guard = lto_guard + 1;
+    return cpptrace::generate_raw_trace();
+}
+
+TEST_F(AsyncResolution, MatchesSynchronousResolution) {
+    auto raw = trace_a();
+    auto trace = cpptrace::experimental::resolve_async(raw).get();
+    EXPECT_EQ(trace.frames, raw.resolve().frames);
+}
+
+TEST_F(AsyncResolution, ObjectTrace) {
+    auto object = trace_a().resolve_object_trace();
+    auto trace = cpptrace::experimental::resolve_async(object).get();
+    EXPECT_EQ(trace.frames, object.resolve().frames);
+}
+
+TEST_F(AsyncResolution, Batches) {
+    // traces queued together share most of their frames
+    async_resolver_options options;
+    options.max_batch = 16;
+    cpptrace::experimental::configure_async_resolver(options);
+    std::vector<cpptrace::raw_trace> traces;
+    for(int i = 0; i < 8; i++) {
+        traces.push_back(i % 2 ? trace_a() : trace_b());
+    }
+    traces.push_back(cpptrace::raw_trace{});
+    std::vector<std::future<cpptrace::stacktrace>> futures;
+    for(const auto& trace : traces) {
+        futures.push_back(cpptrace::experimental::resolve_async(trace));
+    }
+    for(std::size_t i = 0; i < traces.size(); i++) {
+        EXPECT_EQ(futures[i].get().frames, traces[i].resolve().frames);
+    }
+}
+
+TEST_F(AsyncResolution, FullQueueFallsBackToAddresses) {
+    async_resolver_options options;
+    options.max_queued = 1;
+    options.when_full = full_queue_policy::address_only;
+    cpptrace::experimental::configure_async_resolver(options);
+    auto raw = trace_a();
+    auto address_only = raw.resolve(cpptrace::resolution_level::address_only);
+    auto full = raw.resolve();
+    std::vector<std::future<cpptrace::stacktrace>> futures;
+    for(int i = 0; i < 32; i++) {
+        futures.push_back(cpptrace::experimental::resolve_async(raw));
+    }
+    for(auto& future : futures) {
+        auto trace = future.get();
+        EXPECT_TRUE(trace.frames == full.frames || trace.frames == address_only.frames);
+    }
+}
+
+TEST_F(AsyncResolution, ExceptionTimeout) {
+    cpptrace::experimental::set_exception_resolution_timeout(10000);
+    auto raw = trace_a();
+    auto copy = raw;
+    cpptrace::runtime_error error("foobar", std::move(copy));
+    EXPECT_EQ(error.trace().frames, raw.resolve().frames);
+}
+
+TEST_F(AsyncResolution, ExceptionTimeoutExpired) {
+    cpptrace::experimental::set_exception_resolution_timeout(0);
+    auto raw = trace_a();
+    auto copy = raw;
+    cpptrace::runtime_error error("foobar", std::move(copy));
+    const auto& frames = error.trace().frames;
+    EXPECT_TRUE(
+        frames == raw.resolve().frames || frames == raw.resolve(cpptrace::resolution_level::address_only).frames
+    );
+}
+
+}
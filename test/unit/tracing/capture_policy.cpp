@@ -0,0 +1,161 @@
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef TEST_MODULE
+import cpptrace;
+#else
+#include <cpptrace/cpptrace.hpp>
+#include <cpptrace/from_current.hpp>
+#include <cpptrace/utils.hpp>
+#endif
+
+using cpptrace::experimental::capture_policy;
+
+namespace {
+
+// restores the default policy even if a test fails
+class CapturePolicy : public testing::Test {
+protected:
+    void TearDown() override {
+        cpptrace::experimental::set_capture_policy(capture_policy::always());
+    }
+};
+
+// returns whether the exception's trace was captured
+CPPTRACE_FORCE_NO_INLINE bool throw_site_a() {
+    try {
+        throw cpptrace::runtime_error("foobar");
+    } catch(const cpptrace::runtime_error& e) {
+        EXPECT_EQ(e.trace_was_sampled_out(), e.trace().empty());
+        return !e.trace_was_sampled_out();
+    }
+}
+
+CPPTRACE_FORCE_NO_INLINE bool throw_site_b() {
+    try {
+        throw cpptrace::runtime_error("foobar");
+    } catch(const cpptrace::runtime_error& e) {
+        return !e.trace_was_sampled_out();
+    }
+}
+
+CPPTRACE_FORCE_NO_INLINE void throw_plain_a() {
+    static volatile int lto_guard; lto_guard = lto_guard + 1;
+    throw std::runtime_error("foobar");
+}
+
+CPPTRACE_FORCE_NO_INLINE void throw_plain_b() {
+    static volatile int lto_guard; lto_guard = lto_guard + 1;
+    throw std::runtime_error("foobar");
+}
+
+// returns whether CPPTRACE_TRY captured a trace for the exception
+bool captured_by_try(void (*thrower)()) {
+    CPPTRACE_TRY {
+        thrower();
+    } CPPTRACE_CATCH(const std::exception&) {
+        return !cpptrace::current_exception_was_sampled_out();
+    }
+    return false;
+}
+
+TEST_F(CapturePolicy, Always) {
+    for(int i = 0; i < 4; i++) {
+        EXPECT_TRUE(throw_site_a());
+    }
+}
+
+TEST_F(CapturePolicy, OneInN) {
+    cpptrace::experimental::set_capture_policy(capture_policy::one_in(3));
+    int captured = 0;
+    for(int i = 0; i < 9; i++) {
+        captured += throw_site_a();
+    }
+    EXPECT_EQ(captured, 3);
+}
+
+TEST_F(CapturePolicy, RateLimited) {
+    // slow enough that no tokens are refilled during the test
+    cpptrace::experimental::set_capture_policy(capture_policy::rate_limited(0.001, 2));
+    int captured = 0;
+    for(int i = 0; i < 10; i++) {
+        captured += throw_site_a();
+    }
+    EXPECT_EQ(captured, 2);
+}
+
+TEST_F(CapturePolicy, PerThrowSite) {
+    cpptrace::experimental::set_capture_policy(capture_policy::per_throw_site(2, std::chrono::hours(1)));
+    int captured_a = 0;
+    int captured_b = 0;
+    for(int i = 0; i < 5; i++) {
+        captured_a += throw_site_a();
+        captured_b += throw_site_b();
+    }
+    EXPECT_EQ(captured_a, 2);
+    EXPECT_EQ(captured_b, 2);
+}
+
+TEST_F(CapturePolicy, SampledOutWhat) {
+    cpptrace::experimental::set_capture_policy(capture_policy::one_in(0));
+    cpptrace::runtime_error error("foobar");
+    EXPECT_TRUE(error.trace_was_sampled_out());
+    EXPECT_TRUE(error.trace().empty());
+    EXPECT_EQ(std::string(error.what()), "foobar:\n<trace sampled out>");
+    // copies keep the flag
+    cpptrace::runtime_error copy = error;
+    EXPECT_TRUE(copy.trace_was_sampled_out());
+}
+
+TEST_F(CapturePolicy, ExplicitTraceIsNotSampledOut) {
+    cpptrace::experimental::set_capture_policy(capture_policy::one_in(0));
+    cpptrace::runtime_error error("foobar", cpptrace::raw_trace{});
+    EXPECT_FALSE(error.trace_was_sampled_out());
+}
+
+TEST_F(CapturePolicy, FromCurrent) {
+    cpptrace::experimental::set_capture_policy(capture_policy::one_in(2));
+    int captured = 0;
+    for(int i = 0; i < 4; i++) {
+        CPPTRACE_TRY {
+            throw std::runtime_error("foobar");
+        } CPPTRACE_CATCH(const std::exception&) {
+            bool sampled_out = cpptrace::current_exception_was_sampled_out();
+            EXPECT_EQ(sampled_out, cpptrace::raw_trace_from_current_exception().empty());
+            captured += !sampled_out;
+        }
+    }
+    EXPECT_EQ(captured, 2);
+}
+
+TEST_F(CapturePolicy, FromCurrentPerThrowSite) {
+    // the trace is collected from inside the unwinder, the site has to be found past the exception machinery
+    cpptrace::experimental::set_capture_policy(capture_policy::per_throw_site(2, std::chrono::hours(1)));
+    int captured_a = 0;
+    int captured_b = 0;
+    for(int i = 0; i < 5; i++) {
+        captured_a += captured_by_try(throw_plain_a);
+        captured_b += captured_by_try(throw_plain_b);
+    }
+    EXPECT_EQ(captured_a, 2);
+    EXPECT_EQ(captured_b, 2);
+}
+
+TEST_F(CapturePolicy, ThrowSiteLookupsAreNotCounted) {
+    cpptrace::experimental::set_capture_policy(capture_policy::per_throw_site(1, std::chrono::hours(1)));
+    cpptrace::experimental::reset_statistics();
+    int captured = 0;
+    for(int i = 0; i < 4; i++) {
+        captured += captured_by_try(throw_plain_a);
+    }
+    EXPECT_EQ(captured, 1);
+    EXPECT_EQ(cpptrace::experimental::get_statistics().captures, 1);
+}
+
+}
@@ -0,0 +1,152 @@
+// Only built when the library uses libdwarf on linux, the test object is built alongside the unit tests
+#ifdef CPPTRACE_TEST_JIT_OBJECT
+
+#include <elf.h>
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef TEST_MODULE
+import cpptrace;
+#else
+#include <cpptrace/cpptrace.hpp>
+#include <cpptrace/utils.hpp>
+#endif
+
+namespace {
+
+// unregisters anything a test left behind
+class JitObjects : public testing::Test {
+protected:
+    void TearDown() override {
+        cpptrace::clear_all_jit_objects();
+    }
+};
+
+std::vector<char> read_jit_object() {
+    std::ifstream file(CPPTRACE_TEST_JIT_OBJECT, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// the object isn't relocated, its code is registered at the .text section's addresses
+std::pair<cpptrace::frame_ptr, cpptrace::frame_ptr> text_range(const std::vector<char>& object) {
+    Elf64_Ehdr header;
+    std::memcpy(&header, object.data(), sizeof(header));
+    Elf64_Shdr names;
+    std::memcpy(&names, object.data() + header.e_shoff + header.e_shstrndx * header.e_shentsize, sizeof(names));
+    for(std::size_t i = 0; i < header.e_shnum; i++) {
+        Elf64_Shdr section;
+        std::memcpy(&section, object.data() + header.e_shoff + i * header.e_shentsize, sizeof(section));
+        if(std::strcmp(object.data() + names.sh_offset + section.sh_name, ".text") == 0) {
+            return {section.sh_addr, section.sh_addr + section.sh_size};
+        }
+    }
+    return {0, 0};
+}
+
+// one frame for every address in the object's code
+cpptrace::object_trace jit_frames(const std::vector<char>& object) {
+    auto range = text_range(object);
+    cpptrace::object_trace trace;
+    for(auto pc = range.first; pc < range.second; pc++) {
+        trace.frames.push_back(cpptrace::object_frame{pc, 0, ""});
+    }
+    return trace;
+}
+
+bool has_symbol(const cpptrace::stacktrace& trace, const std::string& symbol) {
+    for(const auto& frame : trace.frames) {
+        if(frame.symbol == symbol) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_F(JitObjects, ResolvesLinesAndInlines) {
+    auto object = read_jit_object();
+    ASSERT_GT(object.size(), EI_CLASS);
+    if(object[EI_CLASS] != ELFCLASS64) {
+        GTEST_SKIP();
+    }
+    auto frames = jit_frames(object);
+    ASSERT_FALSE(frames.empty());
+    cpptrace::register_jit_object(object.data(), object.size());
+    auto trace = frames.resolve();
+    bool found_inner = false;
+    bool found_outer = false;
+    for(const auto& frame : trace.frames) {
+        if(frame.symbol == "jit_inner") {
+            found_inner = true;
+            EXPECT_TRUE(frame.is_inline);
+            EXPECT_THAT(frame.filename, testing::EndsWith("jit_object.cpp"));
+            EXPECT_EQ(frame.line.value(), 8);
+        } else if(frame.symbol == "jit_outer" && frame.line.value() == 12) {
+            // the frame jit_inner was inlined into, at the call
+            found_outer = true;
+            EXPECT_FALSE(frame.is_inline);
+            EXPECT_THAT(frame.filename, testing::EndsWith("jit_object.cpp"));
+        }
+    }
+    EXPECT_TRUE(found_inner);
+    EXPECT_TRUE(found_outer);
+}
+
+TEST_F(JitObjects, Unregister) {
+    auto object = read_jit_object();
+    ASSERT_GT(object.size(), EI_CLASS);
+    if(object[EI_CLASS] != ELFCLASS64) {
+        GTEST_SKIP();
+    }
+    auto frames = jit_frames(object);
+    ASSERT_FALSE(frames.empty());
+    cpptrace::register_jit_object(object.data(), object.size());
+    EXPECT_TRUE(has_symbol(frames.resolve(), "jit_outer"));
+    // tears down the object's resolver
+    cpptrace::unregister_jit_object(object.data());
+    EXPECT_FALSE(has_symbol(frames.resolve(), "jit_outer"));
+    // and a new one is made when it's registered again
+    cpptrace::register_jit_object(object.data(), object.size());
+    EXPECT_TRUE(has_symbol(frames.resolve(), "jit_outer"));
+}
+
+TEST_F(JitObjects, UnregisterDuringResolution) {
+    // A resolution in progress can hold the last reference to an unregistered object's resolver, which is then
+    // destroyed under the resolution lock that's already held
+    auto object = read_jit_object();
+    ASSERT_GT(object.size(), EI_CLASS);
+    if(object[EI_CLASS] != ELFCLASS64) {
+        GTEST_SKIP();
+    }
+    auto frames = jit_frames(object);
+    ASSERT_FALSE(frames.empty());
+    std::atomic<bool> done{false};
+    std::thread resolver([&] {
+        while(!done) {
+            frames.resolve();
+        }
+    });
+    for(int i = 0; i < 200; i++) {
+        cpptrace::register_jit_object(object.data(), object.size());
+        cpptrace::unregister_jit_object(object.data());
+    }
+    done = true;
+    resolver.join();
+    cpptrace::register_jit_object(object.data(), object.size());
+    EXPECT_TRUE(has_symbol(frames.resolve(), "jit_outer"));
+}
+
+}
+
+#endif
@@ -53,6 +53,43 @@ TEST(ObjectTrace, BasicResolution) {
 }
 
 
+
+CPPTRACE_FORCE_NO_INLINE void object_resolution_levels() {
+    static volatile int lto_guard; lto_guard = lto_guard + 1;
+    auto line = __LINE__ + 1;
+    auto otrace = cpptrace::generate_object_trace();
+    ASSERT_GE(otrace.frames.size(), 1);
+
+    auto address_only = otrace.resolve(cpptrace::resolution_level::address_only);
+    ASSERT_EQ(address_only.frames.size(), otrace.frames.size());
+    EXPECT_EQ(address_only.frames[0].raw_address, otrace.frames[0].raw_address);
+    EXPECT_EQ(address_only.frames[0].object_address, otrace.frames[0].object_address);
+    EXPECT_EQ(address_only.frames[0].filename, otrace.frames[0].object_path);
+    EXPECT_TRUE(address_only.frames[0].symbol.empty());
+    EXPECT_FALSE(address_only.frames[0].line.has_value());
+
+    auto symbol_only = otrace.resolve(cpptrace::resolution_level::symbol_only);
+    ASSERT_EQ(symbol_only.frames.size(), otrace.frames.size());
+    EXPECT_EQ(symbol_only.frames[0].filename, otrace.frames[0].object_path);
+    EXPECT_THAT(symbol_only.frames[0].symbol, testing::HasSubstr("object_resolution_levels"));
+    EXPECT_FALSE(symbol_only.frames[0].line.has_value());
+    EXPECT_FALSE(symbol_only.frames[0].column.has_value());
+
+    auto symbol_and_line = otrace.resolve(cpptrace::resolution_level::symbol_and_line);
+    ASSERT_GE(symbol_and_line.frames.size(), 1);
+    for(const auto& frame : symbol_and_line) {
+        EXPECT_FALSE(frame.is_inline);
+    }
+    EXPECT_FILE(symbol_and_line.frames[0].filename, "object_trace.cpp");
+    EXPECT_LINE(symbol_and_line.frames[0].line.value(), line);
+    EXPECT_THAT(symbol_and_line.frames[0].symbol, testing::HasSubstr("object_resolution_levels"));
+}
+
+TEST(ObjectTrace, ResolutionLevels) {
+    object_resolution_levels();
+}
+
+
 // TODO: dbghelp uses raw address, not object
 #ifndef _MSC_VER
 CPPTRACE_FORCE_NO_INLINE int object_resolve_3(std::vector<int>& line_numbers) {
@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef TEST_MODULE
+import cpptrace;
+#else
+#include <cpptrace/cpptrace.hpp>
+#include <cpptrace/resolution.hpp>
+#endif
+
+using cpptrace::experimental::cancellation_token;
+using cpptrace::experimental::resolve_progressively;
+
+namespace {
+
+CPPTRACE_FORCE_NO_INLINE cpptrace::raw_trace progressive_trace() {
+    static volatile int lto_guard; lto_guard = lto_guard + 1;
+    return cpptrace::generate_raw_trace();
+}
+
+std::chrono::steady_clock::time_point no_deadline() {
+    return std::chrono::steady_clock::time_point::max();
+}
+
+TEST(ProgressiveResolution, MatchesFullResolution) {
+    auto raw = progressive_trace();
+    std::vector<cpptrace::stacktrace_frame> delivered;
+    auto trace = resolve_progressively(
+        raw,
+        no_deadline(),
+        [&] (std::size_t index, const cpptrace::stacktrace_frame& frame) {
+            EXPECT_EQ(index, delivered.size());
+            delivered.push_back(frame);
+        }
+    );
+    EXPECT_EQ(trace.frames, raw.resolve().frames);
+    EXPECT_EQ(delivered, trace.frames);
+}
+
+TEST(ProgressiveResolution, ResolvesInChunks) {
+    // back-ends are called a logarithmic number of times per object rather than once per frame
+    auto raw = progressive_trace();
+    ASSERT_GE(raw.frames.size(), 4U);
+    cpptrace::experimental::reset_statistics();
+    resolve_progressively(raw, no_deadline());
+    auto statistics = cpptrace::experimental::get_statistics();
+    ASSERT_GE(statistics.backends.size(), 1U);
+    std::uint64_t calls = 0;
+    for(const auto& backend : statistics.backends) {
+        calls += backend.resolution_time.count;
+    }
+    EXPECT_GE(calls, 1U);
+    EXPECT_LT(calls, raw.frames.size());
+}
+
+TEST(ProgressiveResolution, ObjectTrace) {
+    auto object = progressive_trace().resolve_object_trace();
+    auto trace = resolve_progressively(object, no_deadline());
+    EXPECT_EQ(trace.frames, object.resolve().frames);
+}
+
+TEST(ProgressiveResolution, ExpiredDeadline) {
+    auto raw = progressive_trace();
+    std::size_t delivered = 0;
+    auto trace = resolve_progressively(
+        raw,
+        std::chrono::steady_clock::now(),
+        [&] (std::size_t, const cpptrace::stacktrace_frame&) {
+            delivered++;
+        }
+    );
+    EXPECT_EQ(trace.frames, raw.resolve(cpptrace::resolution_level::address_only).frames);
+    EXPECT_EQ(delivered, trace.frames.size());
+}
+
+TEST(ProgressiveResolution, Cancellation) {
+    auto raw = progressive_trace();
+    auto full = raw.resolve();
+    auto address_only = raw.resolve(cpptrace::resolution_level::address_only);
+    ASSERT_GE(address_only.frames.size(), 2U);
+    // cancel once the first frame is in, the top of the stack is resolved and the rest only has object information
+    cancellation_token token;
+    auto trace = resolve_progressively(
+        raw,
+        no_deadline(),
+        [&] (std::size_t, const cpptrace::stacktrace_frame&) {
+            token.cancel();
+        },
+        token
+    );
+    ASSERT_FALSE(trace.frames.empty());
+    EXPECT_EQ(trace.frames.front(), full.frames.front());
+    EXPECT_EQ(trace.frames.back(), address_only.frames.back());
+    EXPECT_TRUE(token.is_cancelled());
+}
+
+}
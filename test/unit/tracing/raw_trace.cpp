@@ -12,6 +12,7 @@
 import cpptrace;
 #else
 #include <cpptrace/cpptrace.hpp>
+#include <cpptrace/formatting.hpp>
 #endif
 
 
@@ -173,6 +174,31 @@ CPPTRACE_FORCE_NO_INLINE void raw_trace_multi_precise_1() {
 }
 #endif
 
+CPPTRACE_FORCE_NO_INLINE static void raw_trace_symbol_only() {
+    static volatile int lto_guard; lto_guard = lto_guard + 1;
+    auto raw_trace = cpptrace::generate_raw_trace();
+    ASSERT_GE(raw_trace.frames.size(), 1);
+    auto trace = raw_trace.resolve(cpptrace::resolution_level::symbol_only);
+    ASSERT_EQ(trace.frames.size(), raw_trace.frames.size());
+    EXPECT_EQ(trace.frames[0].raw_address, raw_trace.frames[0]);
+    EXPECT_THAT(trace.frames[0].symbol, testing::HasSubstr("raw_trace_symbol_only"));
+    EXPECT_FALSE(trace.frames[0].line.has_value());
+    auto formatter = cpptrace::formatter{}
+        .header("")
+        .addresses(cpptrace::formatter::address_mode::none)
+        .resolution(cpptrace::resolution_level::symbol_only);
+    EXPECT_EQ(formatter.format(raw_trace), formatter.format(trace));
+    EXPECT_THAT(formatter.format(raw_trace), testing::HasSubstr("raw_trace_symbol_only"));
+    EXPECT_THAT(
+        formatter.resolution(cpptrace::resolution_level::address_only).format(raw_trace),
+        testing::Not(testing::HasSubstr("raw_trace_symbol_only"))
+    );
+}
+
+TEST(RawTrace, SymbolOnlyResolution) {
+    raw_trace_symbol_only();
+}
+
 TEST(RawTrace, MultipleCalls) {
     parents.clear();
     raw_trace_multi_1();
@@ -0,0 +1,88 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gtest/gtest-matchers.h>
+#include <gmock/gmock.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef TEST_MODULE
+import cpptrace;
+#else
+#include <cpptrace/cpptrace.hpp>
+#include <cpptrace/resolution.hpp>
+#endif
+
+namespace {
+
+CPPTRACE_FORCE_NO_INLINE cpptrace::raw_trace many_trace_a() {
+    static volatile int lto_guard; lto_guard = lto_guard + 1;
+    return cpptrace::generate_raw_trace();
+}
+
+CPPTRACE_FORCE_NO_INLINE cpptrace::raw_trace many_trace_b() {
+    static volatile int lto_guard; lto_guard = lto_guard + 1;
+    return cpptrace::generate_raw_trace();
+}
+
+std::vector<cpptrace::raw_trace> make_traces() {
+    std::vector<cpptrace::raw_trace> traces;
+    for(int i = 0; i < 6; i++) {
+        traces.push_back(i % 3 ? many_trace_a() : many_trace_b());
+    }
+    traces.push_back(cpptrace::raw_trace{});
+    return traces;
+}
+
+TEST(ResolveMany, RawTraces) {
+    auto traces = make_traces();
+    auto resolved = cpptrace::experimental::resolve_many(traces);
+    ASSERT_EQ(resolved.size(), traces.size());
+    for(std::size_t i = 0; i < traces.size(); i++) {
+        EXPECT_EQ(resolved[i].frames, traces[i].resolve().frames);
+    }
+    EXPECT_TRUE(resolved.back().empty());
+}
+
+TEST(ResolveMany, ObjectTraces) {
+    std::vector<cpptrace::object_trace> traces;
+    for(const auto& trace : make_traces()) {
+        traces.push_back(trace.resolve_object_trace());
+    }
+    auto resolved = cpptrace::experimental::resolve_many(traces);
+    ASSERT_EQ(resolved.size(), traces.size());
+    for(std::size_t i = 0; i < traces.size(); i++) {
+        EXPECT_EQ(resolved[i].frames, traces[i].resolve().frames);
+    }
+}
+
+TEST(ResolveMany, FramesWithoutObjectAreNotMerged) {
+    // JIT and unknown frames have no object path or object address, only their raw addresses tell them apart
+    std::vector<cpptrace::object_trace> traces{
+        cpptrace::object_trace{{{0x1000, 0, ""}, {0x2000, 0, ""}}},
+        cpptrace::object_trace{{{0x2000, 0, ""}}}
+    };
+    cpptrace::experimental::reset_statistics();
+    auto resolved = cpptrace::experimental::resolve_many(traces);
+    auto statistics = cpptrace::experimental::get_statistics();
+    ASSERT_GE(statistics.backends.size(), 1);
+    EXPECT_EQ(statistics.backends[0].frames, 2);
+    ASSERT_EQ(resolved.size(), traces.size());
+    for(std::size_t i = 0; i < traces.size(); i++) {
+        EXPECT_EQ(resolved[i].frames, traces[i].resolve().frames);
+    }
+}
+
+TEST(ResolveMany, ResolutionLevel) {
+    auto traces = make_traces();
+    auto resolved = cpptrace::experimental::resolve_many(traces, cpptrace::resolution_level::address_only);
+    ASSERT_EQ(resolved.size(), traces.size());
+    for(std::size_t i = 0; i < traces.size(); i++) {
+        EXPECT_EQ(resolved[i].frames, traces[i].resolve(cpptrace::resolution_level::address_only).frames);
+    }
+}
+
+TEST(ResolveMany, Empty) {
+    EXPECT_TRUE(cpptrace::experimental::resolve_many(std::vector<cpptrace::raw_trace>{}).empty());
+}
+
+}
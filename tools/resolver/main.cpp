@@ -9,11 +9,18 @@
 #include <fmt/chrono.h>
 #include <cpptrace/cpptrace.hpp>
 #include <cpptrace/from_current.hpp>
+#include <cpptrace/serialization.hpp>
 
 #include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "symbols/symbols.hpp"
 #include "demangle/demangle.hpp"
@@ -34,6 +41,9 @@ struct options {
     bool timing = false;
     bool disable_aranges = false;
     cpptrace::nullable<std::size_t> line_table_cache_size;
+    std::string symbolize_input;
+    std::string output_path;
+    bool binary_output = false;
 };
 
 void resolve(const options& opts, cpptrace::frame_ptr address) {
@@ -53,6 +63,205 @@ void resolve(const options& opts, cpptrace::frame_ptr address) {
     }
 }
 
+struct symbolization_stats {
+    std::size_t input_bytes = 0;
+    std::size_t output_bytes = 0;
+    std::size_t object_traces = 0;
+    std::size_t resolved_traces = 0;
+    std::size_t skipped_traces = 0;
+    std::size_t frames = 0;
+    std::size_t unique_frames = 0;
+};
+
+// Collects the traces from a serialized stream and resolves every unique (object, object address) pair once. Object
+// traces are held as indices into the table of unique frames until resolve() is called.
+class bulk_symbolizer {
+    struct pending_trace {
+        std::size_t slot;
+        // raw address and index of the unique frame
+        std::vector<std::pair<cpptrace::frame_ptr, std::size_t>> frames;
+    };
+    // output, in input order
+    std::vector<cpptrace::stacktrace> traces;
+    std::vector<pending_trace> pending;
+    std::vector<cpptrace::object_frame> unique_frames;
+    std::unordered_map<std::string, std::unordered_map<cpptrace::frame_ptr, std::size_t>> frame_indices;
+
+public:
+    symbolization_stats stats;
+
+    void add(cpptrace::experimental::decoded_trace& trace) {
+        using trace_type = cpptrace::experimental::decoded_trace::trace_type;
+        switch(trace.type) {
+            case trace_type::object:
+                {
+                    pending_trace entry{traces.size(), {}};
+                    entry.frames.reserve(trace.object.frames.size());
+                    for(const auto& frame : trace.object.frames) {
+                        auto& indices = frame_indices[frame.object_path];
+                        auto [it, inserted] = indices.try_emplace(frame.object_address, unique_frames.size());
+                        if(inserted) {
+                            unique_frames.push_back(frame);
+                        }
+                        entry.frames.emplace_back(frame.raw_address, it->second);
+                    }
+                    stats.frames += entry.frames.size();
+                    stats.object_traces++;
+                    traces.emplace_back();
+                    pending.push_back(std::move(entry));
+                }
+                break;
+            case trace_type::resolved:
+                stats.resolved_traces++;
+                traces.push_back(std::move(trace.resolved));
+                break;
+            case trace_type::raw:
+                // raw addresses are only meaningful in the process they came from
+                if(stats.skipped_traces++ == 0) {
+                    fmt::println(stderr, "Warning: Skipping raw traces in the input, they can't be resolved offline");
+                }
+                break;
+        }
+    }
+
+    void resolve() {
+        stats.unique_frames = unique_frames.size();
+        auto resolved = cpptrace::detail::resolve_frames(unique_frames);
+        // each unique frame resolves to its inlined frames, if any, followed by one non-inlined frame
+        std::vector<std::size_t> starts{0};
+        for(std::size_t i = 0; i < resolved.size(); i++) {
+            if(!resolved[i].is_inline) {
+                starts.push_back(i + 1);
+            }
+        }
+        if(starts.size() != unique_frames.size() + 1 || starts.back() != resolved.size()) {
+            throw std::runtime_error("Something went wrong, resolved frames didn't line up with the input frames");
+        }
+        for(auto& frame : resolved) {
+            frame.symbol = cpptrace::demangle(frame.symbol);
+        }
+        for(const auto& entry : pending) {
+            auto& frames = traces[entry.slot].frames;
+            frames.reserve(entry.frames.size());
+            for(const auto& [raw_address, index] : entry.frames) {
+                for(auto i = starts[index]; i < starts[index + 1]; i++) {
+                    frames.push_back(resolved[i]);
+                    frames.back().raw_address = raw_address;
+                    frames.back().object_address = unique_frames[index].object_address;
+                }
+            }
+        }
+        pending.clear();
+    }
+
+    const std::vector<cpptrace::stacktrace>& get_traces() const {
+        return traces;
+    }
+};
+
+template<typename Duration>
+double per_second(std::size_t count, Duration duration) {
+    auto seconds = std::chrono::duration<double>(duration).count();
+    return seconds > 0 ? count / seconds : 0;
+}
+
+int symbolize(const options& opts) {
+    std::ifstream input_file;
+    std::istream* input = &std::cin;
+    if(opts.symbolize_input != "-") {
+        input_file.open(opts.symbolize_input, std::ios::binary);
+        if(!input_file) {
+            fmt::println(stderr, "Error: Couldn't open {}", opts.symbolize_input);
+            return 1;
+        }
+        input = &input_file;
+    }
+    std::ofstream output_file;
+    std::ostream* output = &std::cout;
+    if(!opts.output_path.empty()) {
+        output_file.open(opts.output_path, std::ios::binary);
+        if(!output_file) {
+            fmt::println(stderr, "Error: Couldn't open {}", opts.output_path);
+            return 1;
+        }
+        output = &output_file;
+    }
+
+    bulk_symbolizer symbolizer;
+    auto& stats = symbolizer.stats;
+    auto start = std::chrono::steady_clock::now();
+    cpptrace::experimental::trace_decoder decoder;
+    cpptrace::experimental::decoded_trace trace;
+    std::vector<char> buffer(64 * 1024);
+    while(input->read(buffer.data(), buffer.size()) || input->gcount() > 0) {
+        auto count = static_cast<std::size_t>(input->gcount());
+        stats.input_bytes += count;
+        decoder.feed(buffer.data(), count);
+        cpptrace::experimental::decode_status status;
+        while((status = decoder.next(trace)) == cpptrace::experimental::decode_status::ok) {
+            symbolizer.add(trace);
+        }
+        if(status == cpptrace::experimental::decode_status::error) {
+            fmt::println(stderr, "Error: Malformed trace stream");
+            return 1;
+        }
+    }
+    auto decoded = std::chrono::steady_clock::now();
+    symbolizer.resolve();
+    auto resolved = std::chrono::steady_clock::now();
+    if(opts.binary_output) {
+        cpptrace::experimental::trace_encoder encoder;
+        for(const auto& resolved_trace : symbolizer.get_traces()) {
+            encoder.encode(resolved_trace);
+        }
+        auto data = encoder.take();
+        output->write(data.data(), data.size());
+        stats.output_bytes += data.size();
+    } else {
+        std::string text;
+        for(const auto& resolved_trace : symbolizer.get_traces()) {
+            text.clear();
+            formatter.format_to(std::back_inserter(text), resolved_trace);
+            text += '\n';
+            output->write(text.data(), text.size());
+            stats.output_bytes += text.size();
+        }
+    }
+    output->flush();
+    auto written = std::chrono::steady_clock::now();
+
+    auto to_ms = [](auto duration) { return std::chrono::duration_cast<std::chrono::milliseconds>(duration); };
+    fmt::println(
+        stderr,
+        "traces: {} object, {} resolved, {} skipped",
+        stats.object_traces,
+        stats.resolved_traces,
+        stats.skipped_traces
+    );
+    fmt::println(
+        stderr,
+        "frames: {} total, {} unique ({:.1f}% deduplicated)",
+        stats.frames,
+        stats.unique_frames,
+        stats.frames ? 100.0 * (stats.frames - stats.unique_frames) / stats.frames : 0.0
+    );
+    fmt::println(stderr, "bytes: {} in, {} out", stats.input_bytes, stats.output_bytes);
+    fmt::println(
+        stderr,
+        "time: {} decode, {} resolve, {} output",
+        to_ms(decoded - start),
+        to_ms(resolved - decoded),
+        to_ms(written - resolved)
+    );
+    fmt::println(
+        stderr,
+        "throughput: {:.0f} frames/s, {:.0f} unique frames/s resolved",
+        per_second(stats.frames, written - start),
+        per_second(stats.unique_frames, resolved - decoded)
+    );
+    return 0;
+}
+
 int resolver(int argc, char** argv) {
     options opts;
     auto cli = lyra::cli()
@@ -62,7 +271,10 @@ int resolver(int argc, char** argv) {
         | lyra::opt(opts.timing)["--timing"]("provide timing stats")
         | lyra::opt(opts.disable_aranges)["--disable-aranges"]("don't use the .debug_aranges accelerated address lookup table")
         | lyra::opt(opts.line_table_cache_size.raw_value, "line table cache size")["--line-table-cache-size"]("limit the size of cpptrace's line table cache")
-        | lyra::arg(opts.path, "binary path")("binary to look in").required()
+        | lyra::opt(opts.symbolize_input, "trace stream")["--symbolize"]("resolve a stream of serialized traces, - for stdin")
+        | lyra::opt(opts.output_path, "output path")["-o"]["--output"]("where to write symbolized traces, defaults to stdout")
+        | lyra::opt(opts.binary_output)["--binary-output"]("write symbolized traces as a serialized stream instead of text")
+        | lyra::arg(opts.path, "binary path")("binary to look in")
         | lyra::arg(opts.address_strings, "addresses")("addresses");
     if(auto result = cli.parse({ argc, argv }); !result) {
         fmt::println(stderr, "Error in command line: {}", result.message());
@@ -73,6 +285,20 @@ int resolver(int argc, char** argv) {
         fmt::println("{}", cli);
         return 0;
     }
+    if(opts.disable_aranges) {
+        cpptrace::experimental::set_dwarf_resolver_disable_aranges(true);
+    }
+    if(opts.line_table_cache_size.has_value()) {
+        cpptrace::experimental::set_dwarf_resolver_line_table_cache_size(opts.line_table_cache_size);
+    }
+    if(!opts.symbolize_input.empty()) {
+        return symbolize(opts);
+    }
+    if(opts.path.empty()) {
+        fmt::println(stderr, "Error: A binary path is required");
+        fmt::println("{}", cli);
+        return 1;
+    }
     if(!std::filesystem::exists(opts.path)) {
         fmt::println(stderr, "Error: Path doesn't exist {}", opts.path);
         return 1;
@@ -81,12 +307,6 @@ int resolver(int argc, char** argv) {
         fmt::println(stderr, "Error: Path isn't a regular file {}", opts.path);
         return 1;
     }
-    if(opts.disable_aranges) {
-        cpptrace::experimental::set_dwarf_resolver_disable_aranges(true);
-    }
-    if(opts.line_table_cache_size.has_value()) {
-        cpptrace::experimental::set_dwarf_resolver_line_table_cache_size(opts.line_table_cache_size);
-    }
     for(const auto& address : opts.address_strings) {
         resolve(opts, std::stoi(address, nullptr, 16));
     }
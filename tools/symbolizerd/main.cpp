@@ -0,0 +1,210 @@
+#include <lyra/lyra.hpp>
+#include <fmt/format.h>
+#include <fmt/std.h>
+#include <fmt/ostream.h>
+#include <cpptrace/cpptrace.hpp>
+#include <cpptrace/from_current.hpp>
+#include <cpptrace/serialization.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "symbols/symbols.hpp"
+#include "utils/utils.hpp"
+
+using namespace std::literals;
+using namespace cpptrace::detail;
+
+template<> struct fmt::formatter<lyra::cli> : ostream_formatter {};
+
+// Serves symbolization requests from processes using cpptrace::experimental::use_remote_symbolizer. Resolvers and their
+// caches live for as long as the daemon does and are shared by every client.
+//
+// Protocol: a client connects, writes a serialized trace stream holding one object trace, and shuts down its side of
+// the connection. The daemon answers with a stream holding one resolved trace with symbols left mangled, and closes the
+// connection. Each object frame resolves to its inlined frames, if any, followed by one non-inlined frame.
+
+struct options {
+    bool show_help = false;
+    std::string socket_path;
+    bool verbose = false;
+    bool disable_aranges = false;
+    cpptrace::nullable<std::size_t> line_table_cache_size;
+    int timeout = 10;
+};
+
+std::atomic<std::size_t> request_count{0};
+std::atomic<std::size_t> frame_count{0};
+
+// for the signal handler
+char socket_path_buffer[sizeof(sockaddr_un::sun_path)];
+
+extern "C" void handle_termination(int) {
+    unlink(socket_path_buffer);
+    _exit(0);
+}
+
+bool send_all(int fd, const std::string& data) {
+    std::size_t sent = 0;
+    while(sent < data.size()) {
+        auto count = send(fd, data.data() + sent, data.size() - sent, 0);
+        if(count < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        sent += count;
+    }
+    return true;
+}
+
+void serve(int fd, const options& opts) {
+    auto closer = raii_wrap(fd, [] (int fd) { close(fd); });
+    auto start = std::chrono::steady_clock::now();
+    cpptrace::experimental::trace_decoder decoder;
+    std::vector<char> buffer(64 * 1024);
+    while(true) {
+        auto count = recv(fd, buffer.data(), buffer.size(), 0);
+        if(count < 0 && errno == EINTR) {
+            continue;
+        }
+        if(count < 0) {
+            fmt::println(stderr, "Error: Failed to read request: {}", std::strerror(errno));
+            return;
+        }
+        if(count == 0) {
+            break;
+        }
+        decoder.feed(buffer.data(), count);
+    }
+    cpptrace::experimental::decoded_trace request;
+    if(
+        decoder.next(request) != cpptrace::experimental::decode_status::ok
+        || request.type != cpptrace::experimental::decoded_trace::trace_type::object
+    ) {
+        fmt::println(stderr, "Error: Malformed request");
+        return;
+    }
+    auto trace = cpptrace::detail::resolve_frames(request.object.frames);
+    cpptrace::experimental::trace_encoder encoder;
+    encoder.encode(cpptrace::stacktrace{std::move(trace)});
+    if(!send_all(fd, encoder.data())) {
+        fmt::println(stderr, "Error: Failed to send response: {}", std::strerror(errno));
+        return;
+    }
+    auto requests = ++request_count;
+    auto total_frames = frame_count += request.object.frames.size();
+    if(opts.verbose) {
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        fmt::println(
+            stderr,
+            "request {}: {} frames in {}us ({} frames total)",
+            requests,
+            request.object.frames.size(),
+            duration.count(),
+            total_frames
+        );
+    }
+}
+
+int symbolizerd(int argc, char** argv) {
+    options opts;
+    auto cli = lyra::cli()
+        | lyra::help(opts.show_help)
+        | lyra::opt(opts.verbose)["--verbose"]("log every request")
+        | lyra::opt(opts.timeout, "seconds")["--timeout"]("how long to wait on a client before dropping it")
+        | lyra::opt(opts.disable_aranges)["--disable-aranges"]("don't use the .debug_aranges accelerated address lookup table")
+        | lyra::opt(opts.line_table_cache_size.raw_value, "line table cache size")["--line-table-cache-size"]("limit the size of cpptrace's line table cache")
+        | lyra::arg(opts.socket_path, "socket path")("unix domain socket to listen on").required();
+    if(auto result = cli.parse({ argc, argv }); !result) {
+        fmt::println(stderr, "Error in command line: {}", result.message());
+        fmt::println("{}", cli);
+        return 1;
+    }
+    if(opts.show_help) {
+        fmt::println("{}", cli);
+        return 0;
+    }
+    if(opts.socket_path.size() >= sizeof(socket_path_buffer)) {
+        fmt::println(stderr, "Error: Socket path is too long {}", opts.socket_path);
+        return 1;
+    }
+    if(opts.disable_aranges) {
+        cpptrace::experimental::set_dwarf_resolver_disable_aranges(true);
+    }
+    if(opts.line_table_cache_size.has_value()) {
+        cpptrace::experimental::set_dwarf_resolver_line_table_cache_size(opts.line_table_cache_size);
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener == -1) {
+        fmt::println(stderr, "Error: Failed to create socket: {}", std::strerror(errno));
+        return 1;
+    }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, opts.socket_path.c_str());
+    std::strcpy(socket_path_buffer, opts.socket_path.c_str());
+    // a stale socket from a previous run would make bind fail
+    unlink(opts.socket_path.c_str());
+    if(bind(listener, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == -1) {
+        fmt::println(stderr, "Error: Failed to bind {}: {}", opts.socket_path, std::strerror(errno));
+        return 1;
+    }
+    if(listen(listener, SOMAXCONN) == -1) {
+        fmt::println(stderr, "Error: Failed to listen on {}: {}", opts.socket_path, std::strerror(errno));
+        return 1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, handle_termination);
+    std::signal(SIGTERM, handle_termination);
+    fmt::println(stderr, "Listening on {}", opts.socket_path);
+
+    timeval timeout{opts.timeout, 0};
+    while(true) {
+        int client = accept(listener, nullptr, nullptr);
+        if(client == -1) {
+            if(errno != EINTR && errno != ECONNABORTED) {
+                fmt::println(stderr, "Error: Failed to accept connection: {}", std::strerror(errno));
+            }
+            continue;
+        }
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        // resolution itself is serialized by the library, a thread per client keeps a slow client from holding up
+        // everyone else
+        std::thread([client, &opts] {
+            CPPTRACE_TRY {
+                serve(client, opts);
+            } CPPTRACE_CATCH(const std::exception& e) {
+                fmt::println(stderr, "Caught exception {}: {}", cpptrace::demangle(typeid(e).name()), e.what());
+                cpptrace::from_current_exception().print();
+            }
+        }).detach();
+    }
+}
+
+int main(int argc, char** argv) {
+    int ret = 0;
+    CPPTRACE_TRY {
+        ret = symbolizerd(argc, argv);
+    } CPPTRACE_CATCH(const std::exception& e) {
+        fmt::println(stderr, "Caught exception {}: {}", cpptrace::demangle(typeid(e).name()), e.what());
+        cpptrace::from_current_exception().print();
+        ret = 1;
+    }
+    return ret;
+}